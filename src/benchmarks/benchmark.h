@@ -0,0 +1,79 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string_view>
+
+namespace o2::benchmarking
+{
+	/**
+	 * \brief state used by the benchmark driver
+	 */
+	struct benchmark_state
+	{
+		/**
+		 * \return the name of the suite we want to run. empty means all
+		 */
+		static std::string_view& suite_name()
+		{
+			static std::string_view s;
+			return s;
+		}
+
+		/**
+		 * \return a value that's written to by benchmarks so that the compiler can't remove the measured code
+		 */
+		static volatile unsigned long long& sink()
+		{
+			static volatile unsigned long long s = 0;
+			return s;
+		}
+	};
+
+	struct utils
+	{
+		static inline unsigned long long now_ns()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+	};
+
+	/**
+	 * \brief run the supplied function the supplied number of times and print the time it took
+	 * \param name the name of the benchmark
+	 * \param iterations how many times the function is run
+	 * \param b the function
+	 * \return the time, in nanoseconds, that one iteration took
+	 */
+	static inline double benchmark(std::string_view name, int iterations, const std::function<void()>& b)
+	{
+		// warm up caches and the allocator before measuring
+		b();
+
+		const auto now = utils::now_ns();
+		for (int i = 0; i < iterations; ++i)
+			b();
+		const auto duration = utils::now_ns() - now;
+		const auto per_iteration = (double)duration / iterations;
+		std::cout << "\tbenchmark '" << name << "' - " << per_iteration / 1000.0 << " us/iteration" << std::endl;
+		return per_iteration;
+	}
+
+	static inline void suite(std::string_view name, const std::function<void()>& s)
+	{
+		std::cout << "suite '" << name << '\'' << std::endl;
+		if (!benchmark_state::suite_name().empty() && benchmark_state::suite_name() != name)
+		{
+			std::cout << "\tignored" << std::endl;
+			return;
+		}
+		s();
+	}
+}
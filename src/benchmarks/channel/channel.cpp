@@ -0,0 +1,117 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "../benchmark.h"
+#include "../../cli/channel.h"
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <thread>
+#include <vector>
+#include <string>
+
+using namespace o2;
+using namespace o2::benchmarking;
+
+namespace
+{
+	/**
+	 * \brief the channel implementation used before the lock-free ring buffer was introduced
+	 */
+	template<typename T>
+	class legacy_channel
+	{
+	public:
+		legacy_channel()
+				: _closed(false)
+		{
+		}
+
+		bool wait_pop(T* val)
+		{
+			std::unique_lock l(_mutex);
+			_condition.wait(l, [this]
+			{
+				return !_queue.empty() || _closed;
+			});
+			if (_closed)
+				return false;
+			*val = std::move(_queue.front());
+			_queue.pop();
+			return true;
+		}
+
+		bool put(const T& t)
+		{
+			if (_closed)
+				return false;
+			std::lock_guard l(_mutex);
+			_queue.push(t);
+			_condition.notify_one();
+			return true;
+		}
+
+	private:
+		bool _closed;
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::queue<T> _queue;
+	};
+
+	// number of values sent through the channel in each iteration. Evenly divisible by all thread counts
+	constexpr int values_count = 64 * 1024;
+
+	/**
+	 * \brief send values from the supplied number of producers to the same number of consumers
+	 */
+	template<class C>
+	void produce_consume(int threads)
+	{
+		C c;
+		const int per_thread = values_count / threads;
+		std::vector<std::thread> workers;
+		workers.reserve(threads * 2);
+		for (int i = 0; i < threads; ++i)
+		{
+			workers.emplace_back([&c, per_thread]()
+			{
+				for (int j = 0; j < per_thread; ++j)
+					c.put(j + 1);
+			});
+			workers.emplace_back([&c, per_thread]()
+			{
+				unsigned long long sum = 0;
+				for (int j = 0; j < per_thread; ++j)
+				{
+					int value;
+					if (c.wait_pop(&value))
+						sum += value;
+				}
+				benchmark_state::sink() = benchmark_state::sink() + sum;
+			});
+		}
+		for (auto& w: workers)
+			w.join();
+	}
+}
+
+void channel_()
+{
+	suite("channel", []()
+	{
+		for (int threads = 1; threads <= 64; threads *= 2)
+		{
+			const auto suffix = std::to_string(threads) + " producers/consumers";
+			benchmark("legacy " + suffix, 5, [threads]()
+			{
+				produce_consume<legacy_channel<int>>(threads);
+			});
+			benchmark("channel " + suffix, 5, [threads]()
+			{
+				produce_consume<channel<int>>(threads);
+			});
+		}
+	});
+}
@@ -0,0 +1,88 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "../benchmark.h"
+#include "../../parser/token.h"
+#include "../../parser/scanner.h"
+#include <string>
+
+using namespace o2;
+using namespace o2::benchmarking;
+
+namespace
+{
+	/**
+	 * \brief generate source code that's roughly the supplied number of bytes
+	 */
+	std::string generate_source(size_t size)
+	{
+		std::string result;
+		result.reserve(size + 1024);
+		result += "import \"lang/io\"\n\n";
+		for (int i = 0; result.size() < size; ++i)
+		{
+			const auto n = std::to_string(i);
+			result += "/*\n"
+					  " * a multiline comment that describes the function number " + n + "\n"
+					  " * and the structure that it's operating on\n"
+					  " */\n"
+					  "type Vector" + n + " struct {\n"
+					  "\tx int32\n"
+					  "\ty int32\n"
+					  "\tz float32\n"
+					  "}\n\n"
+					  "// a single line comment for the function\n"
+					  "func calculate_something_" + n + "(first_argument int32, second_argument *Vector" + n + ") int32 {\n"
+					  "    var message = \"the result of the calculation is \\\"unknown\\\" at this point\"\n"
+					  "    var local_value := first_argument * 2 + second_argument.x - " + n + "\n"
+					  "    if local_value >= 100 {\n"
+					  "        return local_value / 3\n"
+					  "    }\n"
+					  "    return -local_value + 0x" + n + "\n"
+					  "}\n\n";
+		}
+		return result;
+	}
+
+	void lex(const std::string& source)
+	{
+		const lexer l(source);
+		token t(&l);
+		unsigned long long count = 0;
+		while (t.next() != token_type::eof)
+			count++;
+		benchmark_state::sink() = benchmark_state::sink() + count;
+	}
+}
+
+void lexer_()
+{
+	suite("lexer", []()
+	{
+		const auto source = generate_source(16 * 1024 * 1024);
+		const auto megabytes = (double)source.size() / (1024.0 * 1024.0);
+		const auto previous = scanner::get()->isa;
+
+		const std::pair<scanner_isa, const char*> isas[] = {
+				{ scanner_isa::scalar, "scalar" },
+				{ scanner_isa::sse2, "sse2" },
+				{ scanner_isa::avx2, "avx2" },
+		};
+		for (const auto& isa: isas)
+		{
+			if (!scanner::select(isa.first))
+			{
+				std::cout << "\tbenchmark 'lex " << isa.second << "' - not supported" << std::endl;
+				continue;
+			}
+			const auto ns = benchmark(std::string("lex ") + isa.second, 5, [&source]()
+			{
+				lex(source);
+			});
+			std::cout << "\t\t" << megabytes / (ns / 1'000'000'000.0) << " MB/s" << std::endl;
+		}
+		scanner::select(previous);
+	});
+}
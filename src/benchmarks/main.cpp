@@ -0,0 +1,24 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "benchmark.h"
+
+extern void vector_();
+
+extern void channel_();
+
+extern void lexer_();
+
+int main(int argc, char** argv)
+{
+	if (argc > 1)
+		o2::benchmarking::benchmark_state::suite_name() = argv[1];
+
+	vector_();
+	channel_();
+	lexer_();
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "../benchmark.h"
+#include "../../parser/collections/vector.h"
+#include <cstdlib>
+#include <string>
+
+using namespace o2;
+using namespace o2::benchmarking;
+
+namespace
+{
+	/**
+	 * \brief the vector implementation used before inline storage and geometric growth was introduced. Only
+	 *        the parts needed by the benchmarks are kept
+	 */
+	template<typename T, int Resize = 4>
+	class legacy_vector
+	{
+	public:
+		legacy_vector()
+				: _capacity(0), _memory(nullptr), _size(0)
+		{
+		}
+
+		~legacy_vector()
+		{
+			if (_memory)
+				free(_memory);
+		}
+
+		[[nodiscard]] int size() const
+		{
+			return _size;
+		}
+
+		void add(T value)
+		{
+			if (_size == _capacity)
+			{
+				_capacity += Resize;
+				if (_memory == nullptr)
+					_memory = static_cast<T*>(malloc(sizeof(T) * _capacity));
+				else
+					_memory = static_cast<T*>(realloc(_memory, sizeof(T) * _capacity));
+			}
+			_memory[_size++] = value;
+		}
+
+		T& operator[](int idx)
+		{
+			return _memory[idx];
+		}
+
+	private:
+		int _capacity;
+		T* _memory;
+		int _size;
+	};
+
+	// fake node pointers that are added to the vectors
+	void* item(int i)
+	{
+		return reinterpret_cast<void*>(static_cast<size_t>(i + 1) * 16);
+	}
+
+	/**
+	 * \brief simulate a package with a large amount of children
+	 */
+	template<class V>
+	void add_many(int count)
+	{
+		V v;
+		for (int i = 0; i < count; ++i)
+			v.add(item(i));
+		benchmark_state::sink() = benchmark_state::sink() + reinterpret_cast<size_t>(v[count - 1]);
+	}
+
+	/**
+	 * \brief simulate the creation of a large amount of nodes with only a few children each, such as binops and funcs
+	 */
+	template<class V>
+	void add_small(int count, int children)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			V v;
+			for (int j = 0; j < children; ++j)
+				v.add(item(j));
+			benchmark_state::sink() = benchmark_state::sink() + v.size();
+		}
+	}
+}
+
+void vector_()
+{
+	suite("vector", []()
+	{
+		benchmark("legacy add 100000", 20, []()
+		{
+			add_many<legacy_vector<void*>>(100000);
+		});
+		benchmark("vector add 100000", 20, []()
+		{
+			add_many<vector<void*>>(100000);
+		});
+		benchmark("legacy 100000 vectors with 2 items", 20, []()
+		{
+			add_small<legacy_vector<void*>>(100000, 2);
+		});
+		benchmark("vector 100000 vectors with 2 items", 20, []()
+		{
+			add_small<vector<void*>>(100000, 2);
+		});
+		benchmark("legacy 100000 vectors with 4 items", 20, []()
+		{
+			add_small<legacy_vector<void*>>(100000, 4);
+		});
+		benchmark("vector 100000 vectors with 4 items", 20, []()
+		{
+			add_small<vector<void*>>(100000, 4);
+		});
+		benchmark("vector add 100000 non-trivial items", 20, []()
+		{
+			// legacy_vector can't be used here, because items are copied using realloc
+			vector<std::string> v;
+			for (int i = 0; i < 100000; ++i)
+				v.add(std::to_string(i));
+			benchmark_state::sink() = benchmark_state::sink() + v[99999].size();
+		});
+	});
+}
@@ -0,0 +1,301 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "build_cache.h"
+#include "../parser/content_hash.h"
+#include "../parser/mapped_file.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace o2;
+
+#ifndef O2_VERSION
+#define O2_VERSION "unknown"
+#endif
+
+namespace
+{
+	// the file extension of the entries in the cache
+	const std::string_view entry_extension(".o2i");
+
+	// temporary files older than this are left behind by builds that are aborted while writing an entry
+	const auto abandoned_age = std::chrono::hours(1);
+
+	// the first bytes of all entries
+	constexpr char magic[4] = { 'O', '2', 'C', 'E' };
+
+	template<typename T>
+	void put(std::string* dest, T value)
+	{
+		dest->append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	void put(std::string* dest, string_view text)
+	{
+		put(dest, (std::uint32_t)text.length());
+		dest->append(reinterpret_cast<const char*>(text.data()), text.length() * sizeof(string_literal));
+	}
+
+	/**
+	 * \brief read a value from the supplied bytes
+	 * \return false if there are not enough bytes left
+	 */
+	template<typename T>
+	bool get(std::string_view* bytes, T* value)
+	{
+		if (bytes->length() < sizeof(T))
+			return false;
+		std::memcpy(value, bytes->data(), sizeof(T));
+		bytes->remove_prefix(sizeof(T));
+		return true;
+	}
+
+	bool get(std::string_view* bytes, string* text)
+	{
+		std::uint32_t length;
+		if (!get(bytes, &length) || bytes->length() / sizeof(string_literal) < length)
+			return false;
+		text->resize(length);
+		std::memcpy(text->data(), bytes->data(), length * sizeof(string_literal));
+		bytes->remove_prefix(length * sizeof(string_literal));
+		return true;
+	}
+}
+
+build_cache::build_cache(std::filesystem::path path, std::uintmax_t max_size)
+		: _path(std::move(path)), _max_size(max_size), _hits(0), _misses(0), _stores(0), _evictions(0),
+		  _evicted_size(0), _size(0)
+{
+}
+
+std::uint64_t build_cache::get_package_key(array_view<source_code*> sources, string_view package_name)
+{
+	content_hash hash;
+	hash.add(hash_package_sources(sources, package_name));
+	hash.add(string_view(O2_VERSION));
+	return hash.get();
+}
+
+std::uint64_t build_cache::get_entry_key(std::uint64_t stamp, string_view package_name)
+{
+	// the number of node kinds is part of the key, which makes sure that entries written before a new kind of
+	// node is added are not used
+	content_hash hash;
+	hash.add(package_interface_version);
+	hash.add((std::uint64_t)node_kind::last);
+	hash.add(string_view(O2_VERSION));
+	hash.add(package_name);
+	hash.add(stamp);
+	return hash.get();
+}
+
+bool build_cache::load_package(std::uint64_t key, package_source_info* info, parser_state* state,
+		cached_package* dest)
+{
+	const auto path = get_entry_path(key);
+	bool found = false;
+	const std::unique_ptr<mapped_file> mapped(mapped_file::open(path));
+	if (mapped != nullptr)
+		found = read(mapped->get_text(), key, info, state, dest);
+	else
+	{
+		// not all files can be memory mapped, so read the file into memory instead
+		std::ifstream stream(path, std::ios::binary);
+		if (stream.is_open())
+		{
+			const std::string bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+			found = read(bytes, key, info, state, dest);
+		}
+	}
+
+	if (!found)
+	{
+		_misses++;
+		return false;
+	}
+
+	// the modification time is the time the entry was last used, which is what the eviction is based on
+	std::error_code ec;
+	std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+	_hits++;
+	return true;
+}
+
+bool build_cache::store_package(std::uint64_t key, std::uint64_t source_key, std::uint64_t package_key,
+		node_package* package, array_view<source_code*> sources)
+{
+	// the source code is stored with the package, since the nodes refer to it
+	std::string bytes;
+	bytes.append(magic, sizeof(magic));
+	put(&bytes, key);
+	put(&bytes, source_key);
+	put(&bytes, package_key);
+	put(&bytes, (std::uint32_t)sources.size());
+	for (auto s: sources)
+	{
+		put(&bytes, s->get_filename());
+		put(&bytes, s->get_text());
+	}
+	if (!write_package_interface(package, sources, &bytes))
+		return false;
+	if (!write(get_entry_path(key), bytes))
+		return false;
+	_stores++;
+	return true;
+}
+
+void build_cache::evict()
+{
+	struct entry
+	{
+		std::filesystem::path path;
+		std::filesystem::file_time_type time;
+		std::uintmax_t size;
+	};
+
+	std::vector<entry> entries;
+	std::uintmax_t size = 0;
+	const auto now = std::filesystem::file_time_type::clock::now();
+	std::error_code ec;
+	for (auto it = std::filesystem::recursive_directory_iterator(_path, ec);
+		 !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+	{
+		if (!it->is_regular_file(ec))
+			continue;
+
+		const auto& path = it->path();
+		const auto time = it->last_write_time(ec);
+		if (ec)
+			continue;
+		if (path.extension() == entry_extension)
+		{
+			const auto file_size = it->file_size(ec);
+			if (ec)
+				continue;
+			entries.push_back({ path, time, file_size });
+			size += file_size;
+		}
+		else if (path.extension() == ".tmp" && now - time > abandoned_age)
+			std::filesystem::remove(path, ec);
+	}
+
+	// remove the least recently used entries first
+	std::sort(entries.begin(), entries.end(), [](const entry& lhs, const entry& rhs)
+	{
+		return lhs.time < rhs.time;
+	});
+	for (const auto& e: entries)
+	{
+		if (size <= _max_size)
+			break;
+		if (!std::filesystem::remove(e.path, ec))
+			continue;
+		size -= e.size;
+		_evictions++;
+		_evicted_size += e.size;
+	}
+	_size = size;
+}
+
+build_cache::statistics build_cache::get_statistics() const
+{
+	return { _hits, _misses, _stores, _evictions, _evicted_size, _size };
+}
+
+void build_cache::reset_statistics()
+{
+	_hits = 0;
+	_misses = 0;
+	_stores = 0;
+	_evictions = 0;
+	_evicted_size = 0;
+}
+
+std::filesystem::path build_cache::get_entry_path(std::uint64_t key) const
+{
+	// the entries are spread over sub-directories named after the first byte of the key, which keeps the
+	// directories small even if the cache is large
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+	std::string file(name + 2);
+	file += entry_extension;
+	return _path / std::string_view(name, 2) / file;
+}
+
+bool build_cache::read(std::string_view bytes, std::uint64_t key, package_source_info* info, parser_state* state,
+		cached_package* dest)
+{
+	std::uint64_t entry_key;
+	std::uint32_t count;
+	if (bytes.length() < sizeof(magic) || std::memcmp(bytes.data(), magic, sizeof(magic)) != 0)
+		return false;
+	bytes.remove_prefix(sizeof(magic));
+	if (!get(&bytes, &entry_key) || entry_key != key || !get(&bytes, &dest->source_key) ||
+		!get(&bytes, &dest->package_key) || !get(&bytes, &count))
+		return false;
+
+	vector<source_code*> sources;
+	for (std::uint32_t i = 0; i < count; ++i)
+	{
+		string filename;
+		string text;
+		if (!get(&bytes, &filename) || !get(&bytes, &text))
+			break;
+		sources.add(new source_code(std::move(text), std::move(filename)));
+	}
+
+	if (sources.size() == (int)count)
+	{
+		dest->package = read_package_interface(bytes, sources, info->name, state, &dest->links);
+		if (dest->package != nullptr)
+		{
+			info->sources.add(sources);
+			return true;
+		}
+	}
+
+	for (auto s: sources)
+		delete s;
+	return false;
+}
+
+bool build_cache::write(const std::filesystem::path& path, std::string_view bytes)
+{
+	std::error_code ec;
+	std::filesystem::create_directories(path.parent_path(), ec);
+	if (ec)
+		return false;
+
+	// the entry is written to a temporary file first. This makes sure that a build running at the same time
+	// never reads a partially written entry
+	auto temp_path = path;
+	temp_path += "." + std::to_string(std::random_device()()) + ".tmp";
+	{
+		std::ofstream stream(temp_path, std::ios::binary | std::ios::trunc);
+		if (!stream.is_open())
+			return false;
+		stream.write(bytes.data(), (std::streamsize)bytes.size());
+		if (!stream)
+		{
+			stream.close();
+			std::filesystem::remove(temp_path, ec);
+			return false;
+		}
+	}
+
+	std::filesystem::rename(temp_path, path, ec);
+	if (ec)
+	{
+		std::filesystem::remove(temp_path, ec);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,163 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "../parser/package/package_interface.h"
+#include "../parser/module/module_package_lookup.h"
+
+namespace o2
+{
+	/**
+	 * \brief a cache of the resolved packages imported by a build
+	 *
+	 * Each entry is named after a key, which is the hash of the stamp of the source files of the package, the format
+	 * of the entry and the version of the compiler. The stamp is figured out without reading the source files, so
+	 * a package found in the cache is neither loaded, parsed nor resolved. An entry also contains the key of the
+	 * source code and the key of the package, which includes the keys of the packages it imports, when it's
+	 * stored. The package key tells if the package is resolved using the same imports as the current build, and
+	 * is the key of the package when the source code is changed while watching. Entries are replaced atomically, which means that builds running at the same time can share the same
+	 * cache. The least recently used entries are evicted when the cache grows larger than the maximum size
+	 */
+	class build_cache
+	{
+	public:
+		/**
+		 * \brief a package loaded from the cache
+		 */
+		struct cached_package
+		{
+			// the package. It's resolved, but the references to the nodes in other packages must be linked
+			node_package* package;
+			// the references to the nodes in other packages
+			vector<package_interface_link> links;
+			// the key of the source code of the package
+			std::uint64_t source_key;
+			// the key of the package, which includes the keys of the packages it imports, when it's stored
+			std::uint64_t package_key;
+		};
+
+		struct statistics
+		{
+			// number of entries found in the cache
+			int hits;
+			// number of entries not found in the cache
+			int misses;
+			// number of entries written to the cache
+			int stores;
+			// number of entries removed from the cache
+			int evictions;
+			// the size of the removed entries
+			std::uintmax_t evicted_size;
+			// the size of the cache after the last eviction
+			std::uintmax_t size;
+		};
+
+		/**
+		 * \param path the directory where the entries are stored. The cache is disabled if the path is empty
+		 * \param max_size the maximum size of the cache, in bytes
+		 */
+		build_cache(std::filesystem::path path, std::uintmax_t max_size);
+
+		/**
+		 * \return true if the cache is enabled
+		 */
+		[[nodiscard]] bool is_enabled() const
+		{
+			return !_path.empty();
+		}
+
+		/**
+		 * \brief get the key of the supplied package sources
+		 * \param sources the source code of the package
+		 * \param package_name the name of the package
+		 * \return the key
+		 */
+		[[nodiscard]] static std::uint64_t get_package_key(array_view<source_code*> sources,
+				string_view package_name);
+
+		/**
+		 * \brief get the key of the entry of a package
+		 * \param stamp the stamp of the source files of the package
+		 * \param package_name the name of the package
+		 * \return the key
+		 */
+		[[nodiscard]] static std::uint64_t get_entry_key(std::uint64_t stamp, string_view package_name);
+
+		/**
+		 * \brief load a package from the cache
+		 * \param key the key of the entry
+		 * \param info the package. The source code stored with the package is put into it
+		 * \param state the parser state. Imports found in the package are added to it
+		 * \param dest where the package is put
+		 * \return true if the package is found in the cache
+		 * \remark this is safe to call from more than one thread
+		 */
+		bool load_package(std::uint64_t key, package_source_info* info, parser_state* state, cached_package* dest);
+
+		/**
+		 * \brief store a resolved package in the cache
+		 * \param key the key of the entry
+		 * \param source_key the key of the source code of the package
+		 * \param package_key the key of the package, which includes the keys of the packages it imports
+		 * \param package the package
+		 * \param sources the source code the package is parsed from
+		 * \return true if the package is stored
+		 * \remark this is safe to call from more than one thread
+		 */
+		bool store_package(std::uint64_t key, std::uint64_t source_key, std::uint64_t package_key,
+				node_package* package, array_view<source_code*> sources);
+
+		/**
+		 * \brief remove the least recently used entries until the cache is no larger than its maximum size
+		 */
+		void evict();
+
+		/**
+		 * \return the statistics of this cache
+		 */
+		[[nodiscard]] statistics get_statistics() const;
+
+		/**
+		 * \brief reset the statistics, except for the size of the cache
+		 */
+		void reset_statistics();
+
+	private:
+		/**
+		 * \return the path to the entry with the supplied key
+		 */
+		[[nodiscard]] std::filesystem::path get_entry_path(std::uint64_t key) const;
+
+		/**
+		 * \brief read an entry
+		 * \return true if the entry is valid
+		 */
+		static bool read(std::string_view bytes, std::uint64_t key, package_source_info* info, parser_state* state,
+				cached_package* dest);
+
+		/**
+		 * \brief write an entry into the cache
+		 */
+		bool write(const std::filesystem::path& path, std::string_view bytes);
+
+	private:
+		const std::filesystem::path _path;
+		const std::uintmax_t _max_size;
+
+		std::atomic_int _hits;
+		std::atomic_int _misses;
+		std::atomic_int _stores;
+		int _evictions;
+		std::uintmax_t _evicted_size;
+		std::uintmax_t _size;
+	};
+}
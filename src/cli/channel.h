@@ -5,24 +5,36 @@
 
 #pragma once
 
-#include <thread>
-#include <future>
 #include <atomic>
-#include <queue>
+#include <thread>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
 
 namespace o2
 {
 	/**
-	 * \brief a thread-safe channel where you can put results in and out
+	 * \brief a thread-safe, bounded channel where you can put results in and out
+	 *
+	 * The channel is a lock-free multi-producer/multi-consumer ring buffer. Each slot has a sequence number that
+	 * tells producers and consumers whose turn it is to use the slot. Threads that have to wait, because the
+	 * channel is either empty or full, are put to sleep using std::atomic::wait
+	 *
 	 * \tparam T
 	 */
 	template<typename T>
 	class channel
 	{
 	public:
-		channel()
-				: _closed(false)
+		/**
+		 * \param capacity the maximum number of values in this channel. Rounded up to the nearest power of two
+		 */
+		explicit channel(size_t capacity = 1024)
+				: _mask(round_up(capacity) - 1), _slots(new slot[_mask + 1]), _enqueue_pos(0), _dequeue_pos(0),
+				  _closed(false), _put_signal(0), _pop_signal(0), _put_waiters(0), _pop_waiters(0)
 		{
+			for (size_t i = 0; i <= _mask; ++i)
+				_slots[i].sequence.store(i, std::memory_order_relaxed);
 		}
 
 		/**
@@ -32,36 +44,68 @@ namespace o2
 		 */
 		bool wait_pop(T* val)
 		{
-			// wait for the channel to be triggered
-			std::unique_lock l(_mutex);
-			_condition.wait(l, [this]
+			int attempts = 0;
+			while (true)
 			{
-				return !_queue.empty() || _closed;
-			});
+				// is the channel closed?
+				if (_closed.load(std::memory_order_acquire))
+					return false;
+
+				if (try_pop(val))
+				{
+					signal(_pop_signal, _pop_waiters);
+					return true;
+				}
 
-			// is the channel closed?
-			if (_closed)
-				return false;
+				// give producers a chance to put a value before going to sleep
+				if (++attempts < spin_count)
+				{
+					std::this_thread::yield();
+					continue;
+				}
 
-			// get the value from the queue
-			*val = std::move(_queue.front());
-			_queue.pop();
-			return true;
+				// sleep until a value is put, or the channel is closed
+				_put_waiters.fetch_add(1, std::memory_order_seq_cst);
+				const auto signal_value = _put_signal.load(std::memory_order_seq_cst);
+				if (!_closed.load(std::memory_order_seq_cst) && empty())
+					_put_signal.wait(signal_value, std::memory_order_seq_cst);
+				_put_waiters.fetch_sub(1, std::memory_order_relaxed);
+			}
 		}
 
 		/**
-		 * \brief put a value into this channel
+		 * \brief put a value into this channel. Waits for space to become available if the channel is full
 		 * \param t
 		 * \return true if the value was added to the channel
 		 */
 		bool put(const T& t)
 		{
-			if (_closed)
-				return false;
-			std::lock_guard l(_mutex);
-			_queue.push(t);
-			_condition.notify_one();
-			return true;
+			int attempts = 0;
+			while (true)
+			{
+				if (_closed.load(std::memory_order_acquire))
+					return false;
+
+				if (try_put(t))
+				{
+					signal(_put_signal, _put_waiters);
+					return true;
+				}
+
+				// give consumers a chance to pop a value before going to sleep
+				if (++attempts < spin_count)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				// sleep until a value is popped, or the channel is closed
+				_pop_waiters.fetch_add(1, std::memory_order_seq_cst);
+				const auto signal_value = _pop_signal.load(std::memory_order_seq_cst);
+				if (!_closed.load(std::memory_order_seq_cst) && full())
+					_pop_signal.wait(signal_value, std::memory_order_seq_cst);
+				_pop_waiters.fetch_sub(1, std::memory_order_relaxed);
+			}
 		}
 
 		/**
@@ -69,32 +113,139 @@ namespace o2
 		 */
 		void close()
 		{
-			if (_closed)
+			if (_closed.exchange(true, std::memory_order_seq_cst))
 				return;
-			std::lock_guard l(_mutex);
-			_closed = true;
-			_condition.notify_all();
+			_put_signal.fetch_add(1, std::memory_order_seq_cst);
+			_put_signal.notify_all();
+			_pop_signal.fetch_add(1, std::memory_order_seq_cst);
+			_pop_signal.notify_all();
 		}
 
 		/**
 		 * \return true if this channel is still opened
 		 */
-		bool is_open()
+		bool is_open() const
+		{
+			return !_closed.load(std::memory_order_acquire);
+		}
+
+		bool empty() const
+		{
+			const auto pos = _dequeue_pos.load(std::memory_order_seq_cst);
+			const auto seq = _slots[pos & _mask].sequence.load(std::memory_order_seq_cst);
+			return (intptr_t)seq - (intptr_t)(pos + 1) < 0;
+		}
+
+	private:
+		struct slot
+		{
+			std::atomic_size_t sequence;
+			T value;
+		};
+
+		static size_t round_up(size_t capacity)
 		{
-			std::lock_guard l(_mutex);
-			return !_closed;
+			size_t result = 2;
+			while (result < capacity)
+				result <<= 1;
+			return result;
 		}
 
-		bool empty()
+		bool full() const
 		{
-			std::lock_guard l(_mutex);
-			return _queue.empty();
+			const auto pos = _enqueue_pos.load(std::memory_order_seq_cst);
+			const auto seq = _slots[pos & _mask].sequence.load(std::memory_order_seq_cst);
+			return (intptr_t)seq - (intptr_t)pos < 0;
+		}
+
+		bool try_put(const T& t)
+		{
+			auto pos = _enqueue_pos.load(std::memory_order_relaxed);
+			while (true)
+			{
+				auto& s = _slots[pos & _mask];
+				const auto seq = s.sequence.load(std::memory_order_acquire);
+				const auto diff = (intptr_t)seq - (intptr_t)pos;
+				if (diff == 0)
+				{
+					// the slot is free. Try to claim it
+					if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						s.value = t;
+						s.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0)
+				{
+					// the channel is full
+					return false;
+				}
+				else
+				{
+					// another producer claimed the slot before us
+					pos = _enqueue_pos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool try_pop(T* val)
+		{
+			auto pos = _dequeue_pos.load(std::memory_order_relaxed);
+			while (true)
+			{
+				auto& s = _slots[pos & _mask];
+				const auto seq = s.sequence.load(std::memory_order_acquire);
+				const auto diff = (intptr_t)seq - (intptr_t)(pos + 1);
+				if (diff == 0)
+				{
+					// the slot contains a value. Try to claim it
+					if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						*val = std::move(s.value);
+						s.sequence.store(pos + _mask + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0)
+				{
+					// the channel is empty
+					return false;
+				}
+				else
+				{
+					// another consumer claimed the slot before us
+					pos = _dequeue_pos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/**
+		 * \brief wake up sleeping threads, if there are any
+		 */
+		static void signal(std::atomic_uint32_t& s, std::atomic_int& waiters)
+		{
+			s.fetch_add(1, std::memory_order_seq_cst);
+			if (waiters.load(std::memory_order_seq_cst) > 0)
+				s.notify_all();
 		}
 
 	private:
-		bool _closed;
-		std::mutex _mutex;
-		std::condition_variable _condition;
-		std::queue<T> _queue;
+		static constexpr size_t cache_line = 64;
+		// number of times we try to put or pop a value before going to sleep
+		static constexpr int spin_count = 16;
+
+		const size_t _mask;
+		const std::unique_ptr<slot[]> _slots;
+
+		// producers and consumers are kept on separate cache lines to prevent false sharing
+		alignas(cache_line) std::atomic_size_t _enqueue_pos;
+		alignas(cache_line) std::atomic_size_t _dequeue_pos;
+		alignas(cache_line) std::atomic_bool _closed;
+
+		std::atomic_uint32_t _put_signal;
+		std::atomic_uint32_t _pop_signal;
+		std::atomic_int _put_waiters;
+		std::atomic_int _pop_waiters;
 	};
-}
\ No newline at end of file
+}
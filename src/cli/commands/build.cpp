@@ -4,12 +4,14 @@
 //
 
 #include "build.h"
+#include "../../parser/content_hash.h"
 #include <sstream>
 #include <iostream>
 #include <sstream>
 #include <filesystem>
 #include <utility>
 #include <fstream>
+#include <algorithm>
 
 using namespace o2;
 
@@ -20,40 +22,61 @@ namespace
 		return std::chrono::duration_cast<std::chrono::milliseconds>(
 				std::chrono::system_clock::now().time_since_epoch()).count();
 	}
+
+	/**
+	 * \brief get the absolute path of the supplied directory, which allows for two paths to be compared
+	 */
+	std::filesystem::path normalize_path(const std::filesystem::path& path)
+	{
+		std::error_code ec;
+		auto result = std::filesystem::weakly_canonical(std::filesystem::absolute(path, ec), ec);
+		// "a/b/" and "a/b" are the same directory
+		if (!result.has_filename())
+			result = result.parent_path();
+		return result;
+	}
+
+	/**
+	 * \brief check if the supplied path is the supplied directory, or a path inside it. Both paths are normalized
+	 */
+	bool is_inside(const std::filesystem::path& path, const std::filesystem::path& dir)
+	{
+		const auto relative = path.lexically_relative(dir);
+		return !relative.empty() && *relative.begin() != "..";
+	}
 }
 
 build::build(config cfg)
 		: _config(std::move(cfg)), _context(), _syntax_tree(_context), _pending_requests(),
 		  _system_module(_config.lang_path, &_syntax_tree),
-		  _main_module(), _aborted()
+		  _main_module(), _main_package_info(), _cache(_config.cache_path, _config.cache_size), _aborted(), _scheduler(_config.threads_count)
 {
 }
 
 build::~build()
 {
-	assert(!_parse_responses.is_open());
-	assert(!_parse_requests.is_open());
+	// a build that's kept by a server is never executed to the end, so make sure that no worker waits for the
+	// responses to be handled
+	_parse_responses.close();
+	_resolve_responses.close();
 }
 
 int build::execute()
 {
-	const auto start = now();
+	auto exit_code = rebuild();
+	if (_config.watch)
+		exit_code = watch(exit_code);
 
-	// spawn all threads used for the actual processing
-	for (int i = 0; i < _config.threads_count; ++i)
-	{
-		_threads.emplace_back([requests = &_parse_requests, responses = &_parse_responses]
-		{
-			// process requests as quickly as possible, as long as the request channel is open
-			while (requests->is_open())
-			{
-				async_data* data;
-				if (!requests->wait_pop(&data))
-					continue;
-				responses->put(build::parse(data));
-			}
-		});
-	}
+	_parse_responses.close();
+	_scheduler.stop();
+	return exit_code;
+}
+
+int build::rebuild()
+{
+	const auto start = now();
+	if (_main_module != nullptr)
+		return output(compile(), start);
 
 	// TODO: Parse module file in the config root path and figure out the module name form that
 	const string_view module_name(STR("westcoastcode.se/hello_world"));
@@ -61,35 +84,110 @@ int build::execute()
 	_main_module = o2_new module(&_system_module, module_name, _config.path);
 	_main_module->insert_into(&_syntax_tree);
 
-	// Prepare a parser state used for the main application
-	parser_state state(&_syntax_tree);
+	// convert the "path" where the main source code is found in the module
+	// into a module-relative path
+	_main_package_name = _main_module->get_name();
+	if (_config.path != ".")
+	{
+		_main_package_name += STR("/");
+		_main_package_name += _config.path.generic_string();
+	}
+	_main_package_info = _main_module->get_package_info(_main_package_name);
+	_package_modules[_main_package_info] = _main_module;
+	return output(compile(), start);
+}
 
-	bool success = true;
-	try
+bool build::compile()
+{
+	auto success = load_packages();
+
+	// a package loaded from the cache refers to the nodes in the packages it's resolved with. If they are changed,
+	// the package must be parsed and resolved again
+	while (remove_outdated_packages())
+		success = load_packages() && success;
+
+	// the keys decide which packages are kept when the source code is changed
+	_package_keys = get_package_keys(_source_keys);
+
+	// all packages are loaded, so let's resolve them
+	if (!resolve_packages())
+		success = false;
+
+	// the function bodies of the imported packages are skipped while parsing them. Parse them now, when all
+	// declarations are known
+	if (success && !parse_imported_bodies())
+		success = false;
+
+	// only the packages loaded by this build are optimized, since the packages that are kept are optimized already
+	if (success)
 	{
-		// convert the "path" where the main source code is found in the module
-		// into a module-relative path
-		string app(_main_module->get_name());
-		if (_config.path != ".")
+		try
 		{
-			app += STR("/");
-			app += _config.path.generic_string();
+			vector<node_package*> packages;
+			for (auto p: _unoptimized)
+				packages.add(p);
+			_unoptimized.clear();
+			optimize(packages, 0, _config.verbose_level > 0 ? _config.out : nullptr);
 		}
+		catch (const o2::error& e)
+		{
+			// print errors, but continue evaluating all other source code
+			// because it's tedious to having to fix one problem at a time
+			e.print(*_config.err);
+			success = false;
 
-		parse_main_module_package(_main_module, app, &state);
-		if (_config.verbose_level > 0)
-			std::cout << "parsed '" << app << "' - done!" << std::endl;
+			// it's not known which package the error is raised in, so build all packages again
+			for (const auto& it: _package_infos)
+				_failed.insert(it.second);
+		}
 	}
-	catch (const o2::error& e)
+
+	// the packages are stored when they are resolved and optimized without errors
+	if (success)
+		store_packages();
+	_uncached.clear();
+	return success;
+}
+
+bool build::load_packages()
+{
+	// Prepare a parser state used for the main application
+	parser_state state(&_syntax_tree);
+	state.set_parallel_for(parallel_for());
+
+	bool success = true;
+	vector<node_import*> imports;
+	if (_main_package_info->load_status == package_source_info::not_loaded)
 	{
-		// print errors, but continue evaluating all other source code
-		// because it's tedious to having to fix one problem at a time
-		e.print(std::cerr);
-		success = false;
+		try
+		{
+			const auto package = parse_main_module_package(_main_module, _main_package_name, &state);
+			if (package != nullptr)
+			{
+				_package_infos[package] = _main_package_info;
+				_source_keys[_main_package_info] = build_cache::get_package_key(_main_package_info->sources,
+						_main_package_info->name);
+				_entry_keys[_main_package_info] = 0;
+				_unresolved.push_back(package);
+				_unoptimized.push_back(package);
+			}
+			if (_config.verbose_level > 0)
+				*_config.out << "parsed '" << _main_package_name << "' - done!" << std::endl;
+
+			// the imports are only valid if the package is parsed
+			imports = state.get_imports();
+		}
+		catch (const o2::error& e)
+		{
+			// print errors, but continue evaluating all other source code
+			// because it's tedious to having to fix one problem at a time
+			e.print(*_config.err);
+			_failed.insert(_main_package_info);
+			success = false;
+		}
 	}
 
 	// do import everything found in the main source code
-	auto imports = state.get_imports();
 	for (auto i: imports)
 	{
 		const auto m = _main_module->find_module(i->get_import_statement());
@@ -100,20 +198,13 @@ int build::execute()
 		}
 		else
 		{
-			std::cerr << "could not import '" << i->get_import_statement() << "' because module could not be found"
+			*_config.err << "could not import '" << i->get_import_statement() << "' because module could not be found"
 					  << std::endl;
+			_failed.insert(_main_package_info);
 			success = false;
 		}
 	}
 
-	// no imports so we can already resolve all properties
-	if (imports.empty())
-	{
-		const recursion_detector rd;
-		for (auto p: _main_module->get_packages())
-			p->process_phases();
-	}
-
 	// handle each parse request and import statement
 	while (_parse_responses.is_open() && _pending_requests > 0)
 	{
@@ -127,8 +218,9 @@ int build::execute()
 		{
 			// log the parse failure
 			data->in.package_info->load_status = package_source_info::failed;
+			_failed.insert(data->in.package_info);
 			for (const auto& e: data->out.errors)
-				std::cerr << e << std::endl;
+				*_config.err << e << std::endl;
 			success = false;
 			// delete the data
 			delete data;
@@ -140,10 +232,11 @@ int build::execute()
 		assert(data->out.package);
 		if (_config.verbose_level > 0)
 		{
+			const auto verb = data->out.cached ? "loaded '" : "parsed '";
 			if (data->in.package_info->relative_path.empty())
-				std::cout << "parsed '" << data->in.module->get_name() << "' - done!" << std::endl;
+				*_config.out << verb << data->in.module->get_name() << "' - done!" << std::endl;
 			else
-				std::cout << "parsed '" << data->in.module->get_name() << "/" << data->in.package_info->relative_path
+				*_config.out << verb << data->in.module->get_name() << "/" << data->in.package_info->relative_path
 						  << "' - done!" << std::endl;
 		}
 
@@ -156,95 +249,128 @@ int build::execute()
 		const auto imported_module = data->in.module;
 		const auto imported_package = data->out.package;
 		imported_module->add_package(imported_package);
+		_unresolved.push_back(imported_package);
+		if (data->out.cached)
+			_unlinked[imported_package] = { std::move(data->out.links), data->out.package_key };
+		else
+		{
+			_unparsed_bodies.push_back(imported_package);
+			_unoptimized.push_back(imported_package);
+			_unstored.push_back(imported_package);
+		}
+		_package_infos[imported_package] = data->in.package_info;
+		_source_keys[data->in.package_info] = data->out.key;
+		_entry_keys[data->in.package_info] = data->out.entry_key;
 
 		// collect all imports to be parsed
 		imports = data->out.state.get_imports();
-		if (imports.empty())
+		for (auto i: imports)
 		{
-			// package is now imported
-			imported_module->notify_package_imported(imported_package);
-			try
+			const auto m = imported_module->find_module(i->get_import_statement());
+			if (m)
 			{
-				// all imports are imported, so let's resolve this package's dependencies!
-				imported_package->process_phases();
-			}
-			catch (const o2::error& e)
-			{
-				// print errors, but continue evaluating all other source code
-				// because it's tedious to having to fix one problem at a time
-				e.print(std::cerr);
-				success = false;
+				const auto sources = m->get_package_info(i->get_import_statement());
+				if (try_import(data, i, m, sources) == package_source_info::loading)
+					data = nullptr;
 			}
 		}
-		else
-		{
-			auto imports_left = imports.size();
-			for (auto i: imports)
-			{
-				const auto m = imported_module->find_module(i->get_import_statement());
-				if (m)
-				{
-					const auto sources = m->get_package_info(i->get_import_statement());
-					switch (try_import(data, i, m, sources))
-					{
-					case package_source_info::loading:
-						data = nullptr;
-						break;
-					case package_source_info::successful:
-						imports_left--;
-						break;
-					default:
-						break;
-					}
-				}
-			}
 
-			// package is now imported. This is done after, potentially, importing more packages to lessen the time
-			// we have to wait and sleep
-			imported_module->notify_package_imported(imported_package);
+		// package is now imported. This is done after, potentially, importing more packages to lessen the time
+		// we have to wait and sleep
+		imported_module->notify_package_imported(imported_package);
+		// delete any state that's pending
+		delete data;
+	}
+	return success;
+}
 
-			// all imports are imported, so let's resolve this package
-			if (imports_left == 0)
+bool build::remove_outdated_packages()
+{
+	if (_unlinked.empty())
+		return false;
+
+	vector<node_package*> packages;
+	for (const auto& it: _package_infos)
+		packages.add(it.first);
+	const package_graph graph(packages);
+	const auto& units = graph.get_units();
+
+	// the key of a package is the same as when the package was stored if neither its source code, nor the source
+	// code of the packages it imports, is changed since then
+	const auto keys = get_package_keys(_source_keys);
+	std::vector<bool> outdated(units.size());
+	for (int i = 0; i < (int)units.size(); ++i)
+	{
+		bool cached = false, parsed = false;
+		for (auto p: units[i].packages)
+		{
+			const auto it = _unlinked.find(p);
+			if (it == _unlinked.end())
 			{
-				try
-				{
-					imported_package->process_phases();
-				}
-				catch (const o2::error& e)
-				{
-					// print errors, but continue evaluating all other source code
-					// because it's tedious to having to fix one problem at a time
-					e.print(std::cerr);
-					success = false;
-				}
+				parsed = true;
+				continue;
 			}
+			cached = true;
+			if (it->second.package_key != keys.at(_package_infos.at(p)))
+				outdated[i] = true;
 		}
-		// delete any state that's pending
-		delete data;
+
+		// packages that import each other are resolved together, so a cached package can't refer to a package
+		// in the same unit that's parsed
+		if (cached && parsed)
+			outdated[i] = true;
 	}
-	_parse_responses.close();
-	_parse_requests.close();
 
-	// wait for all threads to shut down
-	std::for_each(_threads.begin(), _threads.end(), [](std::jthread& j) -> void
+	// the units are sorted so that a unit comes after the units it depends on. The packages that import an
+	// outdated package refer to its nodes, so they are loaded again as well
+	std::vector<node_package*> removed;
+	for (int i = 0; i < (int)units.size(); ++i)
 	{
-		j.join();
-	});
+		if (!outdated[i])
+			continue;
+		for (auto d: units[i].dependents)
+			outdated[d] = true;
+		for (auto p: units[i].packages)
+			removed.push_back(p);
+	}
+	if (removed.empty())
+		return false;
 
-	if (success)
+	for (auto p: removed)
 	{
-		try
-		{
-			optimize(&_syntax_tree, 0);
-		}
-		catch (const o2::error& e)
-		{
-			// print errors, but continue evaluating all other source code
-			// because it's tedious to having to fix one problem at a time
-			e.print(std::cerr);
-			success = false;
-		}
+		const auto info = _package_infos.at(p);
+		remove_package(p);
+		info->unload();
+		_source_keys.erase(info);
+		_entry_keys.erase(info);
+		_package_keys.erase(info);
+		_uncached.insert(info);
 	}
+	return true;
+}
+
+void build::store_packages()
+{
+	const auto packages = std::move(_unstored);
+	_unstored.clear();
+	if (!_cache.is_enabled())
+		return;
+
+	// the keys are stored with the packages, which makes sure that a package is only loaded from the cache with the
+	// imports it's resolved with, and lets the next build tell if the package is changed without loading its
+	// source code
+	_scheduler.parallel_for((int)packages.size(), [&](int i)
+	{
+		const auto info = _package_infos.at(packages[i]);
+		const auto key = _entry_keys.at(info);
+		if (key != 0)
+			_cache.store_package(key, _source_keys.at(info), _package_keys.at(info), packages[i], info->sources);
+	});
+}
+
+int build::output(bool success, unsigned long long start)
+{
+	evict_cache();
 
 	const auto diff = now() - start;
 	if (!success)
@@ -256,16 +382,186 @@ int build::execute()
 		return output_json();
 		break;
 	case build_config_output::binary:
-		std::cerr << "binary output not added yet!" << std::endl;
+		*_config.err << "binary output not added yet!" << std::endl;
 		break;
 	case build_config_output::debug:
-		std::cout << "build ok - " << diff << " milliseconds" << std::endl;
-		_syntax_tree.debug();
+		*_config.out << "build ok - " << diff << " milliseconds" << std::endl;
+		_syntax_tree.debug(*_config.out);
+		*_config.out << std::endl;
 		break;
 	}
 	return 0;
 }
 
+int build::watch(int exit_code)
+{
+	file_watcher watcher({ _config.path, _config.lang_path });
+	if (!watcher.is_supported())
+	{
+		*_config.err << "watching for changes is not supported on this platform" << std::endl;
+		return exit_code;
+	}
+
+	while (!_aborted)
+	{
+		if (_config.verbose_level > 0)
+			*_config.out << "watching for changes..." << std::endl;
+
+		std::vector<std::filesystem::path> dirs;
+		if (!watcher.wait(_aborted, &dirs))
+			break;
+
+		if (invalidate(dirs))
+			exit_code = rebuild();
+	}
+	return exit_code;
+}
+
+bool build::invalidate(const std::vector<std::filesystem::path>& dirs)
+{
+	// packages that failed are always built again, which makes sure that their errors are reported again
+	std::unordered_set<package_source_info*> invalid;
+	invalid.swap(_failed);
+
+	// the source code of the packages in the changed directories is loaded again to see if it's actually changed
+	std::vector<std::filesystem::path> changed;
+	std::vector<std::filesystem::path> changed_modules;
+	for (const auto& d: dirs)
+	{
+		if (d.filename() == "o2.mod")
+			changed_modules.push_back(normalize_path(d.parent_path()));
+		else
+			changed.push_back(normalize_path(d));
+	}
+
+	// a key of zero is never the key of any source code, which means that the package, and all packages that
+	// import it, get a new key
+	auto source_keys = _source_keys;
+	for (auto& it: source_keys)
+	{
+		const auto m = _package_modules[it.first];
+		const auto root = normalize_path(m->get_root_path());
+		if (std::any_of(changed_modules.begin(), changed_modules.end(), [&root](const auto& d)
+		{
+			return is_inside(root, d);
+		}))
+		{
+			it.second = 0;
+			continue;
+		}
+
+		const auto dir = normalize_path(m->get_root_path() / it.first->relative_path.relative_path());
+		if (std::find(changed.begin(), changed.end(), dir) == changed.end())
+			continue;
+
+		package_source_info sources{ it.first->name, it.first->relative_path, package_source_info::not_loaded };
+		try
+		{
+			m->load_package_sources(&sources);
+			it.second = build_cache::get_package_key(sources.sources, sources.name);
+		}
+		catch (const std::exception&)
+		{
+			// the package is most likely removed
+			it.second = 0;
+		}
+	}
+
+	// a package is invalid if its source code, or the source code of a package it imports directly or indirectly,
+	// is changed. This is because it refers to the nodes in the packages it imports, so it must be resolved again
+	const auto keys = get_package_keys(source_keys);
+	for (const auto& it: keys)
+	{
+		if (_package_keys[it.first] != it.second)
+			invalid.insert(it.first);
+	}
+	if (invalid.empty())
+		return false;
+
+	std::vector<node_package*> removed;
+	for (const auto& it: _package_infos)
+	{
+		if (invalid.contains(it.second))
+			removed.push_back(it.first);
+	}
+	for (auto p: removed)
+		remove_package(p);
+
+	// the source code is loaded again when the packages are imported
+	for (auto info: invalid)
+	{
+		info->unload();
+		_source_keys.erase(info);
+		_entry_keys.erase(info);
+		_package_keys.erase(info);
+	}
+	return true;
+}
+
+std::unordered_map<package_source_info*, std::uint64_t> build::get_package_keys(
+		const std::unordered_map<package_source_info*, std::uint64_t>& source_keys) const
+{
+	vector<node_package*> packages;
+	for (const auto& it: _package_infos)
+		packages.add(it.first);
+
+	// the units are sorted so that the keys of the units a unit depends on are known before its own key. Packages
+	// that import each other are part of the same unit, and share the same key
+	const package_graph graph(packages);
+	const auto& units = graph.get_units();
+	std::vector<std::vector<std::uint64_t>> inputs(units.size());
+	std::unordered_map<package_source_info*, std::uint64_t> keys;
+	for (int i = 0; i < (int)units.size(); ++i)
+	{
+		auto& input = inputs[i];
+		for (auto p: units[i].packages)
+			input.push_back(source_keys.at(_package_infos.at(p)));
+
+		// the key must not depend on the order of the packages or the imports
+		std::sort(input.begin(), input.end());
+		content_hash hash;
+		for (auto k: input)
+			hash.add(k);
+		const auto key = hash.get();
+
+		for (auto p: units[i].packages)
+			keys[_package_infos.at(p)] = key;
+		for (auto d: units[i].dependents)
+			inputs[d].push_back(key);
+	}
+	return keys;
+}
+
+void build::remove_package(node_package* p)
+{
+	// the imports in the package are waiting for packages to be loaded. They must not be notified when the
+	// package is deleted
+	std::unordered_set<module*> modules;
+	for (const auto& it: _package_modules)
+		modules.insert(it.second);
+	for (auto m: modules)
+		m->remove_import_requests(p);
+
+	const auto info = _package_infos[p];
+	_package_modules[info]->remove_package(p);
+	_package_infos.erase(p);
+	std::erase(_unresolved, p);
+	std::erase(_unparsed_bodies, p);
+	std::erase(_unoptimized, p);
+	std::erase(_unstored, p);
+	_unlinked.erase(p);
+	delete p;
+}
+
+parser_state::parallel_for build::parallel_for()
+{
+	// the source code of a package is parsed by the same workers as the packages themselves
+	return [scheduler = &_scheduler](int count, const std::function<void(int)>& body)
+	{
+		scheduler->parallel_for(count, body);
+	};
+}
+
 package_source_info::status build::try_import(async_data* data, node_import* import_request, module* imported_module,
 		package_source_info* package_info)
 {
@@ -281,34 +577,330 @@ package_source_info::status build::try_import(async_data* data, node_import* imp
 		return package_info->load_status;
 	}
 
+	// remember where the package is found, so that it can be loaded again when its source code is changed
+	_package_modules[package_info] = imported_module;
+
 	// initialize the async data
 	if (data == nullptr)
 		data = new async_data(&_syntax_tree);
 	data->in.module = imported_module;
+	data->out.state.set_parallel_for(parallel_for());
+	data->out.state.set_declarations_only(true);
 	package_info->load_status = package_source_info::loading;
 	data->in.package_info = package_info;
+	data->in.use_cache = !_uncached.contains(package_info);
 	data->out.errors.clear();
 	data->out.package = nullptr;
+	data->out.cached = false;
+	data->out.key = 0;
+	data->out.entry_key = 0;
+	data->out.links.clear();
+	data->out.package_key = 0;
 
-	// put the data to be processed by one of the worker threads
-	_parse_requests.put(data);
+	// load and parse the package using one of the worker threads
 	_pending_requests++;
+	_scheduler.submit([responses = &_parse_responses, data, cache = &_cache]
+	{
+		responses->put(build::parse(data, cache));
+	});
 
 	// put the import as being imported in the future
 	imported_module->add_import_request(import_request);
 	return package_info->load_status;
 }
 
-async_data* build::parse(async_data* data)
+async_data* build::parse(async_data* data, build_cache* cache)
+{
+	try
+	{
+		// the cached package is used if the source files are unchanged since it was stored, in which case the
+		// source code is never loaded. The stamp is taken before the source code is loaded, so that a package is
+		// never stored with a stamp that's newer than its source code
+		const auto info = data->in.package_info;
+		std::uint64_t stamp;
+		if (cache->is_enabled() && data->in.module->get_package_sources_stamp(info, &stamp))
+		{
+			data->out.entry_key = build_cache::get_entry_key(stamp, info->name);
+			build_cache::cached_package cached{};
+			if (data->in.use_cache && cache->load_package(data->out.entry_key, info, &data->out.state, &cached))
+			{
+				data->out.package = cached.package;
+				data->out.links = std::move(cached.links);
+				data->out.key = cached.source_key;
+				data->out.package_key = cached.package_key;
+				data->out.cached = true;
+				return data;
+			}
+		}
+
+		// load the actual string source code and parse it
+		data->in.module->load_package_sources(info);
+		data->out.key = build_cache::get_package_key(info->sources, info->name);
+		data->out.package = parse_package_sources(info->sources, info->name, &data->out.state);
+	}
+	catch (const error& e)
+	{
+		std::stringstream ss;
+		e.print(ss);
+		data->out.errors.emplace_back(std::move(ss.str()));
+	}
+	catch (const std::exception& e)
+	{
+		data->out.errors.emplace_back(e.what());
+	}
+
+	return data;
+}
+
+bool build::resolve_packages()
+{
+	// sort the packages, so that the units in the graph and the errors are the same between builds. The packages
+	// that are resolved already are never resolved again
+	vector<node_package*> packages;
+	for (auto p: _unresolved)
+		packages.add(p);
+	_unresolved.clear();
+	std::sort(packages.begin(), packages.end(), [](node_package* lhs, node_package* rhs)
+	{
+		return lhs->get_id().str() < rhs->get_id().str();
+	});
+	const auto last = std::unique(packages.begin(), packages.end());
+	packages.resize((int)(last - packages.begin()));
+
+	const package_graph graph(packages);
+	const auto& units = graph.get_units();
+
+	// the packages loaded from the cache refer to the nodes in other packages by the id of the package
+	std::unordered_map<symbol_id, node_package*> ids;
+	if (!_unlinked.empty())
+	{
+		for (const auto& it: _package_infos)
+			ids[it.first->get_id()] = it.first;
+	}
+
+	// errors raised when resolving each unit. The errors are printed when all units are resolved
+	std::vector<std::vector<string>> errors(units.size());
+	// units that are not resolved, because they, or a unit they depend on, could not be loaded or resolved
+	std::vector<bool> skipped(units.size());
+	// the number of dependencies that are not resolved yet
+	std::vector<int> dependencies(units.size());
+	// units that can be resolved now
+	std::vector<int> ready;
+	for (int i = 0; i < (int)units.size(); ++i)
+	{
+		dependencies[i] = units[i].dependencies;
+		if (dependencies[i] == 0)
+			ready.push_back(i);
+	}
+
+	const auto done = [&](int idx)
+	{
+		const auto failed = skipped[idx] || !errors[idx].empty();
+		for (auto d: units[idx].dependents)
+		{
+			if (failed)
+				skipped[d] = true;
+			if (--dependencies[d] == 0)
+				ready.push_back(d);
+		}
+	};
+
+	int pending = 0;
+	while (true)
+	{
+		// resolve all units that have their dependencies resolved using the worker threads
+		while (!ready.empty())
+		{
+			const auto idx = ready.back();
+			ready.pop_back();
+			for (auto p: units[idx].packages)
+			{
+				if (p->has_pending_imports())
+					skipped[idx] = true;
+			}
+			if (skipped[idx])
+			{
+				done(idx);
+				continue;
+			}
+
+			// the packages loaded from the cache are resolved already, so they are only linked to the packages
+			// they import. A unit is never made of both cached and parsed packages
+			std::vector<array_view<package_interface_link>> links;
+			for (auto p: units[idx].packages)
+			{
+				const auto it = _unlinked.find(p);
+				if (it != _unlinked.end())
+					links.emplace_back(it->second.links);
+			}
+
+			pending++;
+			if (links.empty())
+			{
+				_scheduler.submit([responses = &_resolve_responses, unit = &units[idx], errors = &errors[idx], idx]
+				{
+					build::resolve(unit, errors);
+					responses->put(idx);
+				});
+			}
+			else
+			{
+				assert((int)links.size() == units[idx].packages.size());
+				_scheduler.submit([responses = &_resolve_responses, unit = &units[idx], links = std::move(links),
+						packages = &ids, errors = &errors[idx], idx]
+				{
+					build::link(unit, links, packages, errors);
+					responses->put(idx);
+				});
+			}
+		}
+
+		if (pending == 0)
+			break;
+		int idx;
+		if (!_resolve_responses.wait_pop(&idx))
+			return false;
+		pending--;
+		done(idx);
+	}
+
+	// the packages that are not linked are failed, and loaded again when watching for changes
+	_unlinked.clear();
+
+	bool success = true;
+	for (int i = 0; i < (int)units.size(); ++i)
+	{
+		for (const auto& e: errors[i])
+		{
+			*_config.err << e;
+			success = false;
+		}
+
+		// the packages that are not resolved are built again when watching for changes
+		if (skipped[i] || !errors[i].empty())
+		{
+			for (auto p: units[i].packages)
+			{
+				const auto it = _package_infos.find(p);
+				if (it != _package_infos.end())
+					_failed.insert(it->second);
+			}
+		}
+	}
+	return success;
+}
+
+void build::resolve(const package_graph::unit* unit, std::vector<string>* errors)
+{
+	// packages in the same unit import each other, so they are resolved one after another
+	for (auto p: unit->packages)
+	{
+		try
+		{
+			p->process_package_phases();
+		}
+		catch (const error& e)
+		{
+			std::stringstream ss;
+			e.print(ss);
+			errors->emplace_back(std::move(ss.str()));
+		}
+		catch (const std::exception& e)
+		{
+			errors->emplace_back(e.what());
+		}
+	}
+}
+
+void build::link(const package_graph::unit* unit, const std::vector<array_view<package_interface_link>>& links,
+		const std::unordered_map<symbol_id, node_package*>* packages, std::vector<string>* errors)
+{
+	const auto find_package = [packages](symbol_id id) -> node_package*
+	{
+		const auto it = packages->find(id);
+		return it != packages->end() ? it->second : nullptr;
+	};
+	for (int i = 0; i < (int)unit->packages.size(); ++i)
+	{
+		if (!link_package_interface(links[i], find_package))
+		{
+			string message(STR("could not link the cached package '"));
+			message += unit->packages[i]->get_id().str();
+			message += STR("'\n");
+			errors->emplace_back(std::move(message));
+		}
+	}
+}
+
+bool build::parse_imported_bodies()
+{
+	// the bodies of each package is parsed by one of the worker threads
+	const auto packages = std::move(_unparsed_bodies);
+	_unparsed_bodies.clear();
+	for (auto package: packages)
+	{
+		const auto data = new async_data(&_syntax_tree);
+		data->out.package = package;
+		_pending_requests++;
+		_scheduler.submit([responses = &_parse_responses, data]
+		{
+			responses->put(build::parse_bodies(data));
+		});
+	}
+
+	std::unordered_map<node_package*, async_data*> responses;
+	while (_parse_responses.is_open() && _pending_requests > 0)
+	{
+		async_data* data;
+		if (!_parse_responses.wait_pop(&data))
+			continue;
+		_pending_requests--;
+		responses[data->out.package] = data;
+	}
+
+	// resolve the bodies in the same order as the packages are imported, which makes the errors deterministic
+	bool success = true;
+	for (auto package: packages)
+	{
+		const auto it = responses.find(package);
+		if (it == responses.end())
+		{
+			_failed.insert(_package_infos[package]);
+			success = false;
+			continue;
+		}
+
+		const auto data = it->second;
+		if (data->out.errors.empty())
+		{
+			try
+			{
+				package->process_phases();
+			}
+			catch (const o2::error& e)
+			{
+				e.print(*_config.err);
+				_failed.insert(_package_infos[package]);
+				success = false;
+			}
+		}
+		else
+		{
+			for (const auto& e: data->out.errors)
+				*_config.err << e << std::endl;
+			_failed.insert(_package_infos[package]);
+			success = false;
+		}
+		delete data;
+	}
+	return success;
+}
+
+async_data* build::parse_bodies(async_data* data)
 {
 	try
 	{
-		// load the actual string source code
-		data->in.module->load_package_sources(data->in.package_info);
-		// parse the source code
-		data->out.package = parse_package_sources(data->in.package_info->sources,
-				data->in.package_info->name,
-				&data->out.state);
+		parse_deferred_func_bodies(data->out.package, &data->out.state);
 	}
 	catch (const error& e)
 	{
@@ -324,11 +916,28 @@ async_data* build::parse(async_data* data)
 	return data;
 }
 
+void build::evict_cache()
+{
+	if (!_cache.is_enabled())
+		return;
+
+	_cache.evict();
+	if (_config.verbose_level > 0)
+	{
+		const auto stats = _cache.get_statistics();
+		*_config.out << "cache '" << _config.cache_path.generic_string() << "' - " << stats.hits << " hits, "
+				  << stats.misses << " misses, " << stats.stores << " stored, " << stats.evictions << " evicted ("
+				  << stats.evicted_size << " bytes), " << stats.size << " bytes in total" << std::endl;
+	}
+	_cache.reset_statistics();
+}
+
 void build::abort()
 {
 	_aborted = true;
-	_parse_requests.close();
+	_scheduler.stop();
 	_parse_responses.close();
+	_resolve_responses.close();
 }
 
 int build::output_json()
@@ -340,7 +949,7 @@ int build::output_json()
 			json j(&s);
 			_syntax_tree.get_root_package()->write_json(j);
 		}
-		std::cout << s.str();
+		*_config.out << s.str();
 		return 0;
 	}
 	else
@@ -357,7 +966,7 @@ int build::output_json()
 		}
 		else
 		{
-			std::cerr << "could not write to '" << _config.output_destination << "'" << std::endl;
+			*_config.err << "could not write to '" << _config.output_destination << "'" << std::endl;
 			return 1;
 		}
 	}
@@ -10,12 +10,18 @@
 #include <vector>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <atomic>
 #include <filesystem>
+#include <ostream>
 
 #include "../channel.h"
+#include "../task_scheduler.h"
+#include "../build_cache.h"
+#include "../file_watcher.h"
 #include "../../parser/parser.h"
 #include "../../parser/module/module_package_lookup.h"
+#include "../../parser/package/package_graph.h"
 #include "base_command.h"
 
 namespace o2
@@ -32,6 +38,8 @@ namespace o2
 			module* module;
 			// information on the package sources to be loaded
 			package_source_info* package_info;
+			// true if the package can be loaded from the cache
+			bool use_cache;
 		} in;
 
 		// data coming out from the processor
@@ -43,11 +51,22 @@ namespace o2
 			std::vector<string> errors;
 			// the resulting package to be added to the syntax tree
 			node_package* package;
+			// true if the package is loaded from the cache instead of being parsed
+			bool cached;
+			// the key of the source code the package is loaded from
+			std::uint64_t key;
+			// the key of the entry, in the cache, of the package. Zero if the package can't be cached
+			std::uint64_t entry_key;
+			// the references to the nodes in other packages, if the package is loaded from the cache
+			vector<package_interface_link> links;
+			// the key of the package, which includes the keys of the packages it imports, when the package is
+			// stored in the cache. Only set if the package is loaded from the cache
+			std::uint64_t package_key;
 		} out;
 
 		explicit async_data(syntax_tree* st)
-				: in({ nullptr, nullptr }),
-				  out({ parser_state(st), {}, nullptr })
+				: in({ nullptr, nullptr, true }),
+				  out({ parser_state(st), {}, nullptr, false, 0, 0, {}, 0 })
 		{
 		}
 	};
@@ -74,12 +93,22 @@ namespace o2
 			std::filesystem::path lang_path;
 			// How much should the builder print out in the terminal
 			int verbose_level;
-			// number of threads that's allowed to work with the source code
+			// number of worker threads that's allowed to load and parse the source code
 			int threads_count;
 			// what are we outputting
 			build_config_output output_type;
 			// the destination where to put the result into
 			string_view output_destination;
+			// where the package interfaces of the imported packages are stored. Empty if they are always parsed
+			std::filesystem::path cache_path;
+			// the maximum size of the cache, in bytes
+			std::uintmax_t cache_size;
+			// build again when the source code is changed
+			bool watch;
+			// where the output of the build is written to
+			std::ostream* out;
+			// where the errors are written to
+			std::ostream* err;
 		};
 
 		explicit build(config cfg);
@@ -92,12 +121,89 @@ namespace o2
 		 */
 		int execute();
 
+		/**
+		 * \brief build the packages that are not loaded and output the result. All packages are built the first
+		 *        time, after that only the packages removed by invalidate are built again
+		 * \return the exit code
+		 */
+		int rebuild();
+
+		/**
+		 * \brief remove the packages with a changed key from the syntax tree. A key changes if the source code of
+		 *        the package, or of a package it imports, is changed. The removed packages are loaded again by the
+		 *        next rebuild
+		 * \param dirs the directories where the source code is changed, and the paths of the changed module files.
+		 *        A changed module file changes the key of all packages in its module
+		 * \return true if one or more packages are removed
+		 */
+		bool invalidate(const std::vector<std::filesystem::path>& dirs);
+
 		/**
 		 * \brief abort the execution if the build
 		 */
 		void abort() final;
 
 	private:
+		/**
+		 * \brief parse, resolve and optimize all packages that are not loaded
+		 * \return true if successful
+		 */
+		bool compile();
+
+		/**
+		 * \brief load the main package, if it's not loaded, and all packages it imports directly or indirectly
+		 * \return true if successful
+		 */
+		bool load_packages();
+
+		/**
+		 * \brief remove the packages loaded from the cache that are resolved using other imports than the ones
+		 *        that are loaded, and the packages that import them. The removed packages are loaded again from
+		 *        their source code by the next load
+		 * \return true if one or more packages are removed
+		 */
+		bool remove_outdated_packages();
+
+		/**
+		 * \brief store the packages that are parsed by this build in the cache
+		 */
+		void store_packages();
+
+		/**
+		 * \brief output the result of the build
+		 * \param success true if the build is successful
+		 * \param start when the build started
+		 * \return the exit code
+		 */
+		int output(bool success, unsigned long long start);
+
+		/**
+		 * \brief build again each time the source code is changed, until the build is aborted
+		 * \param exit_code the exit code of the first build
+		 * \return the exit code of the latest build
+		 */
+		int watch(int exit_code);
+
+		/**
+		 * \brief get the key of each package in the syntax tree. The key is based on the key of the source code of
+		 *        the package and the keys of all packages it imports
+		 * \param source_keys the key of the source code of each package
+		 * \return the keys
+		 */
+		[[nodiscard]] std::unordered_map<package_source_info*, std::uint64_t> get_package_keys(
+				const std::unordered_map<package_source_info*, std::uint64_t>& source_keys) const;
+
+		/**
+		 * \brief remove the supplied package from the syntax tree and delete it
+		 * \param p the package
+		 */
+		void remove_package(node_package* p);
+
+		/**
+		 * \return how the source code of a package is parsed in parallel by the worker threads
+		 */
+		parser_state::parallel_for parallel_for();
+
 		/**
 		 * \brief push more items to be built in worker threads
 		 * \param data asynchronous data that can be associated with this import
@@ -114,9 +220,54 @@ namespace o2
 		/**
 		 * \brief parse the source code associated with the compile state
 		 * \param data
+		 * \param cache the build cache. The package is read from the cache, if it's found in it, instead of
+		 *        being parsed
 		 * \return
 		 */
-		static async_data* parse(async_data* data);
+		static async_data* parse(async_data* data, build_cache* cache);
+
+		/**
+		 * \brief resolve all packages loaded since the last time packages were resolved. Packages are resolved by
+		 *        the worker threads as soon as all packages they import are resolved
+		 * \return true if successful
+		 */
+		bool resolve_packages();
+
+		/**
+		 * \brief resolve the packages in the supplied unit
+		 * \param unit the unit
+		 * \param errors where to put the errors raised when resolving
+		 */
+		static void resolve(const package_graph::unit* unit, std::vector<string>* errors);
+
+		/**
+		 * \brief link the packages in the supplied unit, which are loaded from the cache and resolved already
+		 * \param unit the unit
+		 * \param links the references to the nodes in other packages, of each package in the unit
+		 * \param packages the loaded packages, by their id
+		 * \param errors where to put the errors raised when linking
+		 */
+		static void link(const package_graph::unit* unit, const std::vector<array_view<package_interface_link>>& links,
+				const std::unordered_map<symbol_id, node_package*>* packages, std::vector<string>* errors);
+
+		/**
+		 * \brief parse and resolve the function bodies of all imported packages, which are skipped when the
+		 *        packages are parsed
+		 * \return true if successful
+		 */
+		bool parse_imported_bodies();
+
+		/**
+		 * \brief parse the skipped function bodies of the package associated with the compile state
+		 * \param data
+		 * \return
+		 */
+		static async_data* parse_bodies(async_data* data);
+
+		/**
+		 * \brief evict the least recently used entries from the build cache and print its statistics
+		 */
+		void evict_cache();
 
 		/**
 		 * \brief print out json output
@@ -129,16 +280,55 @@ namespace o2
 		syntax_tree _syntax_tree;
 
 		int _pending_requests;
-		channel<async_data*> _parse_requests;
 		channel<async_data*> _parse_responses;
-
-		// threads that are doing stuff
-		std::vector<std::jthread> _threads;
+		// the index of the units, in the package graph, that are resolved
+		channel<int> _resolve_responses;
 
 		system_modules _system_module;
 		module* _main_module;
+		// the name and the source code of the main package
+		string _main_package_name;
+		package_source_info* _main_package_info;
+		// packages that are loaded but not resolved yet. Packages that are kept between builds are never resolved again
+		std::vector<node_package*> _unresolved;
+		// imported packages with function bodies that are not parsed yet. They are parsed after all imports are done
+		std::vector<node_package*> _unparsed_bodies;
+		// packages that are not optimized yet
+		std::vector<node_package*> _unoptimized;
+		// the module where the source code of each package is found
+		std::unordered_map<package_source_info*, module*> _package_modules;
+		// the source code each package is loaded from
+		std::unordered_map<node_package*, package_source_info*> _package_infos;
+		// the packages that failed to load or resolve. They are always loaded again when watching for changes
+		std::unordered_set<package_source_info*> _failed;
+		// the key of the source code each package is loaded from
+		std::unordered_map<package_source_info*, std::uint64_t> _source_keys;
+		// the key of each package, which includes the keys of the packages it imports
+		std::unordered_map<package_source_info*, std::uint64_t> _package_keys;
+		// the key of the entry, in the cache, of each package. Zero if the package can't be cached
+		std::unordered_map<package_source_info*, std::uint64_t> _entry_keys;
+
+		// a package loaded from the cache that's not linked yet
+		struct unlinked_package
+		{
+			// the references to the nodes in other packages
+			vector<package_interface_link> links;
+			// the key of the package when it's stored, which tells which imports it's resolved with
+			std::uint64_t package_key;
+		};
+		std::unordered_map<node_package*, unlinked_package> _unlinked;
+		// imported packages that are parsed but not stored in the cache yet
+		std::vector<node_package*> _unstored;
+		// packages that are parsed even if they are found in the cache, since the cached package is outdated
+		std::unordered_set<package_source_info*> _uncached;
+
+		// the packages loaded from, and stored in, the cache
+		build_cache _cache;
 
 		// Is the build aborted?
 		std::atomic_bool _aborted;
+
+		// schedules the loading and parsing of packages. Destroyed first so that no worker outlives the build
+		task_scheduler _scheduler;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,383 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "serve.h"
+#include "../../parser/content_hash.h"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+
+#if !(defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__))
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+using namespace o2;
+
+namespace
+{
+	static inline unsigned long long now()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	/**
+	 * \brief get the absolute path of the supplied directory, which allows for two paths to be compared
+	 */
+	std::string normalize_path(const std::filesystem::path& path)
+	{
+		std::error_code ec;
+		auto result = std::filesystem::weakly_canonical(std::filesystem::absolute(path, ec), ec);
+		// "a/b/" and "a/b" are the same directory
+		if (!result.has_filename())
+			result = result.parent_path();
+		return result.generic_string();
+	}
+
+	bool is_source_file(const std::filesystem::path& path)
+	{
+		return path.extension() == ".o2" || path.filename() == "o2.mod";
+	}
+}
+
+serve::serve(config cfg)
+		: _config(std::move(cfg)), _rejected(), _running(), _aborted()
+{
+}
+
+void serve::abort()
+{
+	_aborted = true;
+	const auto b = _running.load();
+	if (b != nullptr)
+		b->abort();
+}
+
+const serve::response& serve::run(const std::vector<std::string>& args, bool* reused)
+{
+	*reused = false;
+	_rejected.exit_code = 1;
+	_rejected.out.clear();
+	_rejected.err.clear();
+	if (args[0] != "build")
+	{
+		_rejected.err = "'" + args[0] + "' can't be run by the server\n";
+		return _rejected;
+	}
+
+	build::config cfg;
+	std::ostringstream err;
+	if (!_config.parse_args(args, &cfg, err))
+	{
+		_rejected.err = err.str();
+		return _rejected;
+	}
+	if (cfg.watch)
+	{
+		_rejected.err = "-watch can't be run by the server\n";
+		return _rejected;
+	}
+
+	// the stamps are taken before the build is run, which means that a file changed while building is built
+	// again by the next request
+	auto stamps = get_sources_stamps();
+	auto& k = _builds[normalize_path(cfg.path)];
+	if (k == nullptr || k->b == nullptr || k->args != args)
+	{
+		// a build with other flags, such as the number of threads, is never reused
+		k = std::make_unique<kept_build>();
+		k->args = args;
+		cfg.out = &k->out;
+		cfg.err = &k->err;
+		k->b = std::make_unique<build>(cfg);
+	}
+	else
+	{
+		// the directories that are added, removed or changed since the previous build
+		std::vector<std::filesystem::path> dirs;
+		for (const auto& it: stamps)
+		{
+			const auto previous = k->stamps.find(it.first);
+			if (previous == k->stamps.end() || previous->second != it.second)
+				dirs.emplace_back(it.first);
+		}
+		for (const auto& it: k->stamps)
+		{
+			if (!stamps.contains(it.first))
+				dirs.emplace_back(it.first);
+		}
+
+		// the response is reused if no package is affected by the changes, such as when a file is only touched
+		*reused = dirs.empty() || !k->b->invalidate(dirs);
+	}
+
+	k->stamps = std::move(stamps);
+	if (!*reused)
+		rebuild(k.get());
+	return k->r;
+}
+
+void serve::rebuild(kept_build* k)
+{
+	k->out.str({});
+	k->err.str({});
+	_running = k->b.get();
+	try
+	{
+		k->r.exit_code = k->b->rebuild();
+	}
+	catch (const std::exception& e)
+	{
+		// it's not known which packages are built, so the build is created again by the next request
+		k->err << e.what() << std::endl;
+		k->r.exit_code = 1;
+		_running = nullptr;
+		k->b.reset();
+	}
+	_running = nullptr;
+	k->r.out = k->out.str();
+	k->r.err = k->err.str();
+}
+
+serve::sources_stamps serve::get_sources_stamps() const
+{
+	// the stamp of each file is added, which makes the stamp independent of the order the files are found in
+	sources_stamps stamps;
+	std::error_code ec;
+	for (const auto& source_path: _config.source_paths)
+	{
+		for (auto it = std::filesystem::recursive_directory_iterator(source_path, ec);
+			 !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+		{
+			const auto& path = it->path();
+			if (it->is_directory(ec))
+			{
+				// hidden directories, such as the build cache, never contain source code
+				if (path.filename().string().starts_with('.'))
+					it.disable_recursion_pending();
+				continue;
+			}
+			if (!is_source_file(path))
+				continue;
+
+			content_hash hash;
+			hash.add(string_view(path.generic_string()));
+			hash.add((std::uint64_t)it->file_size(ec));
+			hash.add((std::uint64_t)it->last_write_time(ec).time_since_epoch().count());
+			// the module file has a stamp of its own, since it affects all packages in the module
+			if (path.filename() == "o2.mod")
+				stamps[path.generic_string()] += hash.get();
+			else
+				stamps[path.parent_path().generic_string()] += hash.get();
+		}
+	}
+	return stamps;
+}
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+
+int serve::execute()
+{
+	std::cerr << "o2 serve is not supported on this platform" << std::endl;
+	return 1;
+}
+
+bool serve::forward(const std::filesystem::path& socket_path, const std::vector<std::string>& args,
+		int* exit_code)
+{
+	return false;
+}
+
+#else
+
+namespace
+{
+#if defined(MSG_NOSIGNAL)
+	// a client that disconnects must not kill the server
+	const int send_flags = MSG_NOSIGNAL;
+#else
+	const int send_flags = 0;
+#endif
+
+	/**
+	 * \brief create a local socket and the address of the supplied path
+	 * \return the socket; -1 if the socket could not be created
+	 */
+	int create_socket(const std::filesystem::path& path, sockaddr_un* address)
+	{
+		const auto name = path.string();
+		if (name.size() >= sizeof(address->sun_path))
+			return -1;
+
+		std::memset(address, 0, sizeof(sockaddr_un));
+		address->sun_family = AF_UNIX;
+		std::memcpy(address->sun_path, name.c_str(), name.size());
+		return socket(AF_UNIX, SOCK_STREAM, 0);
+	}
+
+	bool send_all(int fd, const char* data, std::size_t size)
+	{
+		while (size > 0)
+		{
+			const auto sent = send(fd, data, size, send_flags);
+			if (sent <= 0)
+				return false;
+			data += sent;
+			size -= sent;
+		}
+		return true;
+	}
+
+	/**
+	 * \brief receive everything until the other side stops sending
+	 */
+	bool receive_all(int fd, std::string* dest)
+	{
+		char buffer[4096];
+		while (true)
+		{
+			const auto received = recv(fd, buffer, sizeof(buffer), 0);
+			if (received < 0)
+				return false;
+			if (received == 0)
+				return true;
+			dest->append(buffer, received);
+		}
+	}
+}
+
+int serve::execute()
+{
+	std::error_code ec;
+	std::filesystem::create_directories(_config.socket_path.parent_path(), ec);
+
+	// a socket file is left behind if a server is killed. It's only removed if no server is listening on it
+	int exit_code;
+	if (forward(_config.socket_path, {}, &exit_code))
+	{
+		std::cerr << "a server is already running on '" << _config.socket_path.string() << "'" << std::endl;
+		return 1;
+	}
+	std::filesystem::remove(_config.socket_path, ec);
+
+	sockaddr_un address{};
+	const auto fd = create_socket(_config.socket_path, &address);
+	if (fd == -1)
+	{
+		std::cerr << "could not create the socket '" << _config.socket_path.string() << "'" << std::endl;
+		return 1;
+	}
+	if (bind(fd, (sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 16) != 0)
+	{
+		std::cerr << "could not listen on '" << _config.socket_path.string() << "'" << std::endl;
+		close(fd);
+		return 1;
+	}
+
+	if (_config.verbose_level > 0)
+		std::cout << "listening on '" << _config.socket_path.string() << "'" << std::endl;
+
+	// requests are handled one after another. The socket is polled, so that an abort is noticed even when no
+	// requests are sent
+	while (!_aborted)
+	{
+		pollfd p{ fd, POLLIN, 0 };
+		if (poll(&p, 1, 200) <= 0)
+			continue;
+
+		const auto client = accept(fd, nullptr, nullptr);
+		if (client == -1)
+			continue;
+
+		std::string request;
+		if (!receive_all(client, &request))
+		{
+			close(client);
+			continue;
+		}
+
+		// the request is the arguments, each one followed by a zero
+		std::vector<std::string> args;
+		for (std::size_t start = 0, end; (end = request.find('\0', start)) != std::string::npos; start = end + 1)
+			args.emplace_back(request, start, end - start);
+
+		// an empty request is sent to check if the server is running
+		if (args.empty())
+		{
+			close(client);
+			continue;
+		}
+
+		const auto start = now();
+		bool reused;
+		const auto& r = run(args, &reused);
+		const auto header = std::to_string(r.exit_code) + " " + std::to_string(r.out.size()) + " " +
+							std::to_string(r.err.size()) + "\n";
+		if (send_all(client, header.data(), header.size()) && send_all(client, r.out.data(), r.out.size()))
+			send_all(client, r.err.data(), r.err.size());
+		close(client);
+
+		if (_config.verbose_level > 0)
+		{
+			std::cout << (reused ? "reused '" : "ran '") << args[0] << "' - " << (now() - start)
+					  << " milliseconds" << std::endl;
+		}
+	}
+
+	close(fd);
+	std::filesystem::remove(_config.socket_path, ec);
+	return 0;
+}
+
+bool serve::forward(const std::filesystem::path& socket_path, const std::vector<std::string>& args,
+		int* exit_code)
+{
+	sockaddr_un address{};
+	const auto fd = create_socket(socket_path, &address);
+	if (fd == -1)
+		return false;
+	if (connect(fd, (sockaddr*)&address, sizeof(address)) != 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	std::string request;
+	for (const auto& a: args)
+	{
+		request += a;
+		request += '\0';
+	}
+	std::string response;
+	const auto success = send_all(fd, request.data(), request.size()) && shutdown(fd, SHUT_WR) == 0 &&
+						 receive_all(fd, &response);
+	close(fd);
+	if (args.empty())
+		return success;
+
+	// the response starts with a header followed by the standard output and error of the command. The command
+	// might be run by the server even if the connection is lost, so it's not run again here
+	const auto header_end = response.find('\n');
+	std::size_t out_size, err_size;
+	if (!success || header_end == std::string::npos ||
+		std::sscanf(response.c_str(), "%d %zu %zu", exit_code, &out_size, &err_size) != 3 ||
+		header_end + 1 + out_size + err_size != response.size())
+	{
+		std::cerr << "lost the connection to the server on '" << socket_path.string() << "'" << std::endl;
+		*exit_code = 1;
+		return true;
+	}
+
+	std::cout.write(response.data() + header_end + 1, (std::streamsize)out_size);
+	std::cout.flush();
+	std::cerr.write(response.data() + header_end + 1 + out_size, (std::streamsize)err_size);
+	return true;
+}
+
+#endif
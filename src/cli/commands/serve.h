@@ -0,0 +1,138 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base_command.h"
+#include "build.h"
+
+namespace o2
+{
+	/**
+	 * \brief the serve command
+	 *
+	 * A long-running server that listens on a local socket and runs the build commands forwarded to it by other
+	 * o2 processes. The server keeps one build for each root path, together with a stamp of each directory with
+	 * source files. When the same build is requested again, the directories with a changed stamp are invalidated
+	 * in the build, which means that only the packages affected by the change are built again. If nothing is
+	 * changed, then the output of the previous build is sent back
+	 */
+	class serve final
+			: public base_command
+	{
+	public:
+		/**
+		 * \brief parses the arguments of a build command, which start with the name of the command
+		 */
+		typedef std::function<bool(const std::vector<std::string>& args, build::config* cfg,
+				std::ostream& err)> parse_build_args;
+
+		struct config
+		{
+			// the local socket where the server listens for requests
+			std::filesystem::path socket_path;
+			// the directories where the source code is found. Requests are invalidated when a file in them is changed
+			std::vector<std::filesystem::path> source_paths;
+			// parses the arguments of the requested builds
+			parse_build_args parse_args;
+			// How much should the server print out in the terminal
+			int verbose_level;
+		};
+
+		explicit serve(config cfg);
+
+		/**
+		 * \brief execute the serve command. Returns when the server is aborted
+		 * \return
+		 */
+		int execute();
+
+		/**
+		 * \brief abort the server
+		 */
+		void abort() final;
+
+		/**
+		 * \brief forward a command to the server listening on the supplied socket, if one is running
+		 * \param socket_path the local socket
+		 * \param args the arguments, starting with the name of the command
+		 * \param exit_code the exit code of the command
+		 * \return true if the command is run by the server; false if no server is running
+		 */
+		static bool forward(const std::filesystem::path& socket_path, const std::vector<std::string>& args,
+				int* exit_code);
+
+	private:
+		/**
+		 * \brief the stamp of each directory with source files, and of each module file
+		 */
+		typedef std::unordered_map<std::string, std::uint64_t> sources_stamps;
+
+		struct response
+		{
+			int exit_code;
+			std::string out;
+			std::string err;
+		};
+
+		/**
+		 * \brief a build that's kept between requests
+		 */
+		struct kept_build
+		{
+			// the arguments the build is created with
+			std::vector<std::string> args;
+			// the stamps of the source files when the build was run
+			sources_stamps stamps;
+			// where the build writes its output and errors to
+			std::ostringstream out;
+			std::ostringstream err;
+			std::unique_ptr<build> b;
+			// the response of the latest build
+			response r;
+		};
+
+		/**
+		 * \brief run the supplied command, or reuse its response if no source file is changed since it was run
+		 * \param args the arguments, starting with the name of the command
+		 * \param reused set to true if the response is reused
+		 * \return the response
+		 */
+		const response& run(const std::vector<std::string>& args, bool* reused);
+
+		/**
+		 * \brief build the packages that are not loaded by the supplied build and remember its output
+		 * \param k the build
+		 */
+		void rebuild(kept_build* k);
+
+		/**
+		 * \return a stamp for each directory and module file, based on the path, size and modification time of
+		 *         the files
+		 */
+		[[nodiscard]] sources_stamps get_sources_stamps() const;
+
+	private:
+		const config _config;
+		// the builds, by their root path
+		std::unordered_map<std::string, std::unique_ptr<kept_build>> _builds;
+		// the response to a request that's not a build
+		response _rejected;
+		// the build that's running. It's aborted together with the server
+		std::atomic<build*> _running;
+		// Is the server aborted?
+		std::atomic_bool _aborted;
+	};
+}
@@ -0,0 +1,189 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "file_watcher.h"
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+using namespace o2;
+
+namespace
+{
+	// how long to wait, in milliseconds, between checking if the watch is aborted
+	constexpr int abort_interval = 200;
+
+	// how long to wait, in milliseconds, for more changes before the changes are reported
+	constexpr int settle_interval = 50;
+
+	bool is_hidden(const std::filesystem::path& path)
+	{
+		const auto name = path.filename().string();
+		return !name.empty() && name[0] == '.' && name != "." && name != "..";
+	}
+
+	bool is_source_file(const std::filesystem::path& path)
+	{
+		return path.extension() == ".o2";
+	}
+
+	bool is_module_file(const std::filesystem::path& path)
+	{
+		return path.filename() == "o2.mod";
+	}
+
+	void add_unique(std::vector<std::filesystem::path>* dest, const std::filesystem::path& path)
+	{
+		if (std::find(dest->begin(), dest->end(), path) == dest->end())
+			dest->push_back(path);
+	}
+}
+
+#if defined(__linux__)
+
+file_watcher::file_watcher(const std::vector<std::filesystem::path>& paths)
+		: _fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+	if (_fd == -1)
+		return;
+	for (const auto& p: paths)
+		add(p);
+}
+
+file_watcher::~file_watcher()
+{
+	if (_fd != -1)
+		close(_fd);
+}
+
+bool file_watcher::wait(const std::atomic_bool& aborted, std::vector<std::filesystem::path>* dest)
+{
+	if (_fd == -1)
+		return false;
+
+	bool changed = false;
+	while (!aborted)
+	{
+		pollfd p{ _fd, POLLIN, 0 };
+		const auto ready = poll(&p, 1, changed ? settle_interval : abort_interval);
+		if (ready > 0)
+		{
+			if (read_events(dest))
+				changed = true;
+		}
+		else if (changed)
+			return true;
+	}
+	return false;
+}
+
+void file_watcher::add(const std::filesystem::path& path)
+{
+	const auto mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF |
+					  IN_ONLYDIR;
+	const auto wd = inotify_add_watch(_fd, path.c_str(), mask);
+	if (wd == -1)
+		return;
+	_watches[wd] = path;
+
+	std::error_code ec;
+	for (auto it = std::filesystem::directory_iterator(path, ec);
+		 !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+	{
+		if (it->is_directory(ec) && !is_hidden(it->path()))
+			add(it->path());
+	}
+}
+
+bool file_watcher::read_events(std::vector<std::filesystem::path>* dest)
+{
+	bool changed = false;
+	alignas(inotify_event) char buffer[16 * 1024];
+	while (true)
+	{
+		const auto size = read(_fd, buffer, sizeof(buffer));
+		if (size <= 0)
+			break;
+
+		for (auto pos = buffer; pos < buffer + size;)
+		{
+			const auto e = (const inotify_event*)pos;
+			pos += sizeof(inotify_event) + e->len;
+
+			const auto it = _watches.find(e->wd);
+			if (it == _watches.end())
+				continue;
+			if (e->mask & IN_IGNORED)
+			{
+				_watches.erase(it);
+				continue;
+			}
+
+			const auto dir = it->second;
+			if (e->mask & IN_DELETE_SELF)
+			{
+				add_unique(dest, dir);
+				changed = true;
+				continue;
+			}
+			if (e->len == 0)
+				continue;
+
+			const auto path = dir / e->name;
+			if (e->mask & IN_ISDIR)
+			{
+				if (is_hidden(path))
+					continue;
+				// a new directory might be a new package, or contain the source code of a package that failed to
+				// load because its directory was missing
+				if (e->mask & (IN_CREATE | IN_MOVED_TO))
+					add(path);
+				add_unique(dest, path);
+				changed = true;
+			}
+			else if (is_source_file(path))
+			{
+				add_unique(dest, dir);
+				changed = true;
+			}
+			else if (is_module_file(path))
+			{
+				// the module file affects all packages in the module, and not only the package in its directory
+				add_unique(dest, path);
+				changed = true;
+			}
+		}
+	}
+	return changed;
+}
+
+#else
+
+file_watcher::file_watcher(const std::vector<std::filesystem::path>& paths)
+		: _fd(-1)
+{
+}
+
+file_watcher::~file_watcher() = default;
+
+bool file_watcher::wait(const std::atomic_bool& aborted, std::vector<std::filesystem::path>* dest)
+{
+	return false;
+}
+
+void file_watcher::add(const std::filesystem::path& path)
+{
+}
+
+bool file_watcher::read_events(std::vector<std::filesystem::path>* dest)
+{
+	return false;
+}
+
+#endif
@@ -0,0 +1,72 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+namespace o2
+{
+	/**
+	 * \brief watches directories, and all directories inside them, for changes to source code files and module files
+	 *
+	 * Hidden directories, such as the build cache, are not watched. Directories that are created while watching
+	 * are watched as soon as they are found
+	 */
+	class file_watcher
+	{
+	public:
+		/**
+		 * \param paths the directories to watch
+		 */
+		explicit file_watcher(const std::vector<std::filesystem::path>& paths);
+
+		file_watcher(const file_watcher&) = delete;
+
+		file_watcher& operator=(const file_watcher&) = delete;
+
+		~file_watcher();
+
+		/**
+		 * \return true if the directories can be watched on this platform
+		 */
+		[[nodiscard]] bool is_supported() const
+		{
+			return _fd != -1;
+		}
+
+		/**
+		 * \brief wait until one or more source code files, or module files, are added, changed or removed
+		 * \param aborted stop waiting when this is set
+		 * \param dest where the directories that contain the changed source code files, and the paths of the
+		 *        changed module files, are put
+		 * \return true if one or more files are changed; false if aborted
+		 *
+		 * The changes are collected until no more changes are made for a short while, which means that saving
+		 * more than one file at once is reported once
+		 */
+		bool wait(const std::atomic_bool& aborted, std::vector<std::filesystem::path>* dest);
+
+	private:
+		/**
+		 * \brief start watching the supplied directory and all directories inside it
+		 */
+		void add(const std::filesystem::path& path);
+
+		/**
+		 * \brief read all events that are ready
+		 * \return true if a source code file or a module file is changed
+		 */
+		bool read_events(std::vector<std::filesystem::path>* dest);
+
+	private:
+		int _fd;
+		// the directory of each watch
+		std::unordered_map<int, std::filesystem::path> _watches;
+	};
+}
@@ -8,8 +8,10 @@
 #include <fstream>
 #include <chrono>
 #include <csignal>
+#include <cstdlib>
 
 #include "commands/build.h"
+#include "commands/serve.h"
 
 using namespace std;
 using namespace o2;
@@ -27,12 +29,136 @@ bool module_exists()
 
 base_command* bcommand = nullptr;
 
+// where a running "o2 serve" listens for commands
+const std::filesystem::path serve_socket_path(".o2/serve.sock");
+
 void abort_command(int sig)
 {
 	if (bcommand)
 		bcommand->abort();
 }
 
+/**
+ * \brief parse the arguments of the build command
+ * \param args the arguments, starting with the name of the command
+ * \param cfg where to put the configuration of the build
+ * \param local set to true if the build must be run in this process, even if a server is running
+ * \param err where to write the errors to
+ * \return true if successful
+ */
+bool parse_build_args(const std::vector<std::string>& args, build::config* cfg, bool* local, std::ostream& err)
+{
+	int threads_count = task_scheduler::default_threads_count();
+	std::filesystem::path cache_path(".o2/cache");
+	std::uintmax_t cache_size_mb = 512;
+	bool watch = false;
+	string_view root_path;
+	*local = false;
+	for (std::size_t i = 1; i < args.size(); ++i)
+	{
+		const string_view arg(args[i]);
+		if (arg == "-j")
+		{
+			if (i + 1 >= args.size() || (threads_count = atoi(args[i + 1].c_str())) < 1)
+			{
+				err << "-j expects a positive number of threads" << endl;
+				return false;
+			}
+			i++;
+		}
+		else if (arg == "-cache")
+		{
+			if (i + 1 >= args.size() || args[i + 1].empty())
+			{
+				err << "-cache expects a directory" << endl;
+				return false;
+			}
+			cache_path = args[++i];
+		}
+		else if (arg == "-nocache")
+			cache_path.clear();
+		else if (arg == "-cachesize")
+		{
+			if (i + 1 >= args.size() || atoi(args[i + 1].c_str()) < 1)
+			{
+				err << "-cachesize expects a positive number of megabytes" << endl;
+				return false;
+			}
+			cache_size_mb = atoi(args[++i].c_str());
+		}
+		else if (arg == "-local")
+			*local = true;
+		else if (arg == "-watch")
+			watch = true;
+		else if (arg.starts_with('-'))
+		{
+			// a misspelled flag must not be mistaken for the main source code path
+			err << "unknown flag '" << arg << "'" << endl;
+			return false;
+		}
+		else
+			root_path = arg;
+	}
+
+	if (root_path.empty())
+	{
+		err << "no main source code path supplied" << endl;
+		return false;
+	}
+
+	// TODO: add support for compiler flags, such as:
+	// -o destination
+	// -t json|binary|debug|library
+
+	*cfg = build::config{
+			std::filesystem::path(root_path),
+			std::filesystem::path("../lang"),
+			1,
+			threads_count,
+			build_config_output::debug,
+			"",
+			cache_path,
+			cache_size_mb * 1024 * 1024,
+			watch,
+			&cout,
+			&cerr
+	};
+	return true;
+}
+
+/**
+ * \brief run the build command
+ * \param args the arguments, starting with the name of the command
+ * \return the exit code
+ */
+int build_command(const std::vector<std::string>& args)
+{
+	build::config cfg;
+	bool local;
+	if (!parse_build_args(args, &cfg, &local, cerr))
+		return 1;
+
+	if (!module_exists())
+	{
+		cerr << "no o2.mod found" << endl;
+		return 1;
+	}
+
+	// let the server build, if one is running, which reuses the result of the earlier builds
+	int exit_code;
+	if (!local && !cfg.watch && serve::forward(serve_socket_path, args, &exit_code))
+		return exit_code;
+
+	// the source code is kept while the files are edited, and a memory mapped file that's truncated by an editor
+	// crashes the build
+	if (cfg.watch)
+		source_code::set_memory_mapping(false);
+
+	o2::build b(cfg);
+	bcommand = &b;
+	return b.execute();
+}
+
 int main(int argc, char** argv)
 {
 	if (argc < 2)
@@ -44,6 +170,7 @@ int main(int argc, char** argv)
 		cout << "\tbuild\t\tcompile packages and dependencies" << endl;
 		cout << "\tinit\t\tinitialize a new project" << endl;
 		cout << "\tparse\t\tparse source code into a code completion database" << endl;
+		cout << "\tserve\t\trun a server that builds the source code for other o2 commands" << endl;
 		cout << "\ttest\t\ttest packages" << endl;
 		return 0;
 	}
@@ -52,6 +179,7 @@ int main(int argc, char** argv)
 	static const o2::string_view BUILD(STR("build"));
 	static const o2::string_view INIT(STR("init"));
 	static const o2::string_view PARSE(STR("parse"));
+	static const o2::string_view SERVE(STR("serve"));
 	static const o2::string_view TEST(STR("test"));
 
 	signal(SIGINT, abort_command);
@@ -62,31 +190,47 @@ int main(int argc, char** argv)
 		{
 			cout << "o2 build provides functionality compile o2 source code" << endl << endl;
 			cout << "usage: " << endl << endl;
-			cout << "\to2 build <main source code path>" << endl << endl;
+			cout << "\to2 build [-j N] [-cache DIR | -nocache] [-cachesize MB] [-local] [-watch] "
+					"<main source code path>" << endl << endl;
+			cout << "The flags are:" << endl << endl;
+			cout << "\t-j N\t\tnumber of threads used when building. Defaults to the number of cores" << endl;
+			cout << "\t-cache DIR\twhere the parsed imported packages are cached. Defaults to .o2/cache" << endl;
+			cout << "\t-nocache\talways parse the imported packages" << endl;
+			cout << "\t-cachesize MB\tthe maximum size of the cache. The least recently used packages are removed "
+					"when it's larger. Defaults to 512" << endl;
+			cout << "\t-local\t\tbuild in this process, even if a server is running" << endl;
+			cout << "\t-watch\t\tbuild again each time the source code is changed, until aborted" << endl;
 			return 0;
 		}
 
+		std::vector<std::string> args;
+		for (int i = 1; i < argc; ++i)
+			args.emplace_back(argv[i]);
+		return build_command(args);
+	}
+	else if (command == SERVE)
+	{
 		if (!module_exists())
 		{
 			cerr << "no o2.mod found" << endl;
 			return 1;
 		}
 
-		// TODO: add support for compiler flags, such as:
-		// -o destination
-		// -t json|binary|debug|library
-
-		const string_view root_path(argv[2]);
-		o2::build b(build::config{
-				std::filesystem::path(root_path),
-				std::filesystem::path("../lang"),
-				1,
-				5,
-				build_config_output::debug,
-				""
+		// the server keeps the source code while the files are edited
+		source_code::set_memory_mapping(false);
+
+		serve s(serve::config{
+				serve_socket_path,
+				{ std::filesystem::path("."), std::filesystem::path("../lang") },
+				[](const std::vector<std::string>& args, build::config* cfg, std::ostream& err)
+				{
+					bool local;
+					return parse_build_args(args, cfg, &local, err);
+				},
+				1
 		});
-		bcommand = &b;
-		return b.execute();
+		bcommand = &s;
+		return s.execute();
 	}
 	else if (command == PARSE)
 	{
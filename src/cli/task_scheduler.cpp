@@ -0,0 +1,195 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "task_scheduler.h"
+#include <algorithm>
+
+using namespace o2;
+
+namespace
+{
+	// the scheduler and worker index that the current thread belongs to
+	thread_local const task_scheduler* current_scheduler = nullptr;
+	thread_local int current_worker = -1;
+}
+
+task_scheduler::task_scheduler(int threads_count)
+		: _queued(0), _next_worker(0), _stopped(false)
+{
+	if (threads_count < 1)
+		threads_count = 1;
+
+	_workers.reserve(threads_count);
+	for (int i = 0; i < threads_count; ++i)
+		_workers.emplace_back(std::make_unique<worker>());
+
+	_threads.reserve(threads_count);
+	for (int i = 0; i < threads_count; ++i)
+	{
+		_threads.emplace_back([this, i]
+		{
+			run(i);
+		});
+	}
+}
+
+task_scheduler::~task_scheduler()
+{
+	stop();
+	for (auto& t: _threads)
+		t.join();
+}
+
+void task_scheduler::submit(task t)
+{
+	if (_stopped)
+		return;
+
+	// tasks spawned by a worker are put in that worker's own deque
+	int index;
+	if (current_scheduler == this)
+		index = current_worker;
+	else
+		index = (int)(_next_worker.fetch_add(1, std::memory_order_relaxed) % _workers.size());
+
+	{
+		auto& w = *_workers[index];
+		std::lock_guard l(w.mutex);
+		w.tasks.push_back(std::move(t));
+	}
+
+	// take the idle lock so that a worker that's about to go to sleep doesn't miss the notification
+	{
+		std::lock_guard l(_idle_mutex);
+		_queued++;
+	}
+	_idle.notify_one();
+}
+
+void task_scheduler::parallel_for(int count, const std::function<void(int)>& body)
+{
+	struct shared_state
+	{
+		const std::function<void(int)>* body;
+		int count;
+		// the next index to be processed
+		std::atomic_int next;
+		// the number of processed indices
+		int done;
+		std::mutex mutex;
+		std::condition_variable all_done;
+
+		void work()
+		{
+			int processed = 0;
+			for (int i = next++; i < count; i = next++)
+			{
+				(*body)(i);
+				processed++;
+			}
+			if (processed == 0)
+				return;
+
+			std::lock_guard l(mutex);
+			done += processed;
+			if (done == count)
+				all_done.notify_all();
+		}
+	};
+
+	// the helpers might be started after this function has returned, which is why the state is shared with them
+	const auto state = std::make_shared<shared_state>();
+	state->body = &body;
+	state->count = count;
+	state->next = 0;
+	state->done = 0;
+
+	const auto helpers = std::min(count, get_threads_count()) - 1;
+	for (int i = 0; i < helpers; ++i)
+	{
+		submit([state]
+		{
+			state->work();
+		});
+	}
+
+	// all indices are taken when the calling thread stops working, which means that it only waits for the
+	// helpers that are already running
+	state->work();
+	std::unique_lock l(state->mutex);
+	state->all_done.wait(l, [&state]
+	{
+		return state->done == state->count;
+	});
+}
+
+void task_scheduler::stop()
+{
+	{
+		std::lock_guard l(_idle_mutex);
+		_stopped = true;
+	}
+	_idle.notify_all();
+}
+
+int task_scheduler::default_threads_count()
+{
+	const auto count = (int)std::thread::hardware_concurrency();
+	if (count < 1)
+		return 1;
+	return count;
+}
+
+void task_scheduler::run(int index)
+{
+	current_scheduler = this;
+	current_worker = index;
+
+	// tasks that are still queued when the scheduler is stopped are discarded
+	while (!_stopped)
+	{
+		task t;
+		if (pop(index, &t) || steal(index, &t))
+		{
+			_queued--;
+			t();
+			continue;
+		}
+
+		// no work is available, so go to sleep until new work arrives
+		std::unique_lock l(_idle_mutex);
+		_idle.wait(l, [this]
+		{
+			return _queued > 0 || _stopped;
+		});
+	}
+}
+
+bool task_scheduler::pop(int index, task* t)
+{
+	auto& w = *_workers[index];
+	std::lock_guard l(w.mutex);
+	if (w.tasks.empty())
+		return false;
+	*t = std::move(w.tasks.back());
+	w.tasks.pop_back();
+	return true;
+}
+
+bool task_scheduler::steal(int index, task* t)
+{
+	const auto count = (int)_workers.size();
+	for (int i = 1; i < count; ++i)
+	{
+		auto& w = *_workers[(index + i) % count];
+		std::unique_lock l(w.mutex, std::try_to_lock);
+		if (!l.owns_lock() || w.tasks.empty())
+			continue;
+		*t = std::move(w.tasks.front());
+		w.tasks.pop_front();
+		return true;
+	}
+	return false;
+}
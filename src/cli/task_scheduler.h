@@ -0,0 +1,111 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+
+namespace o2
+{
+	/**
+	 * \brief a work-stealing task scheduler
+	 *
+	 * Each worker owns a deque of tasks. A worker pushes and pops tasks at the back of its own deque, which means
+	 * that the most recently spawned (and cache-hot) task is processed first. Workers without any work steal
+	 * the oldest task from the front of another worker's deque. Tasks submitted from outside of the scheduler are
+	 * distributed over the workers in a round-robin fashion.
+	 */
+	class task_scheduler
+	{
+	public:
+		typedef std::function<void()> task;
+
+		/**
+		 * \param threads_count the number of worker threads
+		 */
+		explicit task_scheduler(int threads_count);
+
+		~task_scheduler();
+
+		/**
+		 * \brief submit a new task to be processed by one of the workers
+		 * \param t the task
+		 */
+		void submit(task t);
+
+		/**
+		 * \brief run the supplied body once for each index from 0 to count, using the workers. The calling thread
+		 *        processes the indices as well, and returns when all of them are processed
+		 * \param count the number of indices
+		 * \param body the function called for each index. It's not allowed to raise any exceptions
+		 * \remark this is safe to call from one of the workers, because the calling thread never waits for a task
+		 *         that's not started yet
+		 */
+		void parallel_for(int count, const std::function<void(int)>& body);
+
+		/**
+		 * \brief stop all workers. Tasks that are running are completed, but tasks that have not been started yet
+		 *        are discarded
+		 */
+		void stop();
+
+		/**
+		 * \return the number of worker threads
+		 */
+		[[nodiscard]] int get_threads_count() const
+		{
+			return (int)_workers.size();
+		}
+
+		/**
+		 * \return the number of threads used by default, which is the hardware concurrency of this machine
+		 */
+		static int default_threads_count();
+
+	private:
+		struct worker
+		{
+			std::mutex mutex;
+			std::deque<task> tasks;
+		};
+
+		/**
+		 * \brief the main loop for a worker thread
+		 * \param index the worker index
+		 */
+		void run(int index);
+
+		/**
+		 * \brief try to pop a task from the back of the supplied worker's deque
+		 */
+		bool pop(int index, task* t);
+
+		/**
+		 * \brief try to steal a task from the front of any other worker's deque
+		 */
+		bool steal(int index, task* t);
+
+	private:
+		std::vector<std::unique_ptr<worker>> _workers;
+		std::vector<std::jthread> _threads;
+
+		// number of tasks that are queued and not yet picked up by a worker
+		std::atomic_int _queued;
+		// used for round-robin distribution of external tasks
+		std::atomic_uint _next_worker;
+		std::atomic_bool _stopped;
+
+		// used to put idle workers to sleep
+		std::mutex _idle_mutex;
+		std::condition_variable _idle;
+	};
+}
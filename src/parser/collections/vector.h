@@ -6,7 +6,9 @@
 #pragma once
 
 #include <cassert>
+#include <cstring>
 #include <memory>
+#include <type_traits>
 
 namespace o2
 {
@@ -18,13 +20,19 @@ namespace o2
 	* 
 	* It essentially solves the same problem as the standard std::vector, but it has a 
 	* array_view
+	*
+	* The first Inline items are stored inside the vector itself, so small vectors (which most
+	* nodes children are) never allocate any memory. Once the inline storage is exhausted then
+	* the vector moves its items to the heap and grows its capacity geometrically
 	**/
-	template<typename T, int Resize = 4>
+	template<typename T, int Inline = 4>
 	class vector
 	{
+		static_assert(Inline > 0, "a vector must have at least one inline item");
+
 	public:
 		vector()
-				: _capacity(0), _memory(nullptr), _size(0)
+				: _capacity(Inline), _memory(_Inline()), _size(0)
 		{
 		}
 
@@ -32,53 +40,47 @@ namespace o2
 		 * \brief copy constructor
 		 * \param rhs
 		 */
-		vector(const vector<T, Resize>& rhs)
-				: _capacity{ rhs._size }, _memory((T*)malloc(sizeof(T) * _capacity)), _size{ rhs._size }
+		vector(const vector<T, Inline>& rhs)
+				: vector()
 		{
-			for (auto i = 0; i < _size; ++i)
-				_memory[i] = rhs._memory[i];
+			_Assign(rhs._memory, rhs._size);
 		}
 
 		/**
 		 * \brief move constructor
 		 * \param source
 		 */
-		vector(vector<T, Resize>&& source) noexcept
-				: _capacity{ source._capacity }, _memory{ source._memory }, _size{ source._size }
+		vector(vector<T, Inline>&& source) noexcept
+				: vector()
 		{
-			source._capacity = 0;
-			source._memory = nullptr;
-			source._size = 0;
+			_Steal(source);
 		}
 
 		explicit vector(int initialSize)
-				: _capacity(initialSize), _memory((T*)malloc(sizeof(T) * _capacity)), _size(initialSize)
+				: vector()
 		{
-			assert(_memory != nullptr);
+			resize(initialSize);
 		}
 
 		template<typename ...Args>
 		vector(Args... args)
-				: _capacity(sizeof...(Args)), _memory((T*)malloc(sizeof(T) * _capacity)), _size(_capacity)
+				: vector()
 		{
-			_Varset(0, args...);
+			_Reserve(sizeof...(Args));
+			_Varset(args...);
 		}
 
 		vector(std::initializer_list<T> ii)
-				: _capacity((int)ii.size()), _memory((T*)malloc(sizeof(T) * _capacity)), _size(_capacity)
+				: vector()
 		{
-			T* ptr = _memory;
-			for (auto i: ii)
-				*ptr++ = i;
+			_Assign(ii.begin(), (int)ii.size());
 		}
 
 		~vector()
 		{
-			if (_memory)
-			{
+			_Destroy(0, _size);
+			if (!_IsInline())
 				free(_memory);
-				_memory = nullptr;
-			}
 		}
 
 		/**
@@ -97,6 +99,14 @@ namespace o2
 			return _size == 0;
 		}
 
+		/**
+		 * \return the number of items this vector can hold without having to allocate more memory
+		 */
+		int capacity() const
+		{
+			return _capacity;
+		}
+
 		/**
 		 * \brief add a new item to this vector
 		 * \param value the item we want to add
@@ -107,8 +117,9 @@ namespace o2
 				assert(value != nullptr);
 			// Resize if necessary
 			if (_size == _capacity)
-				_Resize();
-			_memory[_size++] = value;
+				_Reserve(_size + 1);
+			new(&_memory[_size]) T(std::move(value));
+			_size++;
 		}
 
 		/**
@@ -118,7 +129,7 @@ namespace o2
 		void add_unique(T value)
 		{
 			if (find(value) == -1)
-				add(value);
+				add(std::move(value));
 		}
 
 		/**
@@ -128,8 +139,8 @@ namespace o2
 		 */
 		void put(T value, int idx)
 		{
-			assert(_capacity < idx);
-			_memory[idx] = value;
+			assert(idx < _size);
+			_memory[idx] = std::move(value);
 		}
 
 		/**
@@ -143,11 +154,12 @@ namespace o2
 			assert(_size > idx);
 
 			// Move all items backwards one step
-			T removed = _memory[idx];
+			T removed = std::move(_memory[idx]);
 			for (int i = idx + 1; i < _size; ++i)
 			{
-				_memory[i - 1] = _memory[i];
+				_memory[i - 1] = std::move(_memory[i]);
 			}
+			_Destroy(_size - 1, _size);
 			_size--;
 			return removed;
 		}
@@ -169,7 +181,7 @@ namespace o2
 		 * \param value the value we are searching for
 		 * \return an index. Returns -1 if no item was found
 		 */
-		int find(T value)
+		int find(const T& value) const
 		{
 			for (int i = 0; i < _size; ++i)
 				if (value == _memory[i])
@@ -193,22 +205,31 @@ namespace o2
 				add(arr);
 			else
 			{
+				const int count = arr.size();
 				// Resize the memory block so that we can fit all items
-				if (_size + arr.size() > _capacity)
-					_Resize(_size + arr.size() + Resize);
-				_size += arr.size();
+				_Reserve(_size + count);
 
-				// Move forward items from the back towards the front
-				const T* src = &_memory[_size - arr.size() - 1];
-				T * dest = &_memory[_size - 1];
-				const T* end = &_memory[index + arr.size() - 1];
-				for (; dest != end; --src, --dest)
-					*dest = *src;
+				// Move forward items from the back towards the front. Items that end up outside
+				// the current size are constructed and the rest are assigned
+				for (int i = _size - 1; i >= index; --i)
+				{
+					const int dest = i + count;
+					if (dest >= _size)
+						new(&_memory[dest]) T(std::move(_memory[i]));
+					else
+						_memory[dest] = std::move(_memory[i]);
+				}
 
 				// Copy data from the source array into the destination
-				const int size = arr.size();
-				for (int i = 0; i < size; ++i)
-					_memory[i + index] = arr[i];
+				for (int i = 0; i < count; ++i)
+				{
+					const int dest = i + index;
+					if (dest >= _size)
+						new(&_memory[dest]) T(arr[i]);
+					else
+						_memory[dest] = arr[i];
+				}
+				_size += count;
 			}
 			return arr.size();
 		}
@@ -219,19 +240,21 @@ namespace o2
 		 */
 		void add(array_view<T> arr)
 		{
+			_Reserve(_size + arr.size());
 			for (auto a: arr)
 				add(a);
 		}
 
 		/**
 		 * \brief clear this array.
-		 * \param resize set to true if you also want to resize the memory array
+		 * \param resize set to true if you also want to release the heap memory held by this vector
 		 */
 		void clear(bool resize = false)
 		{
-			assert(resize == false &&
-				   "resize feature is not implemented yet");
+			_Destroy(0, _size);
 			_size = 0;
+			if (resize)
+				_Release();
 		}
 
 		/**
@@ -242,15 +265,30 @@ namespace o2
 		{
 			if (_size < new_size)
 			{
-				_Resize(new_size);
+				_Reserve(new_size);
+				if constexpr (!std::is_trivially_default_constructible<T>())
+				{
+					for (int i = _size; i < new_size; ++i)
+						new(&_memory[i]) T();
+				}
 				_size = new_size;
 			}
 			else
 			{
+				_Destroy(new_size, _size);
 				_size = new_size;
 			}
 		}
 
+		/**
+		 * \brief make sure that this vector can hold at least the supplied number of items
+		 * \param count the number of items
+		 */
+		void reserve(int count)
+		{
+			_Reserve(count);
+		}
+
 		T* ptr()
 		{
 			return _memory;
@@ -277,21 +315,12 @@ namespace o2
 		 * \param rhs
 		 * \return
 		 */
-		vector<T, Resize>& operator=(vector<T, Resize>&& rhs) noexcept
+		vector<T, Inline>& operator=(vector<T, Inline>&& rhs) noexcept
 		{
-			if (_memory == rhs._memory)
+			if (this == &rhs)
 				return *this;
-			if (_memory)
-			{
-				free(_memory);
-				_memory = nullptr;
-			}
-			_size = rhs._size;
-			_capacity = rhs._capacity;
-			_memory = rhs._memory;
-			rhs._capacity = 0;
-			rhs._size = 0;
-			rhs._memory = nullptr;
+			clear(true);
+			_Steal(rhs);
 			return *this;
 		}
 
@@ -300,20 +329,12 @@ namespace o2
 		 * \param rhs
 		 * \return a reference to this vector
 		 */
-		vector<T, Resize>& operator=(const vector<T, Resize>& rhs)
+		vector<T, Inline>& operator=(const vector<T, Inline>& rhs)
 		{
-			if (_memory == rhs._memory)
+			if (this == &rhs)
 				return *this;
-			if (_memory)
-			{
-				free(_memory);
-				_memory = nullptr;
-			}
-			_size = rhs._size;
-			_capacity = _size;
-			_memory = (T*)malloc(sizeof(T) * _capacity);
-			for (int i = 0; i < _size; ++i)
-				_memory[i] = rhs._memory[i];
+			clear();
+			_Assign(rhs._memory, rhs._size);
 			return *this;
 		}
 
@@ -322,7 +343,7 @@ namespace o2
 		 * \param rhs
 		 * \return
 		 */
-		vector<T, Resize>& operator=(const array_view<T>& rhs);
+		vector<T, Inline>& operator=(const array_view<T>& rhs);
 
 		typedef T* iterator;
 		typedef const T* const_iterator;
@@ -348,39 +369,161 @@ namespace o2
 		}
 
 	private:
-		void _Varset(int index, T first)
+		void _Varset(T first)
 		{
-			_memory[index] = first;
+			new(&_memory[_size++]) T(std::move(first));
 		}
 
 		template<typename ...Args>
-		void _Varset(int index, T first, Args... args)
+		void _Varset(T first, Args... args)
 		{
-			_memory[index] = first;
-			_Varset(index + 1, args...);
+			new(&_memory[_size++]) T(std::move(first));
+			_Varset(args...);
+		}
+
+		T* _Inline()
+		{
+			return reinterpret_cast<T*>(_inline);
+		}
+
+		[[nodiscard]] bool _IsInline() const
+		{
+			return _memory == reinterpret_cast<const T*>(_inline);
+		}
+
+		/**
+		 * \brief copy the supplied items into this empty vector
+		 */
+		void _Assign(const T* memory, int count)
+		{
+			assert(_size == 0);
+			_Reserve(count);
+			if constexpr (std::is_trivially_copyable<T>())
+			{
+				if (count > 0)
+					memcpy(_memory, memory, sizeof(T) * count);
+			}
+			else
+			{
+				for (int i = 0; i < count; ++i)
+					new(&_memory[i]) T(memory[i]);
+			}
+			_size = count;
 		}
 
-		void _Resize()
+		/**
+		 * \brief take ownership of the supplied vector's items. The heap memory is taken over as-is while
+		 *        inline items are moved one by one
+		 */
+		void _Steal(vector<T, Inline>& source)
 		{
-			_Resize(Resize);
+			assert(_size == 0 && _IsInline());
+			if (source._IsInline())
+			{
+				_Relocate(_memory, source._memory, source._size);
+			}
+			else
+			{
+				_memory = source._memory;
+				_capacity = source._capacity;
+				source._memory = source._Inline();
+				source._capacity = Inline;
+			}
+			_size = source._size;
+			source._size = 0;
 		}
 
-		void _Resize(int minCount)
+		/**
+		 * \brief move the supplied items into uninitialized memory and destroy the source items
+		 */
+		static void _Relocate(T* dest, T* source, int count)
 		{
-			_capacity += minCount;
-			if (_memory == nullptr)
-				_memory = static_cast<T*>(malloc(sizeof(T) * _capacity));
+			if constexpr (std::is_trivially_copyable<T>())
+			{
+				if (count > 0)
+					memcpy(dest, source, sizeof(T) * count);
+			}
 			else
 			{
-				auto newMemory = static_cast<T*>(realloc(_memory, sizeof(T) * _capacity));
-				assert(newMemory);
-				_memory = newMemory;
+				for (int i = 0; i < count; ++i)
+				{
+					new(&dest[i]) T(std::move(source[i]));
+					source[i].~T();
+				}
+			}
+		}
+
+		/**
+		 * \brief destroy all items in the range [from, to)
+		 */
+		void _Destroy(int from, int to)
+		{
+			if constexpr (!std::is_trivially_destructible<T>())
+			{
+				for (int i = from; i < to; ++i)
+					_memory[i].~T();
 			}
 		}
 
+		/**
+		 * \brief release the heap memory, if any, and move the items back into the inline storage if they fit
+		 */
+		void _Release()
+		{
+			if (_IsInline() || _size > Inline)
+				return;
+			T* const memory = _memory;
+			_Relocate(_Inline(), memory, _size);
+			free(memory);
+			_memory = _Inline();
+			_capacity = Inline;
+		}
+
+		/**
+		 * \brief grow the capacity so that at least minCount items fit. The capacity grows geometrically
+		 *        so that adding items one by one has an amortized constant cost
+		 */
+		void _Reserve(int minCount)
+		{
+			if (minCount <= _capacity)
+				return;
+			int capacity = _capacity * 2;
+			if (capacity < minCount)
+				capacity = minCount;
+
+			T* memory;
+			if constexpr (std::is_trivially_copyable<T>())
+			{
+				// trivial types can be moved by the allocator itself
+				if (_IsInline())
+				{
+					memory = static_cast<T*>(malloc(sizeof(T) * capacity));
+					assert(memory);
+					if (_size > 0)
+						memcpy(memory, _memory, sizeof(T) * _size);
+				}
+				else
+				{
+					memory = static_cast<T*>(realloc(_memory, sizeof(T) * capacity));
+					assert(memory);
+				}
+			}
+			else
+			{
+				memory = static_cast<T*>(malloc(sizeof(T) * capacity));
+				assert(memory);
+				_Relocate(memory, _memory, _size);
+				if (!_IsInline())
+					free(_memory);
+			}
+			_memory = memory;
+			_capacity = capacity;
+		}
+
 		int _capacity;
 		T* _memory;
 		int _size;
+		alignas(T) unsigned char _inline[sizeof(T) * Inline];
 	};
 
 	/**
@@ -500,8 +643,8 @@ namespace o2
 		{
 		}
 
-		template<class Class, int Resize>
-		array_view(const vector<Class, Resize>& v)
+		template<class Class, int Inline>
+		array_view(const vector<Class, Inline>& v)
 				: _memory(get_memory(v)), _size(get_size(v))
 		{
 		}
@@ -512,8 +655,8 @@ namespace o2
 		{
 		}
 
-		template<int Resize>
-		array_view(const vector<T, Resize>& rhs)
+		template<int Inline>
+		array_view(const vector<T, Inline>& rhs)
 				: _memory(get_memory(rhs)), _size(get_size(rhs))
 		{
 		}
@@ -560,8 +703,8 @@ namespace o2
 		}
 
 	private:
-		template<class Class, int Resize>
-		static int get_size(const vector<Class, Resize>& v)
+		template<class Class, int Inline>
+		static int get_size(const vector<Class, Inline>& v)
 		{
 			using namespace std;
 			if constexpr (is_pointer<Class>())
@@ -577,21 +720,21 @@ namespace o2
 			}
 		}
 
-		template<class Class, int Resize>
-		static T* get_memory(const vector<Class, Resize>& v)
+		template<class Class, int Inline>
+		static T* get_memory(const vector<Class, Inline>& v)
 		{
 			using namespace std;
 			if constexpr (is_pointer<Class>())
 			{
 				if constexpr (is_base_of<typename remove_pointer<T>::type, typename remove_pointer<Class>::type>())
 				{
-					Class* memory = const_cast<vector<Class, Resize>&>(v).ptr();
+					Class* memory = const_cast<vector<Class, Inline>&>(v).ptr();
 					return reinterpret_cast<T*>(memory);
 				}
 			}
 			else
 			{
-				return const_cast<vector<Class, Resize>&>(v).ptr();
+				return const_cast<vector<Class, Inline>&>(v).ptr();
 			}
 		}
 
@@ -678,22 +821,13 @@ namespace o2
 		}
 	};
 
-	template<typename T, int Resize>
-	vector<T, Resize>& vector<T, Resize>::operator=(const array_view<T>& rhs)
+	template<typename T, int Inline>
+	vector<T, Inline>& vector<T, Inline>::operator=(const array_view<T>& rhs)
 	{
 		if (_memory == rhs.ptr())
 			return *this;
-		if (_memory)
-		{
-			free(_memory);
-			_memory = nullptr;
-		}
-		_size = rhs.size();
-		_capacity = _size;
-		_memory = static_cast<T*>(malloc(sizeof(T) * _capacity));
-		auto memory = rhs.ptr();
-		for (int i = 0; i < _size; ++i)
-			_memory[i] = memory[i];
+		clear();
+		_Assign(rhs.ptr(), rhs.size());
 		return *this;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "content_hash.h"
+#include <cstring>
+
+using namespace o2;
+
+namespace
+{
+	// the primes used by xxHash64
+	constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ull;
+	constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+	constexpr std::uint64_t prime3 = 0x165667B19E3779F9ull;
+	constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ull;
+	constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ull;
+
+	constexpr std::uint64_t rotl(std::uint64_t value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	inline std::uint64_t mix(std::uint64_t state, std::uint64_t input)
+	{
+		return rotl(state ^ rotl(input * prime2, 31) * prime1, 27) * prime1 + prime4;
+	}
+}
+
+content_hash::content_hash()
+		: _state(prime5), _length()
+{
+}
+
+content_hash& content_hash::add(string_view data)
+{
+	const auto bytes = reinterpret_cast<const unsigned char*>(data.data());
+	const auto size = data.size() * sizeof(string_literal);
+
+	std::size_t i = 0;
+	for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+	{
+		std::uint64_t chunk;
+		std::memcpy(&chunk, bytes + i, sizeof(chunk));
+		_state = mix(_state, chunk);
+	}
+
+	// the last bytes are mixed one at a time
+	for (; i < size; ++i)
+		_state = rotl(_state ^ bytes[i] * prime5, 11) * prime1;
+
+	// the length is part of the hash, which makes "ab" + "c" and "a" + "bc" different
+	_length += size;
+	_state = mix(_state, size);
+	return *this;
+}
+
+content_hash& content_hash::add(std::uint64_t value)
+{
+	_length += sizeof(value);
+	_state = mix(_state, value);
+	return *this;
+}
+
+std::uint64_t content_hash::get() const
+{
+	auto h = _state + _length * prime5;
+	h ^= h >> 33;
+	h *= prime2;
+	h ^= h >> 29;
+	h *= prime3;
+	h ^= h >> 32;
+	return h;
+}
@@ -0,0 +1,47 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include "strings.h"
+#include <cstdint>
+
+namespace o2
+{
+	/**
+	 * \brief a fast, non-cryptographic 64 bit hash of content, such as source code
+	 *
+	 * The hash is the same between runs, which means that it can be used as a key for content that's stored
+	 * on disk
+	 */
+	class content_hash
+	{
+	public:
+		content_hash();
+
+		/**
+		 * \brief add the supplied bytes to the hash
+		 * \param data the bytes
+		 * \return this hash
+		 */
+		content_hash& add(string_view data);
+
+		/**
+		 * \brief add the supplied value to the hash
+		 * \param value the value
+		 * \return this hash
+		 */
+		content_hash& add(std::uint64_t value);
+
+		/**
+		 * \return the hash of all content added so far
+		 */
+		[[nodiscard]] std::uint64_t get() const;
+
+	private:
+		std::uint64_t _state;
+		std::uint64_t _length;
+	};
+}
@@ -13,49 +13,24 @@ using namespace o2;
 
 void error::print(basic_ostream& stream) const
 {
-	auto src = _view.get_source_code();
+	const auto src = _view.get_source_code();
+	const auto line = _view.get_line();
+	const auto text = src->get_line_text(line);
 
-	stream << "Failed to compile " << src->get_filename() << ": " << std::endl;
-
-	auto text = src->get_text();
-	const string_literal* s = text.data();
-	const string_literal* end = s + text.length();
-	int line = 0;
-	for (; s != end; ++s)
-	{
-		stream << *s;
-		if (*s == '\n')
-		{
-			if ((++line) == _view.get_line() + 1)
-			{
-				for (int i = 0; i < _view.get_line_offset() - 1; ++i)
-				{
-					if (_view.get_line_start()[i] == '\t')
-						stream << '\t';
-					else
-						stream << ' ';
-				}
-				stream << "^ " << std::setfill(STR('0')) << std::setw(6) << (int)_type;
-				stream << " " << what() << std::endl;
-			}
-		}
-	}
-	if ((++line) == _view.get_line() + 1)
+	stream << "Failed to compile " << src->get_filename() << ":" << (line + 1) << ": " << std::endl;
+	stream << text << std::endl;
+	for (int i = 0; i < _view.get_line_offset() - 1 && i < (int)text.length(); ++i)
 	{
-		stream << std::endl;
-		for (int i = 0; i < _view.get_line_offset() - 1; ++i)
-		{
-			if (_view.get_line_start()[i] == '\t')
-				stream << '\t';
-			else
-				stream << ' ';
-		}
-		stream << "^ " << std::setfill(STR('0')) << std::setw(6) << (int)_type;
-		stream << " " << what() << std::endl;
+		if (text[i] == '\t')
+			stream << '\t';
+		else
+			stream << ' ';
 	}
+	stream << "^ " << std::setfill(STR('0')) << std::setw(6) << (int)_type;
+	stream << " " << what() << std::endl;
 }
 
-error_syntax_error::error_syntax_error(source_code_view view, const token* t, const char* prefix)
+error_syntax_error::error_syntax_error(source_code_view view, const token_cursor* t, const char* prefix)
 		: parse_error(error_types::syntax_error, view)
 {
 	stringstream s;
@@ -67,7 +42,7 @@ error_syntax_error::error_syntax_error(source_code_view view, const token* t, co
 	set(std::move(s.str()));
 }
 
-error_not_implemented::error_not_implemented(source_code_view view, const token* t)
+error_not_implemented::error_not_implemented(source_code_view view, const token_cursor* t)
 		: parse_error(error_types::not_implemented, view)
 {
 	stringstream s;
@@ -83,7 +58,7 @@ error_not_implemented::error_not_implemented(source_code_view view, const char*
 	set(std::move(s.str()));
 }
 
-error_expected_identity::error_expected_identity(source_code_view view, const token* t)
+error_expected_identity::error_expected_identity(source_code_view view, const token_cursor* t)
 		: parse_error(error_types::expected_identity, view)
 {
 	stringstream s;
@@ -95,7 +70,7 @@ error_expected_identity::error_expected_identity(source_code_view view, const to
 	set(std::move(s.str()));
 }
 
-error_expected_constant::error_expected_constant(source_code_view view, const token* t)
+error_expected_constant::error_expected_constant(source_code_view view, const token_cursor* t)
 		: parse_error(error_types::expected_constant, view)
 {
 	stringstream s;
@@ -107,6 +82,14 @@ error_expected_constant::error_expected_constant(source_code_view view, const to
 	set(std::move(s.str()));
 }
 
+error_constant_out_of_range::error_constant_out_of_range(source_code_view view, const token_cursor* t)
+		: parse_error(error_types::constant_out_of_range, view)
+{
+	stringstream s;
+	s << "constant '" << t->value() << "' is out of range";
+	set(std::move(s.str()));
+}
+
 error_unexpected_extern_func_body::error_unexpected_extern_func_body(const source_code_view& view)
 		: parse_error(error_types::unexpected_extern_func_body, view)
 {
@@ -151,23 +134,23 @@ resolve_error_recursion::resolve_error_recursion(source_code_view view, const no
 	{
 		stringstream recursion;
 
-		auto symbol = dynamic_cast<const node_symbol*>(n);
+		const auto symbol = n->as<node_symbol>();
 		if (symbol)
 		{
-			auto id = static_cast<const node_symbol*>(n)->get_id();
+			auto id = symbol->get_id().str();
 			for (auto c = id.rbegin(); c != id.rend(); ++c)
 				recursion << *c;
 			recursion << ">-";
 		}
 
-		auto id = static_cast<const node_symbol*>(rd->n)->get_id();
+		auto id = static_cast<const node_symbol*>(rd->n)->get_id().str();
 		for (auto c = id.rbegin(); c != id.rend(); ++c)
 			recursion << *c;
 		rd = rd->next_of_type<node_symbol>();
 		while (rd)
 		{
 			recursion << ">-";
-			id = static_cast<const node_symbol*>(rd->n)->get_id();
+			id = static_cast<const node_symbol*>(rd->n)->get_id().str();
 			for (auto c = id.rbegin(); c != id.rend(); ++c)
 				recursion << *c;
 			if (rd->n == n)
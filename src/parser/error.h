@@ -9,7 +9,7 @@
 #include <sstream>
 #include <string_view>
 #include <string>
-#include "token.h"
+#include "token_buffer.h"
 #include "source_code_view.h"
 
 namespace o2
@@ -25,6 +25,7 @@ namespace o2
 		syntax_error,
 		incompatible_types,
 		named_symbol_already_declared,
+		constant_out_of_range,
 
 		structure_errors_start,
 		expected_child_node,
@@ -129,14 +130,14 @@ namespace o2
 			: public parse_error
 	{
 	public:
-		error_syntax_error(source_code_view view, const token* t, const char* prefix);
+		error_syntax_error(source_code_view view, const token_cursor* t, const char* prefix);
 	};
 
 	class error_not_implemented
 			: public parse_error
 	{
 	public:
-		error_not_implemented(source_code_view view, const token* t);
+		error_not_implemented(source_code_view view, const token_cursor* t);
 
 		error_not_implemented(source_code_view view, const char* extra);
 	};
@@ -145,14 +146,21 @@ namespace o2
 			: public parse_error
 	{
 	public:
-		error_expected_identity(source_code_view view, const token* t);
+		error_expected_identity(source_code_view view, const token_cursor* t);
 	};
 
 	class error_expected_constant
 			: public parse_error
 	{
 	public:
-		error_expected_constant(source_code_view view, const token* t);
+		error_expected_constant(source_code_view view, const token_cursor* t);
+	};
+
+	class error_constant_out_of_range
+			: public parse_error
+	{
+	public:
+		error_constant_out_of_range(source_code_view view, const token_cursor* t);
 	};
 
 	class error_unexpected_extern_func_body
@@ -309,6 +317,8 @@ namespace std
 			return os << "incompatible_types";
 		case o2::error_types::named_symbol_already_declared:
 			return os << "named_symbol_already_declared";
+		case o2::error_types::constant_out_of_range:
+			return os << "constant_out_of_range";
 		case o2::error_types::recursion:
 			return os << "recursion";
 		case o2::error_types::unresolved_reference:
@@ -11,27 +11,29 @@ using namespace o2;
 
 node* node_func::on_child_added(node* n)
 {
-	const auto arguments = dynamic_cast<node_func_parameters*>(n);
+	const auto arguments = n->as<node_func_parameters>();
 	if (arguments)
 		_parameters = arguments;
 	else
 	{
-		const auto returns = dynamic_cast<node_func_returns*>(n);
+		const auto returns = n->as<node_func_returns>();
 		if (returns)
 			_returns = returns;
 		else
 		{
-			const auto body = dynamic_cast<node_func_body*>(n);
+			const auto body = n->as<node_func_body>();
 			if (body)
 				_body = body;
 		}
 	}
+	_symbols.add(n, get_children());
 	return node_symbol::on_child_added(n);
 }
 
 void node_func::on_child_removed(node* n)
 {
 	node_symbol::on_child_removed(n);
+	_symbols.remove(n);
 	if (_parameters == n)
 		_parameters = nullptr;
 	else if (_returns == n)
@@ -79,13 +81,13 @@ void node_func::write_json_properties(json& j)
 	}
 }
 
-string node_func::get_id() const
+string node_func::build_id() const
 {
 	stringstream ss;
 	const auto symbol = get_parent_of_type<node_symbol>();
-	string id;
+	string_view id;
 	if (symbol)
-		id = symbol->get_id();
+		id = symbol->get_id().str();
 	ss << id;
 	if (!id.ends_with('/'))
 		ss << '/';
@@ -109,7 +111,7 @@ string node_func::get_id() const
 		const auto children = _returns->get_children();
 		for (int i = 0; i < children.size(); ++i)
 		{
-			const auto type = dynamic_cast<node_type*>(children[i]);
+			const auto type = children[i]->as<node_type>();
 			if (i > 0)
 				ss << ',';
 			ss << type->get_id();
@@ -121,7 +123,7 @@ string node_func::get_id() const
 
 bool node_func::superficial_test_symbol_collision(const node_func* rhs) const
 {
-	if (get_name() != rhs->get_name())
+	if (get_name_id() != rhs->get_name_id())
 		return false;
 
 	const auto has_parameters1 = _parameters != nullptr;
@@ -145,7 +147,7 @@ bool node_func::superficial_test_symbol_collision(const node_func* rhs) const
 
 void node_func::deep_test_symbol_collision(const node_func* rhs) const
 {
-	if (get_name() != rhs->get_name())
+	if (get_name_id() != rhs->get_name_id())
 		return;
 
 	const auto has_parameters1 = _parameters != nullptr;
@@ -161,8 +163,8 @@ void node_func::deep_test_symbol_collision(const node_func* rhs) const
 	// compare each argument
 	for (int i = 0; i < num_children1; ++i)
 	{
-		const auto arg1 = dynamic_cast<node_var*>(_parameters->get_child(i));
-		const auto arg2 = dynamic_cast<node_var*>(rhs->_parameters->get_child(i));
+		const auto arg1 = _parameters->get_child(i)->as<node_var>();
+		const auto arg2 = rhs->_parameters->get_child(i)->as<node_var>();
 		const auto type1 = arg1->get_type();
 		const auto type2 = arg2->get_type();
 		if (type1->get_type()->is_compatible_with(type2->get_type()) != compatibility::identical)
@@ -10,6 +10,7 @@
 #include "node_func_parameters.h"
 #include "node_func_returns.h"
 #include "../node_attribute.h"
+#include "../symbol_table.h"
 
 namespace o2
 {
@@ -32,9 +33,10 @@ namespace o2
 		 * \param view information of the source code
 		 * \param name the name of the function
 		 */
-		node_func(const source_code_view& view, string_view name)
+		node_func(const source_code_view& view, symbol_id name)
 				: node_symbol(view), _name(name), _body(), _parameters(), _returns(), _modifiers()
 		{
+			set_kind(node_kind::func);
 		}
 
 		struct inner_function
@@ -46,9 +48,10 @@ namespace o2
 		 * \param view information of the source code
 		 * \param name the name of the function
 		 */
-		node_func(const source_code_view& view, string_view name, inner_function)
+		node_func(const source_code_view& view, symbol_id name, inner_function)
 				: node_symbol(view), _name(name), _body(), _parameters(), _returns(), _modifiers()
 		{
+			set_kind(node_kind::func);
 			set_query_access_flags(query_access_modifier_no_siblings);
 		}
 
@@ -61,9 +64,10 @@ namespace o2
 		 * \param view information of the source code
 		 * \param name the name of the function
 		 */
-		node_func(const source_code_view& view, string_view name, static_function)
+		node_func(const source_code_view& view, symbol_id name, static_function)
 				: node_symbol(view), _name(name), _body(), _parameters(), _returns(), _modifiers()
 		{
+			set_kind(node_kind::func);
 			set_query_access_flags(query_access_modifier_no_siblings);
 		}
 
@@ -76,9 +80,10 @@ namespace o2
 		 * \param view information of the source code
 		 * \param name the name of the function
 		 */
-		node_func(const source_code_view& view, string_view name, const_function)
+		node_func(const source_code_view& view, symbol_id name, const_function)
 				: node_symbol(view), _name(name), _body(), _parameters(), _returns(), _modifiers(modifier_const)
 		{
+			set_kind(node_kind::func);
 			set_query_access_flags(query_access_modifier_no_siblings);
 		}
 
@@ -91,15 +96,24 @@ namespace o2
 		 * \param view information of the source code
 		 * \param name the name of the function
 		 */
-		node_func(const source_code_view& view, string_view name, extern_function)
+		node_func(const source_code_view& view, symbol_id name, extern_function)
 				: node_symbol(view), _name(name), _body(), _parameters(), _returns(), _modifiers(modifier_extern)
 		{
+			set_kind(node_kind::func);
 		}
 
 		/**
 		 * \return the name of the function
 		 */
 		[[nodiscard]] string_view get_name() const
+		{
+			return _name.str();
+		}
+
+		/**
+		 * \return the interned name of the function
+		 */
+		[[nodiscard]] symbol_id get_name_id() const
 		{
 			return _name;
 		}
@@ -160,12 +174,22 @@ namespace o2
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const override;
+		[[nodiscard]] string build_id() const override;
 
 #pragma endregion
 
 #pragma region node
 
+		void get_symbol_names(vector<symbol_id>* dest) const final
+		{
+			dest->add(_name);
+		}
+
+		[[nodiscard]] const symbol_table* get_symbol_table() const final
+		{
+			return &_symbols;
+		}
+
 		void debug(debug_ostream& stream, int indent) const override;
 
 		void write_json_properties(json& j) override;
@@ -190,10 +214,11 @@ namespace o2
 #pragma endregion
 
 	private:
-		string_view _name;
+		symbol_id _name;
 		node_func_body* _body;
 		node_func_parameters* _parameters;
 		node_func_returns* _returns;
 		int _modifiers;
+		symbol_table _symbols;
 	};
 }
@@ -11,20 +11,23 @@ using namespace o2;
 void node_func_body::debug(debug_ostream& stream, int indent) const
 {
 	stream << this << in(indent);
-	stream << "func_body(def=" << _def << ")" << std::endl;
+	stream << "func_body(def=" << _def;
+	if (is_deferred())
+		stream << ", deferred=true";
+	stream << ")" << std::endl;
 	node::debug(stream, indent);
 }
 
 void node_func_body::on_parent_node(node* n)
 {
-	const auto func = dynamic_cast<node_func*>(n);
+	const auto func = n->as<node_func>();
 	if (func)
 		_def = func;
 }
 
 void node_func_body::on_removed_parent_node(node* n)
 {
-	const auto func = dynamic_cast<node_func*>(n);
+	const auto func = n->as<node_func>();
 	if (func)
 		_def = nullptr;
 }
@@ -19,8 +19,9 @@ namespace o2
 	{
 	public:
 		explicit node_func_body(const source_code_view& view)
-				: node(view), _def()
+				: node(view), _def(), _deferred_end()
 		{
+			set_kind(node_kind::func_body);
 		}
 
 		// \brief get the definition that refers to this body
@@ -29,6 +30,30 @@ namespace o2
 			return _def;
 		}
 
+		/**
+		 * \return true if the body is skipped while parsing and is not parsed yet
+		 */
+		[[nodiscard]] bool is_deferred() const
+		{
+			return _deferred_end > 0;
+		}
+
+		/**
+		 * \return the offset of the first character after the closing bracket of a body that's not parsed yet
+		 */
+		[[nodiscard]] int get_deferred_end() const
+		{
+			return _deferred_end;
+		}
+
+		/**
+		 * \param end the offset of the first character after the closing bracket. 0 if the body is parsed
+		 */
+		void set_deferred_end(int end)
+		{
+			_deferred_end = end;
+		}
+
 #pragma region node
 
 		void on_parent_node(node* n) final;
@@ -41,5 +66,6 @@ namespace o2
 
 	private:
 		node_func* _def;
+		int _deferred_end;
 	};
 }
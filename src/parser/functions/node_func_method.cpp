@@ -14,7 +14,7 @@ void node_func_method::debug(debug_ostream& stream, int indent) const
 	node::debug(stream, indent);
 }
 
-string node_func_method::get_id() const
+string node_func_method::build_id() const
 {
 	stringstream ss;
 	const auto symbol = get_parent_of_type<node_symbol>();
@@ -40,7 +40,7 @@ string node_func_method::get_id() const
 		const auto children = get_returns()->get_children();
 		for (int i = 0; i < children.size(); ++i)
 		{
-			const auto type = dynamic_cast<node_type*>(children[i]);
+			const auto type = children[i]->as<node_type>();
 			if (i > 0)
 				ss << ',';
 			ss << type->get_id();
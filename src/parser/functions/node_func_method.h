@@ -18,9 +18,10 @@ namespace o2
 			: public node_func
 	{
 	public:
-		node_func_method(const source_code_view& view, string_view name)
+		node_func_method(const source_code_view& view, symbol_id name)
 				: node_func(view, name), _this()
 		{
+			set_kind(node_kind::func_method);
 		}
 
 		node_var_this* get_this() const
@@ -31,7 +32,7 @@ namespace o2
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const override;
+		[[nodiscard]] string build_id() const override;
 
 #pragma endregion
 
@@ -10,6 +10,7 @@ using namespace o2;
 node_func_parameters::node_func_parameters(const source_code_view& view)
 		: node(view)
 {
+	set_kind(node_kind::func_parameters);
 	set_query_access_flags(query_access_modifier_passthrough);
 }
 
@@ -27,7 +28,7 @@ int node_func_parameters::num_arguments() const
 
 node* node_func_parameters::on_child_added(node* n)
 {
-	const auto named = dynamic_cast<node_var*>(n);
+	const auto named = n->as<node_var>();
 	if (named)
 		_arguments.add(named);
 	return n;
@@ -35,7 +36,7 @@ node* node_func_parameters::on_child_added(node* n)
 
 void node_func_parameters::on_child_removed(node* n)
 {
-	const auto named = dynamic_cast<node_var*>(n);
+	const auto named = n->as<node_var>();
 	if (named)
 	{
 		const auto idx = _arguments.find(named);
@@ -10,6 +10,7 @@ using namespace o2;
 node_func_returns::node_func_returns(const source_code_view& view)
 		: node(view)
 {
+	set_kind(node_kind::func_returns);
 	set_query_access_flags(query_access_modifier_passthrough);
 }
 
@@ -0,0 +1,101 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "literal.h"
+#include <charconv>
+
+using namespace o2;
+
+namespace
+{
+	string_view remove_suffix(string_view value, string_literal suffix)
+	{
+		if (!value.empty() && value.back() == suffix)
+			value.remove_suffix(1);
+		return value;
+	}
+
+	bool is_hex_prefix(string_view value)
+	{
+		return value.length() > 2 && value[0] == '0' && (value[1] == 'x' || value[1] == 'X');
+	}
+
+	/**
+	 * \brief call the supplied function with the value as a range of chars, which is what std::from_chars expects
+	 */
+	template<class Fn>
+	literal_status with_chars(string_view value, Fn fn)
+	{
+#if defined(O2_UTF16_SUPPORT)
+		// literals only contain ASCII characters, so it's safe to narrow them
+		char buf[256];
+		if (value.length() > sizeof(buf))
+			return literal_status::invalid;
+		for (size_t i = 0; i < value.length(); ++i)
+		{
+			if (value[i] > 127)
+				return literal_status::invalid;
+			buf[i] = (char)value[i];
+		}
+		return fn(buf, buf + value.length());
+#else
+		return fn(value.data(), value.data() + value.length());
+#endif
+	}
+
+	literal_status to_status(std::from_chars_result r, const char* last)
+	{
+		if (r.ec == std::errc::result_out_of_range)
+			return literal_status::out_of_range;
+		if (r.ec != std::errc() || r.ptr != last)
+			return literal_status::invalid;
+		return literal_status::ok;
+	}
+
+	template<class T>
+	literal_status decode_integer(string_view value, int base, T* result)
+	{
+		return with_chars(value, [base, result](const char* first, const char* last)
+		{
+			if (first == last)
+				return literal_status::invalid;
+			return to_status(std::from_chars(first, last, *result, base), last);
+		});
+	}
+
+	template<class T>
+	literal_status decode_float(string_view value, T* result)
+	{
+		return with_chars(value, [result](const char* first, const char* last)
+		{
+			if (first == last)
+				return literal_status::invalid;
+			return to_status(std::from_chars(first, last, *result, std::chars_format::general), last);
+		});
+	}
+}
+
+literal_status o2::literal_decode_int64(string_view value, OUT std::int64_t* result)
+{
+	return decode_integer(value, 10, result);
+}
+
+literal_status o2::literal_decode_uint64(string_view value, OUT std::uint64_t* result)
+{
+	value = remove_suffix(value, 'u');
+	if (is_hex_prefix(value))
+		return decode_integer(value.substr(2), 16, result);
+	return decode_integer(value, 10, result);
+}
+
+literal_status o2::literal_decode_float32(string_view value, OUT float* result)
+{
+	return decode_float(remove_suffix(value, 'f'), result);
+}
+
+literal_status o2::literal_decode_float64(string_view value, OUT double* result)
+{
+	return decode_float(value, result);
+}
@@ -0,0 +1,52 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include "strings.h"
+#include <cstdint>
+
+namespace o2
+{
+	/**
+	 * \brief the result of decoding a literal
+	 */
+	enum class literal_status
+	{
+		ok,
+		// the literal is valid, but the value doesn't fit in the requested type
+		out_of_range,
+		// the literal is not a valid number
+		invalid
+	};
+
+	/**
+	 * \brief decode a decimal integer literal, such as 1234
+	 * \param value the literal
+	 * \param result where the value is put
+	 */
+	literal_status literal_decode_int64(string_view value, OUT std::int64_t* result);
+
+	/**
+	 * \brief decode an unsigned integer literal, such as 1234u or 0xFF. A trailing 'u' is allowed
+	 * \param value the literal
+	 * \param result where the value is put
+	 */
+	literal_status literal_decode_uint64(string_view value, OUT std::uint64_t* result);
+
+	/**
+	 * \brief decode a decimal literal, such as 1.5 or 1.5e+10. A trailing 'f' is allowed
+	 * \param value the literal
+	 * \param result where the value is put
+	 */
+	literal_status literal_decode_float32(string_view value, OUT float* result);
+
+	/**
+	 * \brief decode a decimal literal, such as 1.5 or 1.5e+10
+	 * \param value the literal
+	 * \param result where the value is put
+	 */
+	literal_status literal_decode_float64(string_view value, OUT double* result);
+}
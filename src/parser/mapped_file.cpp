@@ -0,0 +1,115 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "mapped_file.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace o2;
+
+mapped_file::mapped_file(const char* memory, std::size_t size, std::size_t mapped_size)
+		: _memory(memory), _size(size), _mapped_size(mapped_size)
+{
+}
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+
+mapped_file::~mapped_file()
+{
+	UnmapViewOfFile(_memory);
+}
+
+mapped_file* mapped_file::open(const std::filesystem::path& path)
+{
+	const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	// the bytes after the end of the file in the last page are zero. If the file ends exactly on a page boundary
+	// then there are no such bytes, which means that the file can't be mapped
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	const auto size = (std::size_t)file_size.QuadPart;
+	if (size % info.dwPageSize == 0)
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr)
+		return nullptr;
+
+	// the view keeps a reference to the mapping, so it's safe to close the handle directly
+	const auto memory = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (memory == nullptr)
+		return nullptr;
+	return new mapped_file(static_cast<const char*>(memory), size, size);
+}
+
+#else
+
+mapped_file::~mapped_file()
+{
+	munmap(const_cast<char*>(_memory), _mapped_size);
+}
+
+mapped_file* mapped_file::open(const std::filesystem::path& path)
+{
+	const auto fd = ::open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st{};
+	if (fstat(fd, &st) == -1 || st.st_size == 0)
+	{
+		close(fd);
+		return nullptr;
+	}
+
+	// reserve enough zeroed pages for the file and at least one trailing zero byte. The file is then mapped on top
+	// of the reserved memory, which guarantees that the text is null-terminated even if the file ends exactly on
+	// a page boundary
+	const auto size = (std::size_t)st.st_size;
+	const auto page_size = (std::size_t)sysconf(_SC_PAGESIZE);
+	const auto mapped_size = (size + 1 + page_size - 1) / page_size * page_size;
+	const auto reserved = mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (reserved == MAP_FAILED)
+	{
+		close(fd);
+		return nullptr;
+	}
+
+	const auto memory = mmap(reserved, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+	close(fd);
+	if (memory == MAP_FAILED)
+	{
+		munmap(reserved, mapped_size);
+		return nullptr;
+	}
+	madvise(memory, size, MADV_SEQUENTIAL);
+	return new mapped_file(static_cast<const char*>(memory), size, mapped_size);
+}
+
+#endif
@@ -0,0 +1,53 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <filesystem>
+
+namespace o2
+{
+	/**
+	 * \brief a read-only, memory mapped file
+	 *
+	 * The mapped memory is always followed by at least one zero byte, which means that the content can be
+	 * treated as a null-terminated string without copying it
+	 */
+	class mapped_file
+	{
+	public:
+		mapped_file(const mapped_file&) = delete;
+
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		~mapped_file();
+
+		/**
+		 * \brief map the supplied file into memory
+		 * \param path the path to the file
+		 * \return the mapped file; nullptr if the file could not be mapped
+		 */
+		static mapped_file* open(const std::filesystem::path& path);
+
+		/**
+		 * \return the content of the file
+		 */
+		[[nodiscard]] std::string_view get_text() const
+		{
+			return { _memory, _size };
+		}
+
+	private:
+		mapped_file(const char* memory, std::size_t size, std::size_t mapped_size);
+
+	private:
+		const char* const _memory;
+		const std::size_t _size;
+		// the number of bytes reserved by the mapping, including the trailing zero bytes
+		const std::size_t _mapped_size;
+	};
+}
@@ -0,0 +1,114 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "memory_arena.h"
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+using namespace o2;
+
+namespace
+{
+	constexpr std::size_t ALIGNMENT = alignof(std::max_align_t);
+
+	constexpr std::size_t align(std::size_t size)
+	{
+		return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
+
+	// the arena used by this thread
+	thread_local memory_arena* _current = nullptr;
+}
+
+memory_arena::memory_arena(std::size_t block_size)
+		: _block_size(block_size), _blocks(), _pos(), _end(), _allocated_bytes(), _block_count()
+{
+}
+
+memory_arena::~memory_arena()
+{
+	assert(_current != this && "an arena must not be destroyed while being used");
+	auto b = _blocks;
+	while (b)
+	{
+		const auto next = b->next;
+		o2_free(b);
+		b = next;
+	}
+	_blocks = nullptr;
+}
+
+void* memory_arena::allocate(std::size_t size)
+{
+	size = align(size);
+	// allocations that are large compared to the block size gets their own block, so that
+	// we don't waste the rest of the current block
+	if (size > _block_size / 4)
+	{
+		_allocated_bytes += size;
+		return new_block(size);
+	}
+
+	if (_pos == nullptr || (std::size_t)(_end - _pos) < size)
+	{
+		_pos = new_block(_block_size);
+		_end = _pos + _block_size;
+	}
+	const auto memory = _pos;
+	_pos += size;
+	_allocated_bytes += size;
+	return memory;
+}
+
+void memory_arena::adopt(memory_arena* other)
+{
+	assert(other != this && "an arena cannot adopt itself");
+	assert(_current != other && "an arena must not be adopted while being used");
+	if (other->_blocks == nullptr)
+		return;
+
+	// link the adopted blocks in front of our own. The block we are allocating from is left untouched
+	auto last = other->_blocks;
+	while (last->next)
+		last = last->next;
+	last->next = _blocks;
+	_blocks = other->_blocks;
+	_allocated_bytes += other->_allocated_bytes;
+	_block_count += other->_block_count;
+
+	other->_blocks = nullptr;
+	other->_pos = nullptr;
+	other->_end = nullptr;
+	other->_allocated_bytes = 0;
+	other->_block_count = 0;
+}
+
+char* memory_arena::new_block(std::size_t size)
+{
+	const auto b = static_cast<block*>(o2_malloc(align(sizeof(block)) + size));
+	if (b == nullptr)
+		throw std::bad_alloc();
+	b->next = _blocks;
+	_blocks = b;
+	_block_count++;
+	return reinterpret_cast<char*>(b) + align(sizeof(block));
+}
+
+memory_arena* memory_arena::get_current()
+{
+	return _current;
+}
+
+memory_arena_scope::memory_arena_scope(memory_arena* arena)
+		: _prev(_current)
+{
+	_current = arena;
+}
+
+memory_arena_scope::~memory_arena_scope()
+{
+	_current = _prev;
+}
@@ -0,0 +1,106 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include "memory.h"
+#include <cstddef>
+
+namespace o2
+{
+	/**
+	 * \brief a bump allocator where all memory is released at once when the arena is destroyed
+	 *
+	 * Nodes created while an arena is the current arena for the running thread are put into it, which
+	 * means that individual nodes are never released back to the system. This is used by packages
+	 * so that all nodes parsed for a package are packed together in memory and released in bulk.
+	 *
+	 * An arena is not thread-safe, but different threads may use different arenas at the same time
+	 */
+	class memory_arena
+	{
+	public:
+		explicit memory_arena(std::size_t block_size = 64 * 1024);
+
+		memory_arena(const memory_arena&) = delete;
+
+		memory_arena& operator=(const memory_arena&) = delete;
+
+		~memory_arena();
+
+		/**
+		 * \brief allocate memory from this arena
+		 * \param size the number of bytes
+		 * \return memory aligned for any scalar type
+		 */
+		void* allocate(std::size_t size);
+
+		/**
+		 * \brief take over all memory allocated by the supplied arena
+		 *
+		 * The memory is released when this arena is destroyed instead, which allows for memory allocated in
+		 * different arenas, by different threads, to be merged into one arena once they are done
+		 *
+		 * \param other the arena that gives up its memory
+		 */
+		void adopt(memory_arena* other);
+
+		/**
+		 * \return the number of bytes allocated from this arena
+		 */
+		[[nodiscard]] std::size_t get_allocated_bytes() const
+		{
+			return _allocated_bytes;
+		}
+
+		/**
+		 * \return the number of memory blocks reserved by this arena
+		 */
+		[[nodiscard]] int get_block_count() const
+		{
+			return _block_count;
+		}
+
+		/**
+		 * \return the arena used by the current thread. nullptr if no arena is used
+		 */
+		static memory_arena* get_current();
+
+	private:
+		friend class memory_arena_scope;
+
+		struct block
+		{
+			block* next;
+		};
+
+		/**
+		 * \brief reserve a new block that fits at least the supplied number of bytes
+		 */
+		char* new_block(std::size_t size);
+
+	private:
+		const std::size_t _block_size;
+		block* _blocks;
+		char* _pos;
+		char* _end;
+		std::size_t _allocated_bytes;
+		int _block_count;
+	};
+
+	/**
+	 * \brief helper that makes the supplied arena the current arena for this thread while in scope
+	 */
+	class memory_arena_scope
+	{
+	public:
+		explicit memory_arena_scope(memory_arena* arena);
+
+		~memory_arena_scope();
+
+	private:
+		memory_arena* const _prev;
+	};
+}
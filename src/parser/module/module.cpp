@@ -53,6 +53,11 @@ void module::load_package_sources(package_source_info* info) const
 	_sources->load_sources(info);
 }
 
+bool module::get_package_sources_stamp(const package_source_info* info, std::uint64_t* stamp) const
+{
+	return _sources->get_sources_stamp(info, stamp);
+}
+
 node_module* module::insert_into(syntax_tree* st)
 {
 	assert(!bit_isset(_modifiers, modifier_added));
@@ -68,6 +73,12 @@ node_package* module::add_package(node_package* p)
 	return p;
 }
 
+void module::remove_package(node_package* p)
+{
+	assert(p->get_parent() == _node_module);
+	_node_module->remove_child(p);
+}
+
 void module::notify_package_imported(node_package* p)
 {
 	// potentially imports that's loaded
@@ -94,6 +105,15 @@ void module::add_import_request(node_import* i)
 	_state.parse.import_requests.add(i);
 }
 
+void module::remove_import_requests(node_package* p)
+{
+	for (int idx = _state.parse.import_requests.size() - 1; idx >= 0; --idx)
+	{
+		if (_state.parse.import_requests[idx]->get_parent_of_type<node_package>() == p)
+			_state.parse.import_requests.remove_at(idx);
+	}
+}
+
 vector<node_package*> module::get_packages() const
 {
 	return std::move(_node_module->get_children_of_type<node_package>());
@@ -145,6 +145,14 @@ namespace o2
 		 */
 		void load_package_sources(package_source_info* info) const;
 
+		/**
+		 * \brief get a stamp of the supplied source code content, without loading it
+		 * \param info the package source information
+		 * \param stamp where the stamp is put
+		 * \return true if successful
+		 */
+		bool get_package_sources_stamp(const package_source_info* info, std::uint64_t* stamp) const;
+
 		/**
 		 * \brief add this module to the syntax tree
 		 * \param st a syntax tree
@@ -159,6 +167,12 @@ namespace o2
 		 */
 		node_package* add_package(node_package* p);
 
+		/**
+		 * \brief remove the supplied package from this module. The package is not deleted
+		 * \param p the package
+		 */
+		void remove_package(node_package* p);
+
 		/**
 		 * \brief package is now imported
 		 * \param p
@@ -177,6 +191,12 @@ namespace o2
 		 */
 		void add_import_request(node_import* i);
 
+		/**
+		 * \brief remove all imports, found in the supplied package, that's waiting to be loaded by this module
+		 * \param p the package where the imports are found
+		 */
+		void remove_import_requests(node_package* p);
+
 		/**
 		 * \return all packages in this module so far
 		 */
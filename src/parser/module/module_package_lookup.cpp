@@ -4,10 +4,11 @@
 //
 
 #include "module_package_lookup.h"
+#include "../content_hash.h"
 #include <filesystem>
-#include <fstream>
-#include <sstream>
 #include <utility>
+#include <vector>
+#include <algorithm>
 
 using namespace o2;
 using namespace std;
@@ -66,23 +67,57 @@ namespace
 
 package_source_info* filesystem_module_package_lookup::get_info(string_view relative_import_path)
 {
-	auto it = _sources.find(relative_import_path);
-	if (it != _sources.end())
+	const auto [it, inserted] = _sources.emplace(string(relative_import_path), nullptr);
+	if (!inserted)
 		return it->second;
 
-	const auto package_sources = new package_source_info{
-			relative_import_path,
-			relative_import_path,
+	it->second = new package_source_info{
+			it->first,
+			it->first,
 			package_source_info::not_loaded
 	};
-	_sources[relative_import_path] = package_sources;
-	return package_sources;
+	return it->second;
 }
 
 void filesystem_module_package_lookup::load_sources(package_source_info* package_sources) const
 {
-	const std::filesystem::path p = _root_dir / package_sources->relative_path.relative_path();
-	for (const auto& fe: filesystem::directory_iterator(p))
+	for (const auto& path: get_source_files(get_package_path(package_sources)))
+		package_sources->sources.add(source_code::from_file(path));
+}
+
+bool filesystem_module_package_lookup::get_sources_stamp(const package_source_info* info, std::uint64_t* stamp) const
+{
+	try
+	{
+		// the path of the directory is part of the stamp, since packages in different directories might have the
+		// same files
+		const auto dir = get_package_path(info);
+		content_hash hash;
+		hash.add(string_view(dir.generic_string()));
+		for (const auto& path: get_source_files(dir))
+		{
+			hash.add(string_view(path.filename().generic_string()));
+			hash.add((std::uint64_t)std::filesystem::file_size(path));
+			hash.add((std::uint64_t)std::filesystem::last_write_time(path).time_since_epoch().count());
+		}
+		*stamp = hash.get();
+		return true;
+	}
+	catch (const std::filesystem::filesystem_error&)
+	{
+		return false;
+	}
+}
+
+std::filesystem::path filesystem_module_package_lookup::get_package_path(const package_source_info* info) const
+{
+	return _root_dir / info->relative_path.relative_path();
+}
+
+std::vector<std::filesystem::path> filesystem_module_package_lookup::get_source_files(const std::filesystem::path& dir)
+{
+	std::vector<std::filesystem::path> paths;
+	for (const auto& fe: filesystem::directory_iterator(dir))
 	{
 		if (!fe.is_regular_file())
 			continue;
@@ -92,16 +127,13 @@ void filesystem_module_package_lookup::load_sources(package_source_info* package
 		if (!accept(path))
 			continue;
 
-		// read the actual file content into a string
-		ifstream f(path);
-		std::stringstream ss;
-		ss << f.rdbuf();
-		std::string const& s = ss.str();
-
-		// TODO: check what type of file this is. It might be ASCII, UTF-8, UTF-16 and various little and big endian
-		package_sources->sources.add(new source_code(ss.str(), fe.path().generic_string()));
-		f.close();
+		paths.push_back(path);
 	}
+
+	// the order of the files in a directory is not specified, so sort them to make sure that a package is always
+	// parsed in the same order
+	std::sort(paths.begin(), paths.end());
+	return paths;
 }
 
 memory_module_package_lookup::~memory_module_package_lookup()
@@ -9,6 +9,8 @@
 #include "../collections/vector.h"
 #include <unordered_map>
 #include <filesystem>
+#include <cstdint>
+#include <vector>
 
 namespace o2
 {
@@ -43,6 +45,17 @@ namespace o2
 			for (auto s: sources)
 				delete s;
 		}
+
+		/**
+		 * \brief unload the sources, so that they are loaded again the next time the package is imported
+		 */
+		void unload()
+		{
+			for (auto s: sources)
+				delete s;
+			sources.clear();
+			load_status = not_loaded;
+		}
 	};
 
 	/**
@@ -67,6 +80,18 @@ namespace o2
 		virtual void load_sources(package_source_info* info) const
 		{
 		}
+
+		/**
+		 * \brief get a stamp of the sources for the supplied information, without loading them. The stamp is
+		 *        changed when a source is added, removed or modified
+		 * \param info the package source information
+		 * \param stamp where the stamp is put
+		 * \return true if successful; false if the sources can't be stamped
+		 */
+		virtual bool get_sources_stamp(const package_source_info* info, std::uint64_t* stamp) const
+		{
+			return false;
+		}
 	};
 
 	/**
@@ -88,11 +113,26 @@ namespace o2
 
 		void load_sources(package_source_info* package_sources) const final;
 
+		bool get_sources_stamp(const package_source_info* info, std::uint64_t* stamp) const final;
+
 #pragma endregion
 
+	private:
+		/**
+		 * \return the path to the directory where the supplied package is found
+		 */
+		[[nodiscard]] std::filesystem::path get_package_path(const package_source_info* info) const;
+
+		/**
+		 * \return the source files of the package found in the supplied directory, sorted by their path
+		 */
+		static std::vector<std::filesystem::path> get_source_files(const std::filesystem::path& dir);
+
 	private:
 		std::filesystem::path _root_dir;
-		std::unordered_map<string_view, package_source_info*> _sources;
+		// the keys are owned by the map, because the import statements point into the source code that imports
+		// the package, which might be unloaded before this lookup is destroyed
+		std::unordered_map<string, package_source_info*> _sources;
 	};
 
 	/**
@@ -10,8 +10,9 @@
 using namespace o2;
 
 node_module::node_module(module* m)
-		: node_symbol(source_code_view()), _name(m->get_name()), _module(m)
+		: node_symbol(source_code_view()), _name(symbol_id::intern(m->get_name())), _module(m)
 {
+	set_kind(node_kind::module);
 }
 
 void node_module::debug(debug_ostream& stream, int indent) const
@@ -31,6 +32,18 @@ string_view node_module::get_relative_path(string_view import_path) const
 	return _module->get_relative_path(import_path);
 }
 
+node* node_module::on_child_added(node* n)
+{
+	_symbols.add(n, get_children());
+	return node_symbol::on_child_added(n);
+}
+
+void node_module::on_child_removed(node* n)
+{
+	node_symbol::on_child_removed(n);
+	_symbols.remove(n);
+}
+
 void node_module::on_parent_node(node* p)
 {
 	superficial_collision_test(this);
@@ -51,7 +64,7 @@ void node_module::write_json_properties(json& j)
 	}
 }
 
-string node_module::get_id() const
+string node_module::build_id() const
 {
 	stringstream ss;
 	ss << '/' << _module->get_name();
@@ -65,7 +78,7 @@ string node_module::get_id() const
 
 bool node_module::superficial_test_symbol_collision(const node_module* rhs) const
 {
-	if (get_name() == rhs->get_name() &&
+	if (get_name_id() == rhs->get_name_id() &&
 		   get_version() == rhs->get_version())
 		throw error_named_symbol_already_declared(get_source_code(), get_name(), rhs->get_source_code());
 	return false;
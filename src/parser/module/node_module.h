@@ -6,6 +6,7 @@
 #pragma once
 
 #include "../node_symbol.h"
+#include "../symbol_table.h"
 
 namespace o2
 {
@@ -24,6 +25,14 @@ namespace o2
 		 * \return the name of this module
 		 */
 		[[nodiscard]] string_view get_name() const
+		{
+			return _name.str();
+		}
+
+		/**
+		 * \return the interned name of this module
+		 */
+		[[nodiscard]] symbol_id get_name_id() const
 		{
 			return _name;
 		}
@@ -49,7 +58,7 @@ namespace o2
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const final;
+		[[nodiscard]] string build_id() const final;
 
 		bool superficial_test_symbol_collision(const node_module* rhs) const;
 
@@ -57,6 +66,20 @@ namespace o2
 
 #pragma region node
 
+		void get_symbol_names(vector<symbol_id>* dest) const final
+		{
+			dest->add(_name);
+		}
+
+		[[nodiscard]] const symbol_table* get_symbol_table() const final
+		{
+			return &_symbols;
+		}
+
+		node* on_child_added(node* n) final;
+
+		void on_child_removed(node* n) final;
+
 		void on_parent_node(node* p) final;
 
 		void debug(debug_ostream& stream, int indent) const final;
@@ -75,7 +98,8 @@ namespace o2
 #pragma endregion
 
 	private:
-		const string_view _name;
+		const symbol_id _name;
 		module* const _module;
+		symbol_table _symbols;
 	};
 }
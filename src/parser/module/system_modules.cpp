@@ -32,7 +32,8 @@ o2::module* system_modules::find_module(string_view statement)
 		if (std::filesystem::is_directory(path))
 		{
 			best_match = o2_new module(this, string(statement), path.generic_string());
-			_builtin_modules[statement] = best_match;
+			// the statement points into the source code that imports the module, so the module's name is used
+			_builtin_modules[best_match->get_name()] = best_match;
 			best_match->insert_into(_syntax_tree);
 		}
 	}
@@ -4,9 +4,70 @@
 //
 
 #include "node.h"
+#include "memory_arena.h"
+#include "symbol_table.h"
+#include <cstdlib>
+#include <new>
 
 using namespace o2;
 
+namespace
+{
+	// header put in front of all nodes so that we know if the node is allocated from an arena or not
+	struct alignas(std::max_align_t) node_allocation
+	{
+		memory_arena* arena;
+	};
+}
+
+#if defined(O2_MEMORY_TRACKING)
+
+void* node::operator new(std::size_t size, const char* filename, int line) noexcept
+{
+	const auto arena = memory_arena::get_current();
+	void* memory;
+	if (arena)
+		memory = arena->allocate(sizeof(node_allocation) + size);
+	else
+		memory = memory_tracker::alloc_mem(sizeof(node_allocation) + size, filename, line);
+	if (memory == nullptr)
+		return nullptr;
+	return new(memory) node_allocation{ arena } + 1;
+}
+
+void node::operator delete(void* p, const char* filename, int line)
+{
+	node::operator delete(p);
+}
+
+#else
+
+void* node::operator new(std::size_t size)
+{
+	const auto arena = memory_arena::get_current();
+	void* memory;
+	if (arena)
+		memory = arena->allocate(sizeof(node_allocation) + size);
+	else
+		memory = ::malloc(sizeof(node_allocation) + size);
+	if (memory == nullptr)
+		throw std::bad_alloc();
+	return new(memory) node_allocation{ arena } + 1;
+}
+
+#endif
+
+void node::operator delete(void* p)
+{
+	if (p == nullptr)
+		return;
+	const auto allocation = static_cast<node_allocation*>(p) - 1;
+	// nodes allocated from an arena are released when the arena is destroyed
+	if (allocation->arena)
+		return;
+	o2_free(allocation);
+}
+
 node::~node()
 {
 	node::destroy_children();
@@ -102,29 +163,6 @@ void node::resolve0(const recursion_detector* rd, resolve_state* state)
 		c->process_phase(&rd0, state, phase_resolve);
 }
 
-vector<node*> node::optimize(node_optimizer* optimizer)
-{
-	auto children = get_children();
-	for (int i = 0; i < children.size(); ++i)
-	{
-		const auto optimized = children[i]->optimize(optimizer);
-		if (optimized.empty())
-			continue;
-		if (optimized.size() == 1)
-			delete replace_child(i, optimized[0]);
-		else
-		{
-			delete replace_children(i, optimized);
-			i--;
-			children = get_children();
-		}
-	}
-
-	if (optimizer->accept(this))
-		return optimizer->optimize(this);
-	return {};
-}
-
 void node::set_parent(node* p)
 {
 	if (p == nullptr)
@@ -164,6 +202,20 @@ void node::remove_child(node* n)
 	n->set_parent(nullptr);
 }
 
+vector<node*> node::remove_children()
+{
+	vector<node*> children;
+	children.add(_children);
+	_children.clear();
+	// the children are removed from the last one, which makes it cheap to remove them from the symbol tables
+	for (int i = children.size() - 1; i >= 0; --i)
+	{
+		on_child_removed(children[i]);
+		children[i]->set_parent(nullptr);
+	}
+	return children;
+}
+
 void node::query(query_node_visitor* visitor, int flags)
 {
 	visitor->visit(this);
@@ -195,6 +247,20 @@ void node::query_children(query_node_visitor* visitor, int flags)
 	flags = bit_set(flags, query_flag_downwards);
 	// we are not querying upwards anymore
 	flags = bit_unset(flags, query_flag_upwards);
+
+	// if the children are not allowed to query their children then only the children with a matching
+	// name, or those who allow for passthrough, can be of interest for a visitor searching for a name
+	const auto symbols = get_symbol_table();
+	if (symbols != nullptr && !bit_isset(flags, query_flag_children))
+	{
+		const auto name = visitor->get_query_name();
+		if (name.valid())
+		{
+			symbols->query(visitor, name, flags);
+			return;
+		}
+	}
+
 	for (const auto c: _children)
 		c->query(visitor, flags);
 }
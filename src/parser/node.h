@@ -14,12 +14,16 @@
 #include "recursion_detector.h"
 #include "json/json_serializable.h"
 #include "resolve_state.h"
+#include "node_kind.h"
+#include "symbol_id.h"
 #include <sstream>
 
 namespace o2
 {
 	class recursion_detector;
 
+	class symbol_table;
+
 	/**
 	 * \brief a helper structure that ensures that memory is de-allocated when errors occurs
 	 * \tparam T the type
@@ -136,6 +140,18 @@ namespace o2
 		 * \return what to do next
 		 */
 		virtual void visit(node* n) = 0;
+
+		/**
+		 * \brief the name of the nodes this visitor is searching for
+		 * \return a name. An invalid id means that the visitor is interested in all nodes
+		 *
+		 * A visitor that returns a name promises to only accept nodes that has the name amongst its symbol names,
+		 * which allows scopes with a symbol table to skip all other nodes
+		 */
+		[[nodiscard]] virtual symbol_id get_query_name() const
+		{
+			return {};
+		}
 	};
 
 	/**
@@ -151,12 +167,70 @@ namespace o2
 		}
 
 		node(const source_code_view& view, int access_modifier)
-				: _source_code(view), _parent(), _query_access_modifiers(access_modifier), _phases_left(phase_resolve)
+				: _source_code(view), _parent(), _query_access_modifiers(access_modifier), _phases_left(phase_resolve),
+				  _kind(node_kind::unknown)
 		{
 		}
 
 		~node() override;
 
+#if defined(O2_MEMORY_TRACKING)
+		static void* operator new(std::size_t size, const char* filename, int line) noexcept;
+
+		static void operator delete(void* p, const char* filename, int line);
+#else
+		static void* operator new(std::size_t size);
+#endif
+
+		/**
+		 * \brief release the memory of the supplied node
+		 *
+		 * memory for nodes created while an arena is active is not released until the arena itself is destroyed
+		 */
+		static void operator delete(void* p);
+
+		/**
+		 * \return the kind of node
+		 */
+		[[nodiscard]] node_kind get_kind() const
+		{
+			return _kind;
+		}
+
+		/**
+		 * \tparam T the node type
+		 * \return true if this node is of the supplied type, or inherits from it
+		 */
+		template<class T>
+		[[nodiscard]] bool is() const
+		{
+			return node_kind_of<T>::first <= _kind && _kind <= node_kind_of<T>::last;
+		}
+
+		/**
+		 * \tparam T the node type
+		 * \return this node as the supplied type; nullptr if this node is not of the supplied type
+		 */
+		template<class T>
+		[[nodiscard]] T* as()
+		{
+			if (is<T>())
+				return static_cast<T*>(this);
+			return nullptr;
+		}
+
+		/**
+		 * \tparam T the node type
+		 * \return this node as the supplied type; nullptr if this node is not of the supplied type
+		 */
+		template<class T>
+		[[nodiscard]] const T* as() const
+		{
+			if (is<T>())
+				return static_cast<const T*>(this);
+			return nullptr;
+		}
+
 		/**
 		 * \return get the root node
 		 */
@@ -266,6 +340,12 @@ namespace o2
 		 */
 		void remove_child(node* n);
 
+		/**
+		 * \brief remove all children from this node, without deleting them
+		 * \return the removed children, in the same order as they were found amongst the children
+		 */
+		vector<node*> remove_children();
+
 		/**
 		 * \brief method called when a child node is removed
 		 * \param n the node
@@ -326,11 +406,21 @@ namespace o2
 		virtual void resolve0(const recursion_detector* rd, resolve_state* state);
 
 		/**
-		 * \brief optimize this node using the supplied optimizer
-		 * \param optimizer
-		 * \return new nodes to replace this node
+		 * \brief get the names that this node can be referred to by when querying
+		 * \param dest where the names are put
+		 * \remark nodes that allow for passthrough querying are always queried, so their names are never used
+		 */
+		virtual void get_symbol_names(vector<symbol_id>* dest) const
+		{
+		}
+
+		/**
+		 * \return the symbol table for the scope that this node owns. nullptr if this node doesn't own a scope
 		 */
-		virtual vector<node*> optimize(node_optimizer* optimizer);
+		[[nodiscard]] virtual const symbol_table* get_symbol_table() const
+		{
+			return nullptr;
+		}
 
 		/**
 		 * \brief querying nodes from a specific node's point-of-view
@@ -486,10 +576,12 @@ namespace o2
 		template<class T>
 		T* get_parent_of_type()
 		{
-			const auto p = dynamic_cast<T*>(_parent);
-			if (p != nullptr || _parent == nullptr)
-				return p;
-			return _parent->get_parent_of_type<T>();
+			for (auto p = _parent; p != nullptr; p = p->_parent)
+			{
+				if (p->is<T>())
+					return static_cast<T*>(p);
+			}
+			return nullptr;
 		}
 
 		/**
@@ -499,10 +591,12 @@ namespace o2
 		template<class T>
 		T* get_parent_of_type() const
 		{
-			const auto p = dynamic_cast<T*>(_parent);
-			if (p != nullptr || _parent == nullptr)
-				return p;
-			return _parent->get_parent_of_type<T>();
+			for (auto p = _parent; p != nullptr; p = p->_parent)
+			{
+				if (p->is<T>())
+					return static_cast<T*>(p);
+			}
+			return nullptr;
 		}
 
 		/**
@@ -516,9 +610,8 @@ namespace o2
 			vector<T*> result;
 			for (const auto c: _children)
 			{
-				const auto cc = dynamic_cast<T*>(c);
-				if (cc)
-					result.add(cc);
+				if (c->is<T>())
+					result.add(static_cast<T*>(c));
 			}
 			return std::move(result);
 		}
@@ -533,9 +626,8 @@ namespace o2
 		{
 			for (const auto c: _children)
 			{
-				const auto cc = dynamic_cast<T*>(c);
-				if (cc)
-					return cc;
+				if (c->is<T>())
+					return static_cast<T*>(c);
 			}
 			return nullptr;
 		}
@@ -582,6 +674,16 @@ namespace o2
 		}
 
 	protected:
+		/**
+		 * \brief set the kind of this node. Must be called by the constructor of all node types that have
+		 *        their own kind
+		 * \param kind the kind
+		 */
+		void set_kind(node_kind kind)
+		{
+			_kind = kind;
+		}
+
 		static string in(int indent)
 		{
 			string s;
@@ -596,5 +698,16 @@ namespace o2
 		vector<node*> _children;
 		int _query_access_modifiers;
 		int _phases_left;
+		node_kind _kind;
 	};
+
+	template<class T>
+	const recursion_detector* recursion_detector::first_of_type() const
+	{
+		if (n != nullptr && n->is<T>())
+			return this;
+		if (parent)
+			return parent->first_of_type<T>();
+		return nullptr;
+	}
 }
\ No newline at end of file
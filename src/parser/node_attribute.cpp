@@ -16,6 +16,7 @@ namespace
 node_attribute::node_attribute(const source_code_view& view)
 		: node(view), _attribute_type()
 {
+	set_kind(node_kind::attribute);
 }
 
 void node_attribute::debug(debug_ostream& stream, int indent) const
@@ -32,18 +33,19 @@ void node_attribute::resolve0(const recursion_detector* rd, resolve_state* state
 
 	node::resolve0(rd, state);
 	// TODO verify that the type actually inherits from stdlib.attribute
-	_attribute_type = dynamic_cast<node_type_complex*>(_attribute_type->get_type());
+	_attribute_type = _attribute_type->get_type()->as<node_type_complex>();
 	if (_attribute_type == nullptr)
 		throw resolve_error_unresolved_reference(get_source_code());
 	const auto inherits =
 			static_cast<node_type_complex*>(_attribute_type);
-	if (inherits->find_inherited_type(ATTRIBUTE_ID) == nullptr)
+	static const auto attribute_id = symbol_id::intern(ATTRIBUTE_ID);
+	if (inherits->find_inherited_type(attribute_id) == nullptr)
 		throw resolve_error_expected_inherits_from_attribute(get_source_code());
 }
 
 node* node_attribute::on_child_added(node* n)
 {
-	const auto type = dynamic_cast<node_type*>(n);
+	const auto type = n->as<node_type>();
 	if (type != nullptr)
 		_attribute_type = type;
 	return n;
@@ -58,6 +60,7 @@ void node_attribute::on_child_removed(node* n)
 node_attributes::node_attributes(const source_code_view& view)
 		: node(view)
 {
+	set_kind(node_kind::attributes);
 }
 
 void node_attributes::debug(debug_ostream& stream, int indent) const
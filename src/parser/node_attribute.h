@@ -41,6 +41,14 @@ namespace o2
 			return _attribute_type;
 		}
 
+		/**
+		 * \param type the attribute type
+		 */
+		void set_attribute_type(node_type* type)
+		{
+			_attribute_type = type;
+		}
+
 #pragma region node
 
 		void debug(debug_ostream& stream, int indent) const final;
@@ -20,74 +20,75 @@ void node_import::debug(debug_ostream& stream, int indent) const
 	node::debug(stream, indent);
 }
 
-void node_import::resolve0(const recursion_detector* rd, resolve_state* state)
+node_package* node_import::find_package()
 {
-	// resolve package first and then the rest of the children
-	if (_package == nullptr)
+	if (_package != nullptr)
+		return _package;
+
+	class modules_visitor
+			: public query_node_visitor
 	{
-		class modules_visitor
-				: public query_node_visitor
+	public:
+		const string_view text;
+		vector<node_module*> modules;
+
+		explicit modules_visitor(string_view text)
+				: text(text)
 		{
-		public:
-			const string_view text;
-			vector<node_module*> modules;
-
-			explicit modules_visitor(string_view text)
-					: text(text)
-			{
-			}
-
-			void visit(node* const n) final
-			{
-				const auto impl = dynamic_cast<node_module*>(n);
-				if (impl && text.starts_with(impl->get_name()))
-					modules.add(impl);
-			}
-		} v1(_import_statement);
-
-		// Query modules upwards until we'll reach root then query down one step
-		// this is because private packages are put as children under the module node
-		get_parent()->query(&v1, node::query_flag_parents | node::query_flag_children_from_root);
-		if (v1.modules.empty())
-			throw resolve_error_unresolved_reference(get_source_code());
-
-		// look for packages in each module
-		class package_visitor
-				: public query_node_visitor
+		}
+
+		void visit(node* const n) final
+		{
+			const auto impl = n->as<node_module>();
+			if (impl && text.starts_with(impl->get_name()))
+				modules.add(impl);
+		}
+	} v1(_import_statement);
+
+	// Query modules upwards until we'll reach root then query down one step
+	// this is because private packages are put as children under the module node
+	get_parent()->query(&v1, node::query_flag_parents | node::query_flag_children_from_root);
+
+	// look for packages in each module
+	class package_visitor
+			: public query_node_visitor
+	{
+	public:
+		const string_view text;
+		vector<node_package*>& packages;
+
+		package_visitor(string_view text, vector<node_package*>& packages)
+				: text(text), packages(packages)
 		{
-		public:
-			const string_view text;
-			vector<node_package*>& packages;
-
-			package_visitor(string_view text, vector<node_package*>& packages)
-					: text(text), packages(packages)
-			{
-			}
-
-			void visit(node* const n) final
-			{
-				const auto impl = dynamic_cast<node_package*>(n);
-				if (impl && text == impl->get_name())
-					packages.add(impl);
-			}
-		};
-
-		vector<node_package*> packages;
-		for (auto m: v1.modules)
+		}
+
+		void visit(node* const n) final
 		{
-			package_visitor v2(m->get_relative_path(_import_statement), packages);
-			m->query(&v2, query_flag_children | query_flag_downwards);
-			if (!packages.empty())
-			{
-				_package = packages[0];
-				break;
-			}
+			const auto impl = n->as<node_package>();
+			if (impl && text == impl->get_name())
+				packages.add(impl);
 		}
+	};
 
-		if (packages.empty() || packages[0] == nullptr)
-			throw resolve_error_unresolved_reference(get_source_code());
-		_package = packages[0];
+	vector<node_package*> packages;
+	for (auto m: v1.modules)
+	{
+		package_visitor v2(m->get_relative_path(_import_statement), packages);
+		m->query(&v2, query_flag_children | query_flag_downwards);
+		if (!packages.empty())
+		{
+			_package = packages[0];
+			break;
+		}
 	}
+	return _package;
+}
+
+void node_import::resolve0(const recursion_detector* rd, resolve_state* state)
+{
+	// resolve package first and then the rest of the children
+	if (find_package() == nullptr)
+		throw resolve_error_unresolved_reference(get_source_code());
 
 	node::resolve0(rd, state);
 }
@@ -112,7 +113,7 @@ void node_import::query(query_node_visitor* visitor, int flags)
 
 void node_import::on_parent_node(node* parent)
 {
-	auto package = dynamic_cast<node_package*>(parent);
+	auto package = parent->as<node_package>();
 	if (package == nullptr)
 		package = parent->get_parent_of_type<node_package>();
 	package->on_import_added(this);
@@ -120,10 +121,13 @@ void node_import::on_parent_node(node* parent)
 
 void node_import::on_removed_parent_node(node* parent)
 {
-	auto package = dynamic_cast<node_package*>(parent);
+	auto package = parent->as<node_package>();
 	if (package == nullptr)
 		package = parent->get_parent_of_type<node_package>();
-	package->on_import_removed(this);
+	// the parent might already be detached from its package, which happens when a chain of imports is moved
+	// from one package to another
+	if (package != nullptr)
+		package->on_import_removed(this);
 }
 
 bool node_import::notify_imported()
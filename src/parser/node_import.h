@@ -27,9 +27,10 @@ namespace o2
 			status_loaded = 1 << 0
 		};
 
-		node_import(const source_code_view& view, string_view import_statement, string_view alias)
+		node_import(const source_code_view& view, string_view import_statement, symbol_id alias)
 				: node(view), _import_statement(import_statement), _alias(alias), _package(), _status(not_loaded)
 		{
+			set_kind(node_kind::import);
 			set_query_access_flags(query_access_modifier_passthrough);
 		}
 
@@ -38,7 +39,7 @@ namespace o2
 			return _import_statement;
 		}
 
-		[[nodiscard]] string_view get_alias() const
+		[[nodiscard]] symbol_id get_alias() const
 		{
 			return _alias;
 		}
@@ -51,6 +52,12 @@ namespace o2
 			return _package;
 		}
 
+		/**
+		 * \brief search for the package this import refers to, if it's not found already
+		 * \return the package; nullptr if the package is not loaded
+		 */
+		node_package* find_package();
+
 		/**
 		 * \brief method called when this import is imported
 		 * \return true if all imports are imported for this package
@@ -74,7 +81,7 @@ namespace o2
 	private:
 		const string_view _import_statement;
 		node_package* _package;
-		const string_view _alias;
+		const symbol_id _alias;
 		status _status;
 	};
 }
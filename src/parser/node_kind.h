@@ -0,0 +1,135 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+namespace o2
+{
+	/**
+	 * \brief the kind of node
+	 *
+	 * The kinds are ordered so that all kinds that inherit from another kind are found directly after that kind,
+	 * ending with a <name>_last marker. This makes it possible to test if a node is of a specific type, or inherits
+	 * from a specific type, using only two integer comparisons.
+	 */
+	enum class node_kind : unsigned char
+	{
+		unknown,
+
+		symbol,
+		type,
+		type_ref,
+		type_known_ref,
+		type_pointer_of,
+		type_reference_of,
+		type_primitive,
+		type_complex,
+		type_implicit,
+		type_array,
+		type_last = type_array,
+		type_complex_field,
+		scope,
+		module,
+		root,
+		package,
+		var,
+		var_this,
+		var_const,
+		var_last = var_const,
+		func,
+		func_method,
+		func_last = func_method,
+		symbol_last = func_last,
+
+		op,
+		op_constant,
+		op_unaryop,
+		op_binop,
+		op_assign,
+		op_callfunc,
+		op_return,
+		op_last = op_return,
+
+		ref,
+		import,
+		link,
+		attribute,
+		attributes,
+		func_parameters,
+		func_returns,
+		func_body,
+		type_complex_fields,
+		type_complex_methods,
+		type_complex_inherits,
+		type_complex_inherit,
+		type_static_scope,
+		type_static_scope_vars,
+		type_static_scope_funcs,
+
+		last = type_static_scope_funcs
+	};
+
+	/**
+	 * \brief the range of kinds that a node type, and all types inheriting from it, have
+	 * \tparam T the node type
+	 */
+	template<class T>
+	struct node_kind_of;
+
+#define O2_NODE_KIND(T, First, Last) \
+    class T; \
+    template<> \
+    struct node_kind_of<T> \
+    { \
+        static constexpr node_kind first = node_kind::First; \
+        static constexpr node_kind last = node_kind::Last; \
+    }
+
+	O2_NODE_KIND(node, unknown, last);
+	O2_NODE_KIND(node_symbol, symbol, symbol_last);
+	O2_NODE_KIND(node_type, type, type_last);
+	O2_NODE_KIND(node_type_ref, type_ref, type_ref);
+	O2_NODE_KIND(node_type_known_ref, type_known_ref, type_known_ref);
+	O2_NODE_KIND(node_type_pointer_of, type_pointer_of, type_pointer_of);
+	O2_NODE_KIND(node_type_reference_of, type_reference_of, type_reference_of);
+	O2_NODE_KIND(node_type_primitive, type_primitive, type_primitive);
+	O2_NODE_KIND(node_type_complex, type_complex, type_complex);
+	O2_NODE_KIND(node_type_implicit, type_implicit, type_implicit);
+	O2_NODE_KIND(node_type_array, type_array, type_array);
+	O2_NODE_KIND(node_type_complex_field, type_complex_field, type_complex_field);
+	O2_NODE_KIND(node_scope, scope, scope);
+	O2_NODE_KIND(node_module, module, module);
+	O2_NODE_KIND(node_root, root, root);
+	O2_NODE_KIND(node_package, package, package);
+	O2_NODE_KIND(node_var, var, var_last);
+	O2_NODE_KIND(node_var_this, var_this, var_this);
+	O2_NODE_KIND(node_var_const, var_const, var_const);
+	O2_NODE_KIND(node_func, func, func_last);
+	O2_NODE_KIND(node_func_method, func_method, func_method);
+	O2_NODE_KIND(node_op, op, op_last);
+	O2_NODE_KIND(node_op_constant, op_constant, op_constant);
+	O2_NODE_KIND(node_op_unaryop, op_unaryop, op_unaryop);
+	O2_NODE_KIND(node_op_binop, op_binop, op_binop);
+	O2_NODE_KIND(node_op_assign, op_assign, op_assign);
+	O2_NODE_KIND(node_op_callfunc, op_callfunc, op_callfunc);
+	O2_NODE_KIND(node_op_return, op_return, op_return);
+	O2_NODE_KIND(node_ref, ref, ref);
+	O2_NODE_KIND(node_import, import, import);
+	O2_NODE_KIND(node_link, link, link);
+	O2_NODE_KIND(node_attribute, attribute, attribute);
+	O2_NODE_KIND(node_attributes, attributes, attributes);
+	O2_NODE_KIND(node_func_parameters, func_parameters, func_parameters);
+	O2_NODE_KIND(node_func_returns, func_returns, func_returns);
+	O2_NODE_KIND(node_func_body, func_body, func_body);
+	O2_NODE_KIND(node_type_complex_fields, type_complex_fields, type_complex_fields);
+	O2_NODE_KIND(node_type_complex_methods, type_complex_methods, type_complex_methods);
+	O2_NODE_KIND(node_type_complex_inherits, type_complex_inherits, type_complex_inherits);
+	O2_NODE_KIND(node_type_complex_inherit, type_complex_inherit, type_complex_inherit);
+	O2_NODE_KIND(node_type_static_scope, type_static_scope, type_static_scope);
+	O2_NODE_KIND(node_type_static_scope_vars, type_static_scope_vars, type_static_scope_vars);
+	O2_NODE_KIND(node_type_static_scope_funcs, type_static_scope_funcs, type_static_scope_funcs);
+
+#undef O2_NODE_KIND
+}
@@ -19,6 +19,7 @@ namespace o2
 		explicit node_link(const source_code_view& view)
 				: node(view), _link()
 		{
+			set_kind(node_kind::link);
 		}
 
 		~node_link() final;
@@ -38,6 +39,14 @@ namespace o2
 		 */
 		[[nodiscard]] node* get_node() const;
 
+		/**
+		 * \return the link associated with this one; nullptr if the link is broken
+		 */
+		[[nodiscard]] node_link* get_link() const
+		{
+			return _link;
+		}
+
 		/**
 		 * \return a new link associated with this one
 		 */
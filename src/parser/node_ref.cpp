@@ -105,10 +105,10 @@ bool node_ref::resolve_from_parent(node* parent)
 	{
 	public:
 		const int query;
-		const string_view text;
+		const symbol_id text;
 		node_ref* const dest;
 
-		visitor(int query, string_view text, node_ref* dest)
+		visitor(int query, symbol_id text, node_ref* dest)
 				: query(query), text(text), dest(dest)
 		{
 		}
@@ -117,7 +117,7 @@ bool node_ref::resolve_from_parent(node* parent)
 		{
 			if ((query & query_types::package) == query_types::package)
 			{
-				const auto impl = dynamic_cast<node_import*>(n);
+				const auto impl = n->as<node_import>();
 				if (impl && impl->get_alias() == text)
 				{
 					add(impl->get_package());
@@ -127,24 +127,18 @@ bool node_ref::resolve_from_parent(node* parent)
 
 			if ((query & query_types::primitive))
 			{
-				const auto impl = dynamic_cast<node_type_primitive*>(n);
-				if (impl)
+				const auto impl = n->as<node_type_primitive>();
+				if (impl && impl->has_name(text))
 				{
-					for (auto name: impl->get_names())
-					{
-						if (name == text)
-						{
-							add(impl);
-							return;
-						}
-					}
+					add(impl);
+					return;
 				}
 			}
 
 			if ((query & (query_types::arg | query_types::local | query_types::global)) != 0)
 			{
-				const auto impl = dynamic_cast<node_var*>(n);
-				if (impl && impl->get_name() == text)
+				const auto impl = n->as<node_var>();
+				if (impl && impl->get_name_id() == text)
 				{
 					add(impl);
 					return;
@@ -153,8 +147,8 @@ bool node_ref::resolve_from_parent(node* parent)
 
 			if ((query & query_types::type))
 			{
-				const auto impl = dynamic_cast<node_type_complex*>(n);
-				if (impl && impl->get_name() == text)
+				const auto impl = n->as<node_type_complex>();
+				if (impl && impl->get_name_id() == text)
 				{
 					add(impl);
 					return;
@@ -163,8 +157,8 @@ bool node_ref::resolve_from_parent(node* parent)
 
 			if ((query & query_types::func))
 			{
-				const auto impl = dynamic_cast<node_func*>(n);
-				if (impl && impl->get_name() == text)
+				const auto impl = n->as<node_func>();
+				if (impl && impl->get_name_id() == text)
 				{
 					add(impl);
 					return;
@@ -172,6 +166,11 @@ bool node_ref::resolve_from_parent(node* parent)
 			}
 		}
 
+		[[nodiscard]] symbol_id get_query_name() const final
+		{
+			return text;
+		}
+
 		void add(node* n)
 		{
 			for (int i = 0; i < dest->_results.size(); ++i)
@@ -53,9 +53,10 @@ namespace o2
 		 */
 		static constexpr int only_type_chain_types = package | type;
 
-		node_ref(const source_code_view& view, int types, int flags, string_view text)
+		node_ref(const source_code_view& view, int types, int flags, symbol_id text)
 				: node(view), _query_types(types), _query_flags(flags), _text(text)
 		{
+			set_kind(node_kind::ref);
 		}
 
 		/**
@@ -74,10 +75,26 @@ namespace o2
             _query_types = qt;
 		}
 
+		/**
+		 * \return how the query is performed during the resolution phase
+		 */
+		[[nodiscard]] int get_query_flags() const
+		{
+			return _query_flags;
+		}
+
 		/**
 		 * \return the text we are querying
 		 */
 		string_view get_query_text() const
+		{
+			return _text.str();
+		}
+
+		/**
+		 * \return the interned text we are querying
+		 */
+		[[nodiscard]] symbol_id get_query_id() const
 		{
 			return _text;
 		}
@@ -90,6 +107,15 @@ namespace o2
 			return _results;
 		}
 
+		/**
+		 * \brief replace all results. The results are otherwise found when this reference is resolved
+		 * \param results the results
+		 */
+		void set_results(array_view<node*> results)
+		{
+			_results = results;
+		}
+
 #pragma region node
 
 		void debug(debug_ostream& stream, int indent) const final;
@@ -103,7 +129,7 @@ namespace o2
 	private:
 		int _query_types;
         int _query_flags;
-		string_view _text;
+		symbol_id _text;
 		vector<node*> _results;
 	};
 }
\ No newline at end of file
@@ -14,7 +14,7 @@ void node_scope::debug(debug_ostream& stream, int indent) const
 	node_symbol::debug(stream, indent);
 }
 
-string node_scope::get_id() const
+string node_scope::build_id() const
 {
 	stringstream ss;
 	const auto symbol = get_parent_of_type<node_symbol>();
@@ -24,3 +24,15 @@ string node_scope::get_id() const
 	ss << '.';
 	return std::move(ss.str());
 }
+
+node* node_scope::on_child_added(node* n)
+{
+	_symbols.add(n, get_children());
+	return node_symbol::on_child_added(n);
+}
+
+void node_scope::on_child_removed(node* n)
+{
+	node_symbol::on_child_removed(n);
+	_symbols.remove(n);
+}
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "node_symbol.h"
+#include "symbol_table.h"
 
 namespace o2
 {
@@ -16,18 +17,31 @@ namespace o2
 		explicit node_scope(const source_code_view& view)
 				: node_symbol(view)
 		{
+			set_kind(node_kind::scope);
 		}
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const final;
+		[[nodiscard]] string build_id() const final;
 
 #pragma endregion
 
 #pragma region node
 
+		[[nodiscard]] const symbol_table* get_symbol_table() const final
+		{
+			return &_symbols;
+		}
+
 		void debug(debug_ostream& stream, int indent) const final;
 
+		node* on_child_added(node* n) final;
+
+		void on_child_removed(node* n) final;
+
 #pragma endregion
+
+	private:
+		symbol_table _symbols;
 	};
 }
\ No newline at end of file
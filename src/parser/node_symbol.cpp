@@ -13,15 +13,29 @@ bool node_symbol::is_allowed(node* n) const
 	return true;
 }
 
+symbol_id node_symbol::get_id() const
+{
+	auto id = _id.load(std::memory_order_acquire);
+	if (id.valid())
+		return id;
+
+	id = symbol_id::intern(build_id());
+
+	// the id is not allowed to change after the symbol is resolved, so we are free to cache it from now on
+	if (!has_phase_left(phase_resolve))
+		_id.store(id, std::memory_order_release);
+	return id;
+}
+
 void node_symbol::write_json_properties(json& j)
 {
 	node::write_json_properties(j);
-	j.write(json::pair<string_view>{ "id", get_id() });
+	j.write(json::pair<string_view>{ "id", get_id().str() });
 }
 
 node* node_symbol::on_child_added(node* n)
 {
-	const auto a = dynamic_cast<node_attributes*>(n);
+	const auto a = n->as<node_attributes>();
 	if (a)
 		_attributes = a;
 	return n;
@@ -7,6 +7,8 @@
 
 #include "node.h"
 #include "node_attribute.h"
+#include "symbol_id.h"
+#include <atomic>
 
 namespace o2
 {
@@ -48,8 +50,9 @@ namespace o2
 		 * \param accessor whom are allowed to access this symbol
 		 */
 		node_symbol(const source_code_view& view, accessor accessor)
-				: node(view), _accessor(accessor), _attributes()
+				: node(view), _accessor(accessor), _attributes(), _id()
 		{
+			set_kind(node_kind::symbol);
 		}
 
 		/**
@@ -61,9 +64,14 @@ namespace o2
 		}
 
 		/**
+		 * \brief get the unique id for this symbol.
+		 *
+		 * The id is interned and cached the first time it's requested after this symbol is resolved. Before that,
+		 * the id might still change, for example because a type it refers to is not known yet
+		 *
 		 * \return a unique id for this symbol
 		 */
-		[[nodiscard]] virtual string get_id() const = 0;
+		[[nodiscard]] symbol_id get_id() const;
 
 		/**
 		 * \return whom are allowed to access this symbol
@@ -101,7 +109,7 @@ namespace o2
 				if (n == _this || _done)
 					return;
 
-				const auto tt = dynamic_cast<const T*>(n);
+				const auto tt = n->as<T>();
 				if (tt == nullptr)
 					return;
 
@@ -111,6 +119,12 @@ namespace o2
 					_this->add_phases_left(phase_deep_collision_test);
 				}
 			}
+
+			[[nodiscard]] symbol_id get_query_name() const final
+			{
+				// symbols can only collide with other symbols with the same name
+				return _this->get_name_id();
+			}
 		};
 
 		/**
@@ -159,12 +173,17 @@ namespace o2
 				if (n == _this)
 					return;
 
-				const auto tt = dynamic_cast<const T*>(n);
+				const auto tt = n->as<T>();
 				if (tt == nullptr)
 					return;
 
 				_this->deep_test_symbol_collision(tt);
 			}
+
+			[[nodiscard]] symbol_id get_query_name() const final
+			{
+				return _this->get_name_id();
+			}
 		};
 
 		/**
@@ -200,8 +219,16 @@ namespace o2
 
 #pragma endregion
 
+	protected:
+		/**
+		 * \return a newly built unique id for this symbol
+		 */
+		[[nodiscard]] virtual string build_id() const = 0;
+
 	private:
 		accessor _accessor;
 		node_attributes* _attributes;
+		// the cached id. Only set when this symbol is resolved
+		mutable std::atomic<symbol_id> _id;
 	};
 }
@@ -18,7 +18,7 @@ namespace o2
 	public:
 		bool accept(const node* n) override
 		{
-			return dynamic_cast<const T*>(n) != nullptr;
+			return n->is<T>();
 		}
 	};
 
@@ -42,11 +42,13 @@ namespace o2
 		node_op(const source_code_view& view)
 				: node(view), _op_modifiers(modifier_none)
 		{
+			set_kind(node_kind::op);
 		}
 
 		node_op(const source_code_view& view, int modifiers)
 				: node(view), _op_modifiers(modifiers)
 		{
+			set_kind(node_kind::op);
 		}
 
 		/**
@@ -12,6 +12,7 @@ using namespace o2;
 node_op_assign::node_op_assign(const source_code_view& view)
 		: node_op(view), _variable(), _expression()
 {
+	set_kind(node_kind::op_assign);
 }
 
 node_type* node_op_assign::get_type()
@@ -28,14 +29,14 @@ void node_op_assign::debug(debug_ostream& stream, int indent) const
 
 node* node_op_assign::on_child_added(node* n)
 {
-	const auto link = dynamic_cast<node_link*>(n);
+	const auto link = n->as<node_link>();
 	if (link && !link->is_broken())
 	{
-		_variable = dynamic_cast<node_var*>(link->get_node());
+		_variable = link->get_node()->as<node_var>();
 		return n;
 	}
 
-	const auto op = dynamic_cast<node_op*>(n);
+	const auto op = n->as<node_op>();
 	if (op)
 	{
 		_expression = op;
@@ -47,7 +48,7 @@ node* node_op_assign::on_child_added(node* n)
 
 void node_op_assign::on_child_removed(node* n)
 {
-	const auto link = dynamic_cast<node_link*>(n);
+	const auto link = n->as<node_link>();
 	if (link && link->get_node() == _variable)
 	{
 		_variable = nullptr;
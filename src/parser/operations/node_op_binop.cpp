@@ -5,10 +5,7 @@
 
 #include "node_op_binop.h"
 #include "node_op_constant.h"
-#include "../optimizations/primitive_value_compare.h"
-#include "../optimizations/primitive_value_equals.h"
-#include "../optimizations/primitive_value_not_equals.h"
-#include "../optimizations/primitive_value_add.h"
+#include "../optimizations/primitive_value_fold.h"
 
 using namespace o2;
 
@@ -73,6 +70,18 @@ void node_op_binop::debug(debug_ostream& stream, int indent) const
 	case bit_xor:
 		stream << "^";
 		break;
+	case shift_left:
+		stream << "<<";
+		break;
+	case shift_right:
+		stream << ">>";
+		break;
+	case logical_and:
+		stream << "&&";
+		break;
+	case logical_or:
+		stream << "||";
+		break;
 	default:
 		stream << "unknown";
 		break;
@@ -92,61 +101,76 @@ vector<node*> node_optimizer_binop_merge::optimize(node* n)
 	const auto left = static_cast<node_op_binop*>(n)->get_left();
 	const auto right = static_cast<node_op_binop*>(n)->get_right();
 
-	if (dynamic_cast<node_op_constant*>(left) && dynamic_cast<node_op_constant*>(right))
+	if (left->is<node_op_constant>() && right->is<node_op_constant>())
 	{
 		const auto left_const = static_cast<node_op_constant*>(left);
 		const auto right_const = static_cast<node_op_constant*>(right);
 		auto left_value = left_const->get_value();
 		const auto& right_value = right_const->get_value();
 
-		typedef bool (* primitive_value_fn)(primitive_value*, const primitive_value*);
-		primitive_value_fn fn = nullptr;
+		primitive_binop op;
 		switch (static_cast<node_op_binop*>(n)->get_operator())
 		{
 		case node_op_binop::minus:
-			fn = primitive_value_sub;
+			op = primitive_binop::sub;
 			break;
 		case node_op_binop::plus:
-			fn = primitive_value_add;
+			op = primitive_binop::add;
 			break;
 		case node_op_binop::mult:
-			fn = primitive_value_mult;
+			op = primitive_binop::mult;
 			break;
 		case node_op_binop::div:
-			fn = primitive_value_div;
+			op = primitive_binop::div;
 			break;
 		case node_op_binop::equals:
-			fn = primitive_value_equals;
+			op = primitive_binop::equals;
 			break;
 		case node_op_binop::not_equals:
-			fn = primitive_value_not_equals;
+			op = primitive_binop::not_equals;
 			break;
 		case node_op_binop::less_then:
-			fn = primitive_value_less_then;
+			op = primitive_binop::less_then;
 			break;
 		case node_op_binop::less_then_equals:
-			fn = primitive_value_less_equals;
+			op = primitive_binop::less_then_equals;
 			break;
 		case node_op_binop::greater_then:
+			op = primitive_binop::greater_then;
 			break;
 		case node_op_binop::greater_then_equals:
+			op = primitive_binop::greater_then_equals;
 			break;
 		case node_op_binop::bit_and:
+			op = primitive_binop::bit_and;
 			break;
 		case node_op_binop::bit_or:
+			op = primitive_binop::bit_or;
 			break;
 		case node_op_binop::bit_xor:
+			op = primitive_binop::bit_xor;
+			break;
+		case node_op_binop::shift_left:
+			op = primitive_binop::shift_left;
+			break;
+		case node_op_binop::shift_right:
+			op = primitive_binop::shift_right;
+			break;
+		case node_op_binop::logical_and:
+			op = primitive_binop::logical_and;
+			break;
+		case node_op_binop::logical_or:
+			op = primitive_binop::logical_or;
 			break;
 		case node_op_binop::unknown:
 		default:
 			return {};
 		}
 
-		if (fn && fn(&left_value, &right_value))
+		if (primitive_value_fold(op, &left_value, &right_value))
 		{
 			// TODO: Add support for converting the new type into the appropriate
 			auto new_const = o2_new node_op_constant(n->get_source_code(), left_value);
-			count++;
 			return { new_const };
 		}
 	}
@@ -31,6 +31,10 @@ namespace o2
 			bit_and,
 			bit_or,
 			bit_xor,
+			shift_left,
+			shift_right,
+			logical_and,
+			logical_or,
 			unknown
 		};
 
@@ -69,6 +73,14 @@ namespace o2
 				return bit_or;
 			case token_type::bit_xor:
 				return bit_xor;
+			case token_type::shift_left:
+				return shift_left;
+			case token_type::shift_right:
+				return shift_right;
+			case token_type::logical_and:
+				return logical_and;
+			case token_type::logical_or:
+				return logical_or;
 			default:
 				return unknown;
 			}
@@ -77,6 +89,7 @@ namespace o2
 		node_op_binop(const source_code_view& view, op o)
 				: node_op(view), _operator(o)
 		{
+			set_kind(node_kind::op_binop);
 		}
 
 		/**
@@ -116,8 +129,6 @@ namespace o2
 			: public node_op_optimizer<node_op_binop>
 	{
 	public:
-		int count = 0;
-
 		vector<node*> optimize(node* n) final;
 	};
 }
\ No newline at end of file
@@ -50,16 +50,17 @@ void node_op_callfunc::resolve0(const recursion_detector* rd, resolve_state* sta
 	node::resolve0(rd, state);
 
 	// assume that the first child is the node reference
-	auto ref = dynamic_cast<node_ref*>(get_child(0));
-	if (ref == nullptr)
+	const auto first = get_child(0);
+	if (first == nullptr || !first->is<node_ref>())
 		throw expected_child_node(get_source_code(), "node_ref");
+	const auto ref = static_cast<node_ref*>(first);
 
 	// find which reference that fits best. The first child is a node_ref that's used to search for the function itself
 	std::vector<func_lookup> potential_funcs;
 	const auto num_args = get_child_count() - 1;
 	for (auto potential_result: ref->get_result())
 	{
-		const auto func = dynamic_cast<node_func*>(potential_result);
+		const auto func = potential_result->as<node_func>();
 		if (!func)
 			continue;
 
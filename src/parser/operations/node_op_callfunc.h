@@ -21,6 +21,7 @@ namespace o2
 		explicit node_op_callfunc(const source_code_view& view)
 				: node_op(view), _func()
 		{
+			set_kind(node_kind::op_callfunc);
 		}
 
 		/**
@@ -31,6 +32,15 @@ namespace o2
 			return _func;
 		}
 
+		/**
+		 * \brief set the function this operation will call, which is otherwise figured out when resolving it
+		 * \param func the function
+		 */
+		void set_func(node_func* func)
+		{
+			_func = func;
+		}
+
 #pragma region node_op
 
 		node_type* get_type() final;
@@ -78,7 +78,7 @@ void node_op_constant::debug(debug_ostream& stream, int indent) const
 
 node* node_op_constant::on_child_added(node* n)
 {
-	const auto type = dynamic_cast<node_type*>(n);
+	const auto type = n->as<node_type>();
 	if (type)
 		_type = type;
 	return n;
@@ -86,7 +86,7 @@ node* node_op_constant::on_child_added(node* n)
 
 void node_op_constant::on_child_removed(node* n)
 {
-	const auto type = dynamic_cast<node_type*>(n);
+	const auto type = n->as<node_type>();
 	if (type)
 		_type = nullptr;
 }
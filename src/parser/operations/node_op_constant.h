@@ -22,6 +22,7 @@ namespace o2
 		node_op_constant(const source_code_view& view, const primitive_value& value)
 				: node_op(view, modifier_const), _value(value), _type()
 		{
+			set_kind(node_kind::op_constant);
 		}
 
 		/**
@@ -10,6 +10,7 @@ using namespace o2;
 node_op_return::node_op_return(const source_code_view& view)
 		: node_op(view)
 {
+	set_kind(node_kind::op_return);
 }
 
 void node_op_return::debug(debug_ostream& stream, int indent) const
@@ -5,11 +5,7 @@
 
 #include "node_op_unaryop.h"
 #include "node_op_constant.h"
-#include "../optimizations/primitive_value_not.h"
-#include "../optimizations/primitive_value_bit_not.h"
-#include "../optimizations/primitive_value_dec.h"
-#include "../optimizations/primitive_value_inc.h"
-#include "../optimizations/primitive_value_neg.h"
+#include "../optimizations/primitive_value_fold.h"
 
 using namespace o2;
 
@@ -63,49 +59,34 @@ vector<node*> node_optimizer_unaryop_merge::optimize(node* n)
 {
 	const auto right = static_cast<node_op_unaryop*>(n)->get_right();
 
-	if (dynamic_cast<node_op_constant*>(right))
+	if (right->is<node_op_constant>())
 	{
 		const auto right_const = static_cast<node_op_constant*>(right);
 		auto value = right_const->get_value();
 		switch (static_cast<node_op_unaryop*>(n)->get_operator())
 		{
 		case node_op_unaryop::minus:
-			if (primitive_value_neg(&value))
-			{
-				count++;
+			if (primitive_value_fold(primitive_unaryop::neg, &value))
 				return o2_new node_op_constant(n->get_source_code(), value);
-			}
 			else
 				break;
 		case node_op_unaryop::plus:
 			return { right };
 		case node_op_unaryop::inc:
-			if (primitive_value_inc(&value))
-			{
-				count++;
+			if (primitive_value_fold(primitive_unaryop::inc, &value))
 				return o2_new node_op_constant(n->get_source_code(), value);
-			}
 			break;
 		case node_op_unaryop::dec:
-			if (primitive_value_dec(&value))
-			{
-				count++;
+			if (primitive_value_fold(primitive_unaryop::dec, &value))
 				return o2_new node_op_constant(n->get_source_code(), value);
-			}
 			break;
 		case node_op_unaryop::bit_not:
-			if (primitive_value_bit_not(&value))
-			{
-				count++;
+			if (primitive_value_fold(primitive_unaryop::bit_not, &value))
 				return o2_new node_op_constant(n->get_source_code(), value);
-			}
 			break;
 		case node_op_unaryop::not_:
-			if (primitive_value_not(&value))
-			{
-				count++;
+			if (primitive_value_fold(primitive_unaryop::not_, &value))
 				return o2_new node_op_constant(n->get_source_code(), value);
-			}
 			break;
 		case node_op_unaryop::unknown:
 			break;
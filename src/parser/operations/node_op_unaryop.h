@@ -56,6 +56,7 @@ namespace o2
 		node_op_unaryop(const source_code_view& view, op o)
 				: node_op(view), _operator(o)
 		{
+			set_kind(node_kind::op_unaryop);
 		}
 
 		/**
@@ -90,8 +91,6 @@ namespace o2
 			: public node_op_optimizer<node_op_unaryop>
 	{
 	public:
-		int count = 0;
-
 		vector<node*> optimize(node* n) final;
 	};
 }
\ No newline at end of file
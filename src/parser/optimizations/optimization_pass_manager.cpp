@@ -0,0 +1,78 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "optimization_pass_manager.h"
+
+using namespace o2;
+
+namespace
+{
+	// the maximum number of times a replacement is optimized again. Protects against optimizers that keep on
+	// producing nodes that they accept themselves
+	constexpr int max_rewrites_per_node = 64;
+}
+
+optimization_pass_manager::optimization_pass_manager() = default;
+
+void optimization_pass_manager::add(string_view name, node_optimizer* optimizer, node_kind first, node_kind last)
+{
+	const auto stats = _stats.size();
+	_stats.add(optimization_pass_stats{ name, 0, 0 });
+	for (auto k = (int)first; k <= (int)last; ++k)
+		_passes[k].add(registered_pass{ optimizer, stats });
+}
+
+void optimization_pass_manager::optimize(node* root)
+{
+	optimize_children(root);
+}
+
+void optimization_pass_manager::optimize_children(node* n)
+{
+	for (int i = 0; i < n->get_child_count(); ++i)
+	{
+		optimize_children(n->get_child(i));
+
+		// keep on optimizing the node at this position for as long as it's being replaced by a single node
+		for (int j = 0; j < max_rewrites_per_node; ++j)
+		{
+			const auto optimized = rewrite(n->get_child(i));
+			if (optimized.empty())
+				break;
+			if (optimized.size() == 1)
+				delete n->replace_child(i, optimized[0]);
+			else
+			{
+				delete n->replace_children(i, optimized);
+				i--;
+				break;
+			}
+		}
+	}
+}
+
+vector<node*> optimization_pass_manager::rewrite(node* n)
+{
+	for (const auto& pass: _passes[(int)n->get_kind()])
+	{
+		auto& stats = _stats[pass.stats];
+		if (!pass.optimizer->accept(n))
+			continue;
+		stats.visited++;
+		auto optimized = pass.optimizer->optimize(n);
+		if (optimized.empty())
+			continue;
+		stats.rewrites++;
+		return optimized;
+	}
+	return {};
+}
+
+void optimization_pass_manager::debug(debug_ostream& stream) const
+{
+	for (const auto& s: _stats)
+		stream << "optimization pass '" << s.name << "' - " << s.rewrites << " rewrites of " << s.visited
+			   << " visited nodes" << std::endl;
+}
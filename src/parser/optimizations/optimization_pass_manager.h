@@ -0,0 +1,102 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include "../node.h"
+
+namespace o2
+{
+	/**
+	 * \brief statistics for a single optimization pass
+	 */
+	struct optimization_pass_stats
+	{
+		// the name of the pass
+		string_view name;
+		// number of nodes the pass was asked to optimize
+		int visited;
+		// number of nodes the pass replaced
+		int rewrites;
+	};
+
+	/**
+	 * \brief runs all registered optimizers over a tree in a single post-order traversal
+	 *
+	 * Optimizers are registered for the node kinds they are interested in, so each node is only offered to the
+	 * optimizers that can do something with it. Children are always optimized before their parent, which means
+	 * that a parent always sees the result of rewriting its children. A node that's replaced is put back on the
+	 * worklist, so that the replacement is optimized as well
+	 */
+	class optimization_pass_manager
+	{
+	public:
+		optimization_pass_manager();
+
+		/**
+		 * \brief register an optimizer for the supplied node type and all types inheriting from it
+		 * \tparam T the node type
+		 * \param name the name of the pass
+		 * \param optimizer the optimizer. Must outlive this object
+		 */
+		template<class T>
+		void add(string_view name, node_optimizer* optimizer)
+		{
+			add(name, optimizer, node_kind_of<T>::first, node_kind_of<T>::last);
+		}
+
+		/**
+		 * \brief register an optimizer for a range of node kinds
+		 * \param name the name of the pass
+		 * \param optimizer the optimizer. Must outlive this object
+		 * \param first the first node kind
+		 * \param last the last node kind
+		 */
+		void add(string_view name, node_optimizer* optimizer, node_kind first, node_kind last);
+
+		/**
+		 * \brief optimize the supplied node and all of its children
+		 * \param root the node
+		 */
+		void optimize(node* root);
+
+		/**
+		 * \return statistics for all registered passes
+		 */
+		[[nodiscard]] array_view<optimization_pass_stats> get_stats() const
+		{
+			return _stats;
+		}
+
+		/**
+		 * \brief print out the statistics for all registered passes
+		 * \param stream where to put the information into
+		 */
+		void debug(debug_ostream& stream) const;
+
+	private:
+		/**
+		 * \brief optimize all children of the supplied node
+		 */
+		void optimize_children(node* n);
+
+		/**
+		 * \brief offer the supplied node to all optimizers registered for its kind
+		 * \return the nodes that should replace the supplied node. Empty if the node is kept as-is
+		 */
+		vector<node*> rewrite(node* n);
+
+	private:
+		struct registered_pass
+		{
+			node_optimizer* optimizer;
+			// index in the statistics list
+			int stats;
+		};
+
+		vector<optimization_pass_stats> _stats;
+		vector<registered_pass, 2> _passes[(int)node_kind::last + 1];
+	};
+}
@@ -1,18 +0,0 @@
-//
-// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
-// See the LICENSE file in the project root for license terms
-//
-
-#pragma once
-
-#include "../primitive_value.h"
-
-namespace o2
-{
-	/**
-	 * \brief perform bitwise not on the supplied primitive value
-	 * \param rhs
-	 * \return
-	 */
-	bool primitive_value_bit_not(primitive_value* rhs);
-}
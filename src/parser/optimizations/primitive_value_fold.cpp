@@ -0,0 +1,421 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "primitive_value_fold.h"
+#include <array>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+using namespace o2;
+
+namespace
+{
+	constexpr int type_count = (int)primitive_type::count;
+
+	/**
+	 * \brief information on how a primitive type is stored inside a primitive_value
+	 */
+	template<primitive_type T>
+	struct traits;
+
+#define O2_PRIMITIVE_TRAITS(T, Type, Field) \
+    template<> \
+    struct traits<primitive_type::T> \
+    { \
+        typedef Type type; \
+        static type get(const primitive_value& v) { return v.Field; } \
+        static void set(primitive_value* v, type value) { v->u64 = 0; v->Field = value; v->type = primitive_type::T; } \
+    }
+
+	O2_PRIMITIVE_TRAITS(int8, std::int8_t, i8);
+	O2_PRIMITIVE_TRAITS(uint8, std::uint8_t, u8);
+	O2_PRIMITIVE_TRAITS(int16, std::int16_t, i16);
+	O2_PRIMITIVE_TRAITS(uint16, std::uint16_t, u16);
+	O2_PRIMITIVE_TRAITS(int32, std::int32_t, i32);
+	O2_PRIMITIVE_TRAITS(uint32, std::uint32_t, u32);
+	O2_PRIMITIVE_TRAITS(int64, std::int64_t, i64);
+	O2_PRIMITIVE_TRAITS(uint64, std::uint64_t, u64);
+	O2_PRIMITIVE_TRAITS(float32, float, f32);
+	O2_PRIMITIVE_TRAITS(float64, double, f64);
+	O2_PRIMITIVE_TRAITS(bool_, std::int32_t, bool_);
+	O2_PRIMITIVE_TRAITS(ptr, char*, ptr);
+
+#undef O2_PRIMITIVE_TRAITS
+
+	constexpr bool is_integer(primitive_type t)
+	{
+		return t >= primitive_type::int8 && t <= primitive_type::uint64;
+	}
+
+	constexpr bool is_float(primitive_type t)
+	{
+		return t == primitive_type::float32 || t == primitive_type::float64;
+	}
+
+	constexpr bool is_number(primitive_type t)
+	{
+		return is_integer(t) || is_float(t);
+	}
+
+	constexpr bool is_unsigned(primitive_type t)
+	{
+		return t == primitive_type::uint8 || t == primitive_type::uint16 || t == primitive_type::uint32 ||
+			   t == primitive_type::uint64;
+	}
+
+	// the size of an integer type, where int8 and uint8 has rank 1
+	constexpr int rank(primitive_type t)
+	{
+		return ((int)t - (int)primitive_type::int8) / 2 + 1;
+	}
+
+	/**
+	 * \brief the promotion rules. See primitive_type_promote
+	 */
+	constexpr primitive_type promote(primitive_type lhs, primitive_type rhs)
+	{
+		if (lhs == primitive_type::bool_ || rhs == primitive_type::bool_)
+			return lhs == rhs ? primitive_type::bool_ : primitive_type::unknown;
+
+		if (lhs == primitive_type::ptr || rhs == primitive_type::ptr)
+		{
+			if ((lhs == primitive_type::ptr || is_integer(lhs)) && (rhs == primitive_type::ptr || is_integer(rhs)))
+				return primitive_type::ptr;
+			return primitive_type::unknown;
+		}
+
+		if (!is_number(lhs) || !is_number(rhs))
+			return primitive_type::unknown;
+		if (lhs == primitive_type::float64 || rhs == primitive_type::float64)
+			return primitive_type::float64;
+		if (lhs == primitive_type::float32 || rhs == primitive_type::float32)
+			return primitive_type::float32;
+
+		// integers smaller than 32 bits are always promoted to an int32
+		if (rank(lhs) < rank(primitive_type::int32))
+			lhs = primitive_type::int32;
+		if (rank(rhs) < rank(primitive_type::int32))
+			rhs = primitive_type::int32;
+		if (rank(lhs) != rank(rhs))
+			return rank(lhs) > rank(rhs) ? lhs : rhs;
+		return is_unsigned(lhs) ? lhs : rhs;
+	}
+
+	constexpr auto promotion_table = []()
+	{
+		std::array<std::array<primitive_type, type_count>, type_count> table{};
+		for (int l = 0; l < type_count; ++l)
+			for (int r = 0; r < type_count; ++r)
+				table[l][r] = promote((primitive_type)l, (primitive_type)r);
+		return table;
+	}();
+
+	/**
+	 * \brief convert a value of the type S into the type P
+	 */
+	template<primitive_type P, primitive_type S>
+	typename traits<P>::type convert_from(const primitive_value& v)
+	{
+		typedef typename traits<P>::type T;
+		const auto value = traits<S>::get(v);
+		if constexpr (P == S)
+			return value;
+		else if constexpr (P == primitive_type::ptr || S == primitive_type::ptr)
+			return (T)(std::uintptr_t)value;
+		else
+			return (T)value;
+	}
+
+	template<primitive_type P, int... S>
+	constexpr auto make_converters(std::integer_sequence<int, S...>)
+	{
+		typedef typename traits<P>::type (* converter)(const primitive_value&);
+		return std::array<converter, sizeof...(S)>{ &convert_from<P, (primitive_type)(S + 1)>... };
+	}
+
+	/**
+	 * \brief convert the supplied value, no matter what type it is, into the type P
+	 */
+	template<primitive_type P>
+	typename traits<P>::type convert(const primitive_value& v)
+	{
+		// all types except for unknown and count
+		static constexpr auto converters = make_converters<P>(std::make_integer_sequence<int, type_count - 1>());
+		return converters[(int)v.type - 1](v);
+	}
+
+	/**
+	 * \brief integer arithmetic is done using unsigned values, so that an overflow wraps around instead of
+	 *        causing undefined behaviour
+	 */
+	template<class T>
+	using arithmetic_type = typename std::conditional_t<std::is_integral_v<T>, std::make_unsigned<T>,
+			std::type_identity<T>>::type;
+
+	constexpr bool is_applicable(primitive_binop op, primitive_type p)
+	{
+		switch (op)
+		{
+		case primitive_binop::add:
+		case primitive_binop::sub:
+			return is_number(p) || p == primitive_type::ptr;
+		case primitive_binop::mult:
+		case primitive_binop::div:
+			return is_number(p);
+		case primitive_binop::equals:
+		case primitive_binop::not_equals:
+			return is_number(p) || p == primitive_type::ptr || p == primitive_type::bool_;
+		case primitive_binop::less_then:
+		case primitive_binop::less_then_equals:
+		case primitive_binop::greater_then:
+		case primitive_binop::greater_then_equals:
+			return is_number(p) || p == primitive_type::ptr;
+		case primitive_binop::bit_and:
+		case primitive_binop::bit_or:
+		case primitive_binop::bit_xor:
+			return is_integer(p) || p == primitive_type::bool_;
+		case primitive_binop::shift_left:
+		case primitive_binop::shift_right:
+			return is_integer(p);
+		case primitive_binop::logical_and:
+		case primitive_binop::logical_or:
+			return p == primitive_type::bool_;
+		default:
+			return false;
+		}
+	}
+
+	template<primitive_binop Op, primitive_type P>
+	bool fold_binop(primitive_value* lhs, const primitive_value* rhs)
+	{
+		typedef typename traits<P>::type T;
+		const T a = convert<P>(*lhs);
+		const T b = convert<P>(*rhs);
+
+		if constexpr (P == primitive_type::ptr && (Op == primitive_binop::add || Op == primitive_binop::sub))
+		{
+			const auto l = (std::uintptr_t)a;
+			const auto r = (std::uintptr_t)b;
+			traits<P>::set(lhs, (T)(Op == primitive_binop::add ? l + r : l - r));
+		}
+		else if constexpr (Op == primitive_binop::add)
+			traits<P>::set(lhs, (T)((arithmetic_type<T>)a + (arithmetic_type<T>)b));
+		else if constexpr (Op == primitive_binop::sub)
+			traits<P>::set(lhs, (T)((arithmetic_type<T>)a - (arithmetic_type<T>)b));
+		else if constexpr (Op == primitive_binop::mult)
+			traits<P>::set(lhs, (T)((arithmetic_type<T>)a * (arithmetic_type<T>)b));
+		else if constexpr (Op == primitive_binop::div)
+		{
+			if constexpr (is_integer(P))
+			{
+				// leave integer divisions that are not defined for the runtime to deal with
+				if (b == 0)
+					return false;
+				if constexpr (std::is_signed_v<T>)
+				{
+					if (a == std::numeric_limits<T>::min() && b == -1)
+						return false;
+				}
+			}
+			traits<P>::set(lhs, (T)(a / b));
+		}
+		else if constexpr (Op == primitive_binop::equals)
+			traits<primitive_type::bool_>::set(lhs, a == b);
+		else if constexpr (Op == primitive_binop::not_equals)
+			traits<primitive_type::bool_>::set(lhs, a != b);
+		else if constexpr (Op == primitive_binop::less_then)
+			traits<primitive_type::bool_>::set(lhs, a < b);
+		else if constexpr (Op == primitive_binop::less_then_equals)
+			traits<primitive_type::bool_>::set(lhs, a <= b);
+		else if constexpr (Op == primitive_binop::greater_then)
+			traits<primitive_type::bool_>::set(lhs, a > b);
+		else if constexpr (Op == primitive_binop::greater_then_equals)
+			traits<primitive_type::bool_>::set(lhs, a >= b);
+		else if constexpr (Op == primitive_binop::bit_and)
+			traits<P>::set(lhs, (T)(a & b));
+		else if constexpr (Op == primitive_binop::bit_or)
+			traits<P>::set(lhs, (T)(a | b));
+		else if constexpr (Op == primitive_binop::bit_xor)
+			traits<P>::set(lhs, (T)(a ^ b));
+		else if constexpr (Op == primitive_binop::shift_left || Op == primitive_binop::shift_right)
+		{
+			// leave shifts that are not defined for the runtime to deal with
+			if constexpr (std::is_signed_v<T>)
+			{
+				if (b < 0)
+					return false;
+			}
+			if ((std::uint64_t)b >= sizeof(T) * 8)
+				return false;
+			if constexpr (Op == primitive_binop::shift_left)
+				traits<P>::set(lhs, (T)((arithmetic_type<T>)a << b));
+			else
+				traits<P>::set(lhs, (T)(a >> b));
+		}
+		else if constexpr (Op == primitive_binop::logical_and)
+			traits<primitive_type::bool_>::set(lhs, a && b);
+		else if constexpr (Op == primitive_binop::logical_or)
+			traits<primitive_type::bool_>::set(lhs, a || b);
+		return true;
+	}
+
+	typedef bool (* binop_fn)(primitive_value*, const primitive_value*);
+
+	template<primitive_binop Op, primitive_type P>
+	constexpr binop_fn binop_entry()
+	{
+		if constexpr (is_applicable(Op, P))
+			return &fold_binop<Op, P>;
+		else
+			return nullptr;
+	}
+
+	template<primitive_binop Op, int... P>
+	constexpr std::array<binop_fn, type_count> make_binop_row(std::integer_sequence<int, P...>)
+	{
+		return { binop_entry<Op, (primitive_type)P>()... };
+	}
+
+	template<int... Op>
+	constexpr auto make_binop_table(std::integer_sequence<int, Op...>)
+	{
+		return std::array<std::array<binop_fn, type_count>, sizeof...(Op)>{
+				make_binop_row<(primitive_binop)Op>(std::make_integer_sequence<int, type_count>())...
+		};
+	}
+
+	// binary operator functions, indexed by the operator and the promoted type
+	constexpr auto binop_table = make_binop_table(std::make_integer_sequence<int, (int)primitive_binop::count>());
+
+	/**
+	 * \return the type the unary operator is applied on for a value of the type T
+	 */
+	constexpr primitive_type unary_type(primitive_unaryop op, primitive_type t)
+	{
+		switch (op)
+		{
+		case primitive_unaryop::inc:
+		case primitive_unaryop::dec:
+		case primitive_unaryop::not_:
+			return t;
+		default:
+			return promote(t, t);
+		}
+	}
+
+	constexpr bool is_applicable(primitive_unaryop op, primitive_type t)
+	{
+		const auto p = unary_type(op, t);
+		switch (op)
+		{
+		case primitive_unaryop::plus:
+		case primitive_unaryop::neg:
+			return is_number(p);
+		case primitive_unaryop::inc:
+		case primitive_unaryop::dec:
+			return is_number(p) || p == primitive_type::ptr;
+		case primitive_unaryop::bit_not:
+			return is_integer(p);
+		case primitive_unaryop::not_:
+			return is_integer(p) || p == primitive_type::bool_;
+		default:
+			return false;
+		}
+	}
+
+	template<primitive_unaryop Op, primitive_type S>
+	bool fold_unaryop(primitive_value* rhs)
+	{
+		constexpr auto P = unary_type(Op, S);
+		typedef typename traits<P>::type T;
+		const T a = convert_from<P, S>(*rhs);
+
+		if constexpr (Op == primitive_unaryop::plus)
+			traits<P>::set(rhs, a);
+		else if constexpr (Op == primitive_unaryop::neg)
+		{
+			if constexpr (is_integer(P))
+				traits<P>::set(rhs, (T)((arithmetic_type<T>)0 - (arithmetic_type<T>)a));
+			else
+				traits<P>::set(rhs, -a);
+		}
+		else if constexpr (Op == primitive_unaryop::inc)
+		{
+			if constexpr (P == primitive_type::ptr)
+				traits<P>::set(rhs, a + 1);
+			else
+				traits<P>::set(rhs, (T)((arithmetic_type<T>)a + (arithmetic_type<T>)1));
+		}
+		else if constexpr (Op == primitive_unaryop::dec)
+		{
+			if constexpr (P == primitive_type::ptr)
+				traits<P>::set(rhs, a - 1);
+			else
+				traits<P>::set(rhs, (T)((arithmetic_type<T>)a - (arithmetic_type<T>)1));
+		}
+		else if constexpr (Op == primitive_unaryop::bit_not)
+			traits<P>::set(rhs, (T)~a);
+		else if constexpr (Op == primitive_unaryop::not_)
+			traits<primitive_type::bool_>::set(rhs, a == 0);
+		return true;
+	}
+
+	typedef bool (* unaryop_fn)(primitive_value*);
+
+	template<primitive_unaryop Op, primitive_type S>
+	constexpr unaryop_fn unaryop_entry()
+	{
+		if constexpr (is_applicable(Op, S))
+			return &fold_unaryop<Op, S>;
+		else
+			return nullptr;
+	}
+
+	template<primitive_unaryop Op, int... S>
+	constexpr std::array<unaryop_fn, type_count> make_unaryop_row(std::integer_sequence<int, S...>)
+	{
+		return { unaryop_entry<Op, (primitive_type)S>()... };
+	}
+
+	template<int... Op>
+	constexpr auto make_unaryop_table(std::integer_sequence<int, Op...>)
+	{
+		return std::array<std::array<unaryop_fn, type_count>, sizeof...(Op)>{
+				make_unaryop_row<(primitive_unaryop)Op>(std::make_integer_sequence<int, type_count>())...
+		};
+	}
+
+	// unary operator functions, indexed by the operator and the type of the value
+	constexpr auto unaryop_table = make_unaryop_table(
+			std::make_integer_sequence<int, (int)primitive_unaryop::count>());
+}
+
+primitive_type o2::primitive_type_promote(primitive_type lhs, primitive_type rhs)
+{
+	if ((unsigned)lhs >= (unsigned)type_count || (unsigned)rhs >= (unsigned)type_count)
+		return primitive_type::unknown;
+	return promotion_table[(int)lhs][(int)rhs];
+}
+
+bool o2::primitive_value_fold(primitive_binop op, primitive_value* lhs, const primitive_value* rhs)
+{
+	if ((unsigned)op >= (unsigned)primitive_binop::count)
+		return false;
+	const auto fn = binop_table[(int)op][(int)primitive_type_promote(lhs->type, rhs->type)];
+	if (fn == nullptr)
+		return false;
+	return fn(lhs, rhs);
+}
+
+bool o2::primitive_value_fold(primitive_unaryop op, primitive_value* rhs)
+{
+	if ((unsigned)op >= (unsigned)primitive_unaryop::count || (unsigned)rhs->type >= (unsigned)type_count)
+		return false;
+	const auto fn = unaryop_table[(int)op][(int)rhs->type];
+	if (fn == nullptr)
+		return false;
+	return fn(rhs);
+}
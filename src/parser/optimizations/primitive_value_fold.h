@@ -0,0 +1,81 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include "../primitive_value.h"
+
+namespace o2
+{
+	/**
+	 * \brief binary operators that can be folded
+	 */
+	enum class primitive_binop
+	{
+		add,
+		sub,
+		mult,
+		div,
+		equals,
+		not_equals,
+		less_then,
+		less_then_equals,
+		greater_then,
+		greater_then_equals,
+		bit_and,
+		bit_or,
+		bit_xor,
+		shift_left,
+		shift_right,
+		logical_and,
+		logical_or,
+		count
+	};
+
+	/**
+	 * \brief unary operators that can be folded
+	 */
+	enum class primitive_unaryop
+	{
+		plus,
+		neg,
+		inc,
+		dec,
+		bit_not,
+		not_,
+		count
+	};
+
+	/**
+	 * \brief get the type that both sides of a binary operator are converted into before the operator is applied
+	 *
+	 * Integers smaller than 32 bits are promoted to int32. If the two sides are of different size, then the
+	 * largest is used. If they are of the same size, but one of them is unsigned, then the unsigned type is used.
+	 * Floats win over integers, and pointers can only be combined with integers. Booleans can only be
+	 * combined with other booleans.
+	 *
+	 * \param lhs the type on the left-hand side
+	 * \param rhs the type on the right-hand side
+	 * \return the promoted type; primitive_type::unknown if the types can't be combined
+	 */
+	primitive_type primitive_type_promote(primitive_type lhs, primitive_type rhs);
+
+	/**
+	 * \brief fold the supplied binary operator
+	 * \param op the operator
+	 * \param lhs the value on the left-hand side. The result is put in this value
+	 * \param rhs the value on the right-hand side
+	 * \return true if the operator was folded; false if the operator can't be applied on the supplied values
+	 */
+	bool primitive_value_fold(primitive_binop op, primitive_value* lhs, const primitive_value* rhs);
+
+	/**
+	 * \brief fold the supplied unary operator
+	 * \param op the operator
+	 * \param rhs the value the operator is applied on. The result is put in this value
+	 * \return true if the operator was folded; false if the operator can't be applied on the supplied value
+	 */
+	bool primitive_value_fold(primitive_unaryop op, primitive_value* rhs);
+}
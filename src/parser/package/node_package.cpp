@@ -11,23 +11,31 @@
 
 using namespace o2;
 
+node_package::~node_package()
+{
+	// all children must be destroyed before the arena they are allocated in
+	destroy_children();
+}
+
 node* node_package::on_child_added(node* n)
 {
-	const auto nv = dynamic_cast<node_var*>(n);
+	const auto nv = n->as<node_var>();
 	if (nv != nullptr)
 	{
-		if (_variables.contains(nv->get_name()))
+		if (_variables.contains(nv->get_name_id()))
 			throw error_named_symbol_already_declared(get_source_code(), get_name(), n->get_source_code());
-		_variables[nv->get_name()] = nv;
+		_variables[nv->get_name_id()] = nv;
 	}
+	_symbols.add(n, get_children());
 	return n;
 }
 
 void node_package::on_child_removed(node* n)
 {
-	const auto nv = dynamic_cast<node_var*>(n);
+	_symbols.remove(n);
+	const auto nv = n->as<node_var>();
 	if (nv != nullptr)
-		_variables.erase(nv->get_name());
+		_variables.erase(nv->get_name_id());
 }
 
 void node_package::debug(debug_ostream& stream, int indent) const
@@ -46,8 +54,6 @@ void node_package::query(query_node_visitor* visitor, int flags)
 
 	flags = limit_query_flags(flags);
 	query_parents(visitor, flags);
-	if (bit_isset(flags, query_flag_downwards))
-		flags = bit_set(flags, query_flag_children);
 	query_children(visitor, flags);
 }
 
@@ -80,6 +86,20 @@ void node_package::process_phases()
 	// TODO: Add more phases
 }
 
+void node_package::process_package_phases()
+{
+	// the packages waiting for this package are processed by the caller
+	_state.parse.depended_resolves.clear();
+
+	const recursion_detector rd;
+	const recursion_detector rd0(&rd, this);
+	resolve_state state(this);
+
+	for (auto c: get_children())
+		c->process_phase(&rd0, &state, node::phase_resolve);
+	process_phase_resolve_size(&rd0, &state);
+}
+
 void node_package::write_json_properties(json& j)
 {
 	node_symbol::write_json_properties(j);
@@ -108,23 +128,24 @@ void node_package::on_parent_node(node* p)
 	superficial_collision_test(this);
 }
 
-string node_package::get_id() const
+string node_package::build_id() const
 {
 	stringstream ss;
 	const auto symbol = get_parent_of_type<node_symbol>();
 	if (symbol)
 		ss << symbol->get_id();
-	if (!_name.empty())
+	const auto name = get_name();
+	if (!name.empty())
 	{
-		assert(_name[0] == '/');
-		ss << _name;
+		assert(name[0] == '/');
+		ss << name;
 	}
 	return std::move(ss.str());
 }
 
 bool node_package::superficial_test_symbol_collision(const node_package* rhs) const
 {
-	if (get_name() == rhs->get_name())
+	if (get_name_id() == rhs->get_name_id())
 		throw error_named_symbol_already_declared(get_source_code(), get_name(), rhs->get_source_code());
 	return false;
 }
@@ -7,6 +7,8 @@
 
 #include "../node_symbol.h"
 #include "../variables/node_var.h"
+#include "../memory_arena.h"
+#include "../symbol_table.h"
 #include <vector>
 #include <unordered_map>
 
@@ -22,14 +24,35 @@ namespace o2
 	{
 	public:
 		node_package(const source_code_view& view, string_view name)
-				: node_symbol(view), _name(name)
+				: node_symbol(view), _name(symbol_id::intern(name))
 		{
+			set_kind(node_kind::package);
+			// everything in a package is visible to those who are querying it
+			set_query_access_flags(query_access_modifier_passthrough);
+		}
+
+		~node_package() final;
+
+		/**
+		 * \return the arena where all nodes parsed for this package are allocated
+		 */
+		[[nodiscard]] memory_arena* get_arena()
+		{
+			return &_arena;
 		}
 
 		/**
 		 * \return the name of the package
 		 */
 		[[nodiscard]] string_view get_name() const
+		{
+			return _name.str();
+		}
+
+		/**
+		 * \return the interned name of this package
+		 */
+		[[nodiscard]] symbol_id get_name_id() const
 		{
 			return _name;
 		}
@@ -54,13 +77,30 @@ namespace o2
 		void on_resolved_before(node_package* p);
 
 		/**
-		 * \brief start processing all post-parse phases
+		 * \brief start processing all post-parse phases for this package and for the packages that's waiting
+		 *        for this package to be resolved
 		 */
 		void process_phases();
 
+		/**
+		 * \brief process all post-parse phases for this package only
+		 *
+		 * The packages imported by this package must already be processed, unless they are processed by the same
+		 * thread. This allows for packages that don't depend on each other to be processed concurrently
+		 */
+		void process_package_phases();
+
+		/**
+		 * \return true if one or more imports in this package are not loaded yet
+		 */
+		[[nodiscard]] bool has_pending_imports() const
+		{
+			return !_state.parse.pending_imports.empty();
+		}
+
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const override;
+		[[nodiscard]] string build_id() const override;
 
 		bool superficial_test_symbol_collision(const node_package* rhs) const;
 
@@ -68,6 +108,11 @@ namespace o2
 
 #pragma region node
 
+		[[nodiscard]] const symbol_table* get_symbol_table() const final
+		{
+			return &_symbols;
+		}
+
 		void on_parent_node(node* p) final;
 
 		node* on_child_added(node* n) final;
@@ -98,8 +143,10 @@ namespace o2
 		void process_phase_resolve_size(const recursion_detector* rd, resolve_state* state);
 
 	private:
-		const string_view _name;
-		std::unordered_map<string_view, node_var*> _variables;
+		const symbol_id _name;
+		memory_arena _arena;
+		symbol_table _symbols;
+		std::unordered_map<symbol_id, node_var*> _variables;
 
 		// a mutable state that's used during this packages parse, resolve and link phase
 		struct state
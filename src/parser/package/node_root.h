@@ -19,11 +19,12 @@ namespace o2
 		node_root()
 				: node_symbol(source_code_view())
 		{
+			set_kind(node_kind::root);
 		}
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const final
+		[[nodiscard]] string build_id() const final
 		{
 			return { "/" };
 		}
@@ -0,0 +1,125 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "package_graph.h"
+#include "../node_import.h"
+#include <unordered_map>
+#include <algorithm>
+
+using namespace o2;
+
+namespace
+{
+	/**
+	 * \brief collect the packages imported by the supplied node. Imports are chained, so the children of an
+	 *        import are searched as well
+	 */
+	void collect_imports(node* n, const std::unordered_map<node_package*, int>& indices, vector<int>* dest)
+	{
+		for (auto c: n->get_children())
+		{
+			const auto import = c->as<node_import>();
+			if (import == nullptr)
+				continue;
+
+			const auto package = import->find_package();
+			if (package != nullptr)
+			{
+				const auto it = indices.find(package);
+				if (it != indices.end())
+					dest->add_unique(it->second);
+			}
+			collect_imports(import, indices, dest);
+		}
+	}
+
+	/**
+	 * \brief find the strongly connected components using Tarjan's algorithm. A component is found only after
+	 *        all components it depends on are found
+	 */
+	struct components
+	{
+		const std::vector<vector<int>>& imports;
+		std::vector<int> index;
+		std::vector<int> lowlink;
+		std::vector<bool> on_stack;
+		vector<int> stack;
+		int next_index;
+		// the component each package is part of
+		std::vector<int> component;
+		int count;
+
+		explicit components(const std::vector<vector<int>>& imports)
+				: imports(imports), index(imports.size(), -1), lowlink(imports.size()),
+				  on_stack(imports.size()), next_index(), component(imports.size(), -1), count()
+		{
+			for (int i = 0; i < (int)imports.size(); ++i)
+			{
+				if (index[i] == -1)
+					visit(i);
+			}
+		}
+
+		void visit(int v)
+		{
+			index[v] = lowlink[v] = next_index++;
+			stack.add(v);
+			on_stack[v] = true;
+
+			for (auto w: imports[v])
+			{
+				if (index[w] == -1)
+				{
+					visit(w);
+					lowlink[v] = std::min(lowlink[v], lowlink[w]);
+				}
+				else if (on_stack[w])
+					lowlink[v] = std::min(lowlink[v], index[w]);
+			}
+
+			if (lowlink[v] != index[v])
+				return;
+
+			int w;
+			do
+			{
+				w = stack.remove_at(stack.size() - 1);
+				on_stack[w] = false;
+				component[w] = count;
+			} while (w != v);
+			count++;
+		}
+	};
+}
+
+package_graph::package_graph(array_view<node_package*> packages)
+{
+	std::unordered_map<node_package*, int> indices;
+	for (int i = 0; i < packages.size(); ++i)
+		indices[packages[i]] = i;
+
+	std::vector<vector<int>> imports(packages.size());
+	for (int i = 0; i < packages.size(); ++i)
+		collect_imports(packages[i], indices, &imports[i]);
+
+	const components c(imports);
+	_units.resize(c.count);
+	for (int i = 0; i < packages.size(); ++i)
+		_units[c.component[i]].packages.add(packages[i]);
+
+	// connect the units. Imports within the same unit are not dependencies
+	for (int i = 0; i < packages.size(); ++i)
+	{
+		const auto to = c.component[i];
+		for (auto imported: imports[i])
+		{
+			const auto from = c.component[imported];
+			if (from == to || _units[from].dependents.find(to) != -1)
+				continue;
+			_units[from].dependents.add(to);
+			_units[to].dependencies++;
+		}
+	}
+}
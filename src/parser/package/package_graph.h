@@ -0,0 +1,49 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include "node_package.h"
+#include <vector>
+
+namespace o2
+{
+	/**
+	 * \brief the dependencies between packages, built from the imports found in each package
+	 *
+	 * Packages that import each other, directly or indirectly, are put in the same unit. This makes the units
+	 * a directed acyclic graph, which means that a unit can be resolved as soon as all units it depends on are
+	 * resolved. The units are sorted so that a unit always comes after the units it depends on
+	 */
+	class package_graph
+	{
+	public:
+		struct unit
+		{
+			// the packages in this unit, in the same order as they are supplied to the graph
+			vector<node_package*> packages;
+			// the index of the units that depend on this unit
+			vector<int> dependents;
+			// the number of units this unit depends on
+			int dependencies = 0;
+		};
+
+		/**
+		 * \param packages the packages. Imports that refer to packages not in this list are ignored
+		 */
+		explicit package_graph(array_view<node_package*> packages);
+
+		/**
+		 * \return all units
+		 */
+		[[nodiscard]] const std::vector<unit>& get_units() const
+		{
+			return _units;
+		}
+
+	private:
+		std::vector<unit> _units;
+	};
+}
@@ -0,0 +1,1127 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "package_interface.h"
+#include "../parser_state.h"
+#include "../syntax_tree.h"
+#include "../content_hash.h"
+#include "../node_import.h"
+#include "../node_link.h"
+#include "../node_scope.h"
+#include "../node_attribute.h"
+#include "../functions/node_func_body.h"
+#include "../functions/node_func_method.h"
+#include "../variables/node_var_const.h"
+#include "../variables/node_var_this.h"
+#include "../types/node_type_array.h"
+#include "../types/node_type_ref.h"
+#include "../types/node_type_implicit.h"
+#include "../types/node_type_known_ref.h"
+#include "../types/node_type_pointer_of.h"
+#include "../types/node_type_reference_of.h"
+#include "../types/complex/node_type_complex.h"
+#include "../types/complex/node_type_complex_field.h"
+#include "../types/complex/node_type_complex_inherits.h"
+#include "../types/complex/node_type_complex_methods.h"
+#include "../types/static/node_type_static_scope.h"
+#include "../operations/node_op_constant.h"
+#include "../operations/node_op_unaryop.h"
+#include "../operations/node_op_binop.h"
+#include "../operations/node_op_assign.h"
+#include "../operations/node_op_callfunc.h"
+#include "../operations/node_op_return.h"
+#include <unordered_map>
+#include <cstring>
+#include <stdexcept>
+
+using namespace o2;
+
+namespace
+{
+	// the first bytes of all package interfaces
+	constexpr char magic[4] = { 'O', '2', 'P', 'I' };
+
+	// the file index of nodes that are not found in any source code
+	constexpr std::uint32_t no_source = UINT32_MAX;
+
+	// the string index of an invalid symbol id
+	constexpr std::uint32_t no_string = UINT32_MAX;
+
+	// how a reference to another node is written
+	enum class reference : std::uint8_t
+	{
+		// the reference is not set
+		none,
+		// a node in the same package, written as its index in the order the nodes are written
+		local,
+		// a primitive, written as its index in the syntax tree
+		primitive,
+		// a node in another package, written as a symbol path
+		external
+	};
+
+	// all phases a node might have left
+	constexpr int all_phases = node::phase_resolve | node::phase_resolve_size | node_symbol::phase_deep_collision_test;
+
+	/**
+	 * \return the name of the supplied node; an invalid id if the node has no name
+	 */
+	symbol_id get_name(node* n)
+	{
+		switch (n->get_kind())
+		{
+		case node_kind::package:
+			return static_cast<node_package*>(n)->get_name_id();
+		case node_kind::type_complex:
+			return static_cast<node_type_complex*>(n)->get_name_id();
+		case node_kind::type_complex_field:
+			return static_cast<node_type_complex_field*>(n)->get_name_id();
+		case node_kind::var:
+		case node_kind::var_this:
+		case node_kind::var_const:
+			return static_cast<node_var*>(n)->get_name_id();
+		case node_kind::func:
+		case node_kind::func_method:
+			return static_cast<node_func*>(n)->get_name_id();
+		default:
+			return {};
+		}
+	}
+
+	/**
+	 * \brief set one of the references in the supplied node
+	 * \param source the node with the reference
+	 * \param index which of the references
+	 * \param target the node that's referred to
+	 * \return false if the node can't refer to the target
+	 */
+	bool set_reference(node* source, int index, node* target)
+	{
+		switch (source->get_kind())
+		{
+		case node_kind::ref:
+		{
+			const auto ref = static_cast<node_ref*>(source);
+			vector<node*> results;
+			results = ref->get_result();
+			if (index < 0 || index >= results.size())
+				return false;
+			results[index] = target;
+			ref->set_results(results);
+			return true;
+		}
+		case node_kind::op_callfunc:
+		{
+			const auto func = target->as<node_func>();
+			if (func == nullptr)
+				return false;
+			static_cast<node_op_callfunc*>(source)->set_func(func);
+			return true;
+		}
+		default:
+			break;
+		}
+
+		const auto type = target->as<node_type>();
+		if (type == nullptr)
+			return false;
+		switch (source->get_kind())
+		{
+		case node_kind::type_ref:
+			static_cast<node_type_ref*>(source)->set_type(type);
+			return true;
+		case node_kind::type_implicit:
+			static_cast<node_type_implicit*>(source)->set_type(type);
+			return true;
+		case node_kind::type_complex_field:
+			static_cast<node_type_complex_field*>(source)->set_field_type(type);
+			return true;
+		case node_kind::type_complex_inherit:
+			static_cast<node_type_complex_inherit*>(source)->set_inherits_from(type);
+			return true;
+		case node_kind::attribute:
+			static_cast<node_attribute*>(source)->set_attribute_type(type);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/**
+	 * \brief the parser adds some nodes to their parent before the children of the node are parsed. All other nodes
+	 *        are added to their parent when they are complete. The nodes must be created in the same order when
+	 *        they are read, because some nodes verify their children, or search for symbol collisions, when
+	 *        they are added to a parent
+	 */
+	bool is_added_before_children(node_kind kind, const node* parent)
+	{
+		switch (kind)
+		{
+		case node_kind::import:
+		case node_kind::func_parameters:
+		case node_kind::func_returns:
+		case node_kind::type_implicit:
+		case node_kind::type_complex_inherits:
+		case node_kind::type_complex_fields:
+		case node_kind::type_complex_methods:
+		case node_kind::type_static_scope:
+		case node_kind::type_static_scope_vars:
+		case node_kind::type_static_scope_funcs:
+			return true;
+		case node_kind::scope:
+			return parent->is<node_func_body>();
+		default:
+			return false;
+		}
+	}
+
+	/**
+	 * \brief writes the nodes of a package
+	 */
+	class interface_writer
+	{
+	public:
+		explicit interface_writer(array_view<source_code*> sources)
+		{
+			for (int i = 0; i < sources.size(); ++i)
+				_files[sources[i]] = i;
+		}
+
+		/**
+		 * \return true if the children of the supplied package could be written
+		 */
+		bool write(node_package* package, std::string* dest)
+		{
+			// nodes in the same package are referred to by the order they are written in, and a node might refer to
+			// a node that's written after it
+			_indices[package] = 0;
+			add_indices(package);
+			if (!write_children(package))
+				return false;
+
+			dest->append(magic, sizeof(magic));
+			put(dest, package_interface_version);
+			put(dest, (std::uint32_t)_files.size());
+			put(dest, (std::uint32_t)_strings.size());
+			for (auto s: _strings)
+			{
+				put(dest, (std::uint32_t)s.length());
+				dest->append(reinterpret_cast<const char*>(s.data()), s.length() * sizeof(string_literal));
+			}
+			dest->append(_nodes);
+			return true;
+		}
+
+	private:
+		template<typename T>
+		static void put(std::string* dest, T value)
+		{
+			dest->append(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template<typename T>
+		void put(T value)
+		{
+			put(&_nodes, value);
+		}
+
+		void put(symbol_id id)
+		{
+			if (!id.valid())
+			{
+				put(no_string);
+				return;
+			}
+
+			const auto it = _string_indices.find(id);
+			if (it != _string_indices.end())
+			{
+				put(it->second);
+				return;
+			}
+
+			const auto index = (std::uint32_t)_strings.size();
+			_string_indices[id] = index;
+			_strings.add(id.str());
+			put(index);
+		}
+
+		/**
+		 * \brief write the offset of the supplied text, which must be found in the supplied source code
+		 */
+		static bool get_text_offset(const source_code* source, const string_literal* text, std::uint32_t* offset)
+		{
+			if (source == nullptr)
+				return false;
+			const auto src = source->get_text();
+			if (text < src.data() || text > src.data() + src.length())
+				return false;
+			*offset = (std::uint32_t)(text - src.data());
+			return true;
+		}
+
+		void add_indices(const node* n)
+		{
+			for (auto c: n->get_children())
+			{
+				const auto index = (std::uint32_t)_indices.size();
+				_indices[c] = index;
+				add_indices(c);
+			}
+		}
+
+		bool write_children(const node* n)
+		{
+			put((std::uint32_t)n->get_child_count());
+			for (auto c: n->get_children())
+			{
+				if (!write_node(c))
+					return false;
+			}
+			return true;
+		}
+
+		bool write_node(node* n)
+		{
+			const auto& view = n->get_source_code();
+			const auto source = view.get_source_code();
+			std::uint32_t file = no_source;
+			if (source != nullptr)
+			{
+				const auto it = _files.find(source);
+				if (it == _files.end())
+					return false;
+				file = it->second;
+			}
+
+			put((std::uint8_t)n->get_kind());
+			put(file);
+			put((std::uint32_t)view.get_offset());
+			if (!write_properties(n, source))
+				return false;
+			if (!write_children(n))
+				return false;
+			return write_resolved(n);
+		}
+
+		/**
+		 * \brief write the state that's figured out when the node is resolved. It's written after the children,
+		 *        because it's read when the children are added to the node
+		 */
+		bool write_resolved(node* n)
+		{
+			int phases = 0;
+			for (auto phase: { node::phase_resolve, node::phase_resolve_size, node_symbol::phase_deep_collision_test })
+			{
+				if (n->has_phase_left(phase))
+					phases = bit_set(phases, phase);
+			}
+			put((std::uint8_t)phases);
+
+			const auto type = n->as<node_type>();
+			if (type != nullptr)
+				put((std::int32_t)(type->has_known_size() ? type->get_size() : -1));
+
+			switch (n->get_kind())
+			{
+			case node_kind::ref:
+			{
+				const auto results = static_cast<node_ref*>(n)->get_result();
+				put((std::uint32_t)results.size());
+				for (auto r: results)
+				{
+					if (!write_reference(r))
+						return false;
+				}
+				return true;
+			}
+			case node_kind::type_ref:
+			case node_kind::type_implicit:
+				return write_reference(type->get_type());
+			case node_kind::type_complex_field:
+			{
+				const auto field = static_cast<node_type_complex_field*>(n);
+				put((std::int32_t)field->get_size());
+				return write_reference(field->get_field_type());
+			}
+			case node_kind::type_complex_inherit:
+				return write_reference(static_cast<node_type_complex_inherit*>(n)->get_inherits_from());
+			case node_kind::attribute:
+				return write_reference(static_cast<node_attribute*>(n)->get_attribute_type());
+			case node_kind::op_callfunc:
+				return write_reference(static_cast<node_op_callfunc*>(n)->get_func());
+			default:
+				return true;
+			}
+		}
+
+		bool write_reference(node* target)
+		{
+			if (target == nullptr)
+			{
+				put(reference::none);
+				return true;
+			}
+
+			const auto it = _indices.find(target);
+			if (it != _indices.end())
+			{
+				put(reference::local);
+				put(it->second);
+				return true;
+			}
+
+			// primitives are predefined by the syntax tree
+			const auto primitive = target->as<node_type_primitive>();
+			if (primitive != nullptr)
+			{
+				put(reference::primitive);
+				put((std::uint8_t)primitive->get_index());
+				return true;
+			}
+
+			// the path is collected from the node up to the package it's found in
+			vector<package_interface_link::step> path;
+			auto n = target;
+			while (!n->is<node_package>())
+			{
+				const auto parent = n->get_parent();
+				if (parent == nullptr)
+					return false;
+
+				const auto name = get_name(n);
+				int index = 0;
+				for (auto c: parent->get_children())
+				{
+					if (c == n)
+						break;
+					if (get_name(c) == name)
+						index++;
+				}
+				path.add({ name, index });
+				n = parent;
+			}
+
+			put(reference::external);
+			put(static_cast<node_package*>(n)->get_id());
+			put((std::uint32_t)path.size());
+			for (int i = path.size() - 1; i >= 0; --i)
+			{
+				put(path[i].name);
+				put((std::uint32_t)path[i].index);
+			}
+			return true;
+		}
+
+		bool write_properties(node* n, const source_code* source)
+		{
+			switch (n->get_kind())
+			{
+			case node_kind::ref:
+			{
+				const auto ref = static_cast<node_ref*>(n);
+				put((std::int32_t)ref->get_query_types());
+				put((std::int32_t)ref->get_query_flags());
+				put(ref->get_query_id());
+				return true;
+			}
+			case node_kind::import:
+			{
+				const auto import = static_cast<node_import*>(n);
+				const auto statement = import->get_import_statement();
+				std::uint32_t offset;
+				if (!get_text_offset(source, statement.data(), &offset))
+					return false;
+				put(offset);
+				put((std::uint32_t)statement.length());
+				put(import->get_alias());
+				return true;
+			}
+			case node_kind::link:
+			{
+				// the first link of a pair is given an index, which the second link refers to
+				const auto link = static_cast<node_link*>(n);
+				if (link->is_broken())
+					return false;
+				const auto it = _links.find(link->get_link());
+				if (it == _links.end())
+				{
+					const auto index = (std::uint32_t)_links.size();
+					_links[link] = index;
+					put((std::uint8_t)0);
+				}
+				else
+				{
+					put((std::uint8_t)1);
+					put(it->second);
+				}
+				return true;
+			}
+			case node_kind::func:
+			{
+				const auto func = static_cast<node_func*>(n);
+				int modifiers = 0;
+				if (func->is_const())
+					modifiers = bit_set(modifiers, node_func::modifier_const);
+				if (func->is_extern())
+					modifiers = bit_set(modifiers, node_func::modifier_extern);
+				put(func->get_name_id());
+				put((std::uint8_t)modifiers);
+				put((std::int32_t)func->get_query_access_modifiers());
+				return true;
+			}
+			case node_kind::func_method:
+				put(static_cast<node_func_method*>(n)->get_name_id());
+				return true;
+			case node_kind::func_body:
+				put((std::int32_t)static_cast<node_func_body*>(n)->get_deferred_end());
+				return true;
+			case node_kind::var:
+			{
+				const auto var = static_cast<node_var*>(n);
+				put(var->get_name_id());
+				put((std::int32_t)var->get_modifiers());
+				return true;
+			}
+			case node_kind::var_this:
+			case node_kind::var_const:
+				put(static_cast<node_var*>(n)->get_name_id());
+				return true;
+			case node_kind::type_known_ref:
+			{
+				// primitives are predefined by the syntax tree, so they are referred to by their index
+				const auto type = static_cast<node_type_known_ref*>(n)->get_type();
+				const auto primitive = type != nullptr ? type->as<node_type_primitive>() : nullptr;
+				if (primitive == nullptr)
+					return false;
+				put((std::uint8_t)primitive->get_index());
+				return true;
+			}
+			case node_kind::type_array:
+				put((std::int32_t)static_cast<node_type_array*>(n)->get_array_count());
+				return true;
+			case node_kind::type_complex:
+			{
+				const auto type = static_cast<node_type_complex*>(n);
+				put(type->get_name_id());
+				put((std::uint8_t)type->get_comple_type());
+				return true;
+			}
+			case node_kind::type_complex_field:
+				put(static_cast<node_type_complex_field*>(n)->get_name_id());
+				return true;
+			case node_kind::op_constant:
+				return write_value(static_cast<node_op_constant*>(n)->get_value(), source);
+			case node_kind::op_unaryop:
+				put((std::uint8_t)static_cast<node_op_unaryop*>(n)->get_operator());
+				return true;
+			case node_kind::op_binop:
+				put((std::uint8_t)static_cast<node_op_binop*>(n)->get_operator());
+				return true;
+			case node_kind::attribute:
+			case node_kind::attributes:
+			case node_kind::scope:
+			case node_kind::func_parameters:
+			case node_kind::func_returns:
+			case node_kind::op_assign:
+			case node_kind::op_callfunc:
+			case node_kind::op_return:
+			case node_kind::type_ref:
+			case node_kind::type_pointer_of:
+			case node_kind::type_reference_of:
+			case node_kind::type_implicit:
+			case node_kind::type_complex_fields:
+			case node_kind::type_complex_methods:
+			case node_kind::type_complex_inherits:
+			case node_kind::type_complex_inherit:
+			case node_kind::type_static_scope:
+			case node_kind::type_static_scope_vars:
+			case node_kind::type_static_scope_funcs:
+				return true;
+			default:
+				// nodes that are never created by the parser
+				return false;
+			}
+		}
+
+		bool write_value(const primitive_value& value, const source_code* source)
+		{
+			put((std::uint8_t)value.type);
+			switch (value.type)
+			{
+			case primitive_type::int8:
+				put((std::int64_t)value.i8);
+				return true;
+			case primitive_type::uint8:
+				put((std::uint64_t)value.u8);
+				return true;
+			case primitive_type::int16:
+				put((std::int64_t)value.i16);
+				return true;
+			case primitive_type::uint16:
+				put((std::uint64_t)value.u16);
+				return true;
+			case primitive_type::int32:
+				put((std::int64_t)value.i32);
+				return true;
+			case primitive_type::uint32:
+				put((std::uint64_t)value.u32);
+				return true;
+			case primitive_type::int64:
+				put(value.i64);
+				return true;
+			case primitive_type::uint64:
+				put(value.u64);
+				return true;
+			case primitive_type::float32:
+				put(value.f32);
+				return true;
+			case primitive_type::float64:
+				put(value.f64);
+				return true;
+			case primitive_type::bool_:
+				put((std::int64_t)value.bool_);
+				return true;
+			case primitive_type::ptr:
+			{
+				// constant strings point to the source code
+				std::uint32_t offset;
+				if (!get_text_offset(source, value.ptr, &offset))
+					return false;
+				put(offset);
+				return true;
+			}
+			default:
+				return false;
+			}
+		}
+
+	private:
+		std::unordered_map<const source_code*, std::uint32_t> _files;
+		std::unordered_map<symbol_id, std::uint32_t> _string_indices;
+		vector<string_view> _strings;
+		std::unordered_map<const node_link*, std::uint32_t> _links;
+		std::unordered_map<const node*, std::uint32_t> _indices;
+		std::string _nodes;
+	};
+
+	/**
+	 * \brief reads the nodes of a package. A std::runtime_error is raised if the package interface is corrupt
+	 */
+	class interface_reader
+	{
+	public:
+		interface_reader(std::string_view bytes, array_view<source_code*> sources, parser_state* state,
+				vector<package_interface_link>* links)
+				: _pos(bytes.data()), _end(bytes.data() + bytes.length()), _sources(sources), _state(state),
+				  _package_links(links)
+		{
+		}
+
+		/**
+		 * \return true if the package interface is written for the supplied source code
+		 */
+		bool read_header()
+		{
+			if (_end - _pos < (std::ptrdiff_t)sizeof(magic) || std::memcmp(_pos, magic, sizeof(magic)) != 0)
+				return false;
+			_pos += sizeof(magic);
+			if (get<std::uint32_t>() != package_interface_version)
+				return false;
+			if (get<std::uint32_t>() != (std::uint32_t)_sources.size())
+				return false;
+
+			const auto strings_count = get<std::uint32_t>();
+			for (std::uint32_t i = 0; i < strings_count; ++i)
+			{
+				const auto length = get<std::uint32_t>();
+				if ((std::size_t)(_end - _pos) < length * sizeof(string_literal))
+					throw std::runtime_error("unexpected end of the package interface");
+				string s(length, 0);
+				get_bytes(s.data(), length * sizeof(string_literal));
+				_strings.add(symbol_id::intern(s));
+			}
+			return true;
+		}
+
+		/**
+		 * \brief read all children of the supplied package
+		 */
+		void read(node_package* package)
+		{
+			_nodes.add(package);
+			read_children(package);
+			if (_pos != _end)
+				throw std::runtime_error("unexpected data at the end of the package interface");
+
+			// all nodes in the package are known now
+			for (const auto& r: _local_references)
+			{
+				if (r.target >= (std::uint32_t)_nodes.size() ||
+					!set_reference(r.source, r.index, _nodes[(int)r.target]))
+					throw std::runtime_error("invalid reference in the package interface");
+			}
+		}
+
+		/**
+		 * \return all imports read
+		 */
+		[[nodiscard]] array_view<node_import*> get_imports() const
+		{
+			return _imports;
+		}
+
+	private:
+		void get_bytes(void* dest, std::size_t size)
+		{
+			if ((std::size_t)(_end - _pos) < size)
+				throw std::runtime_error("unexpected end of the package interface");
+			std::memcpy(dest, _pos, size);
+			_pos += size;
+		}
+
+		template<typename T>
+		T get()
+		{
+			T value;
+			get_bytes(&value, sizeof(T));
+			return value;
+		}
+
+		symbol_id get_id()
+		{
+			const auto index = get<std::uint32_t>();
+			if (index == no_string)
+				return {};
+			if (index >= (std::uint32_t)_strings.size())
+				throw std::runtime_error("invalid string in the package interface");
+			return _strings[(int)index];
+		}
+
+		/**
+		 * \return a pointer to the text, at the supplied offset, in the supplied source code
+		 */
+		static const string_literal* get_text(const source_code* source, std::uint32_t offset, std::uint32_t length)
+		{
+			if (source == nullptr)
+				throw std::runtime_error("text without source code in the package interface");
+			const auto text = source->get_text();
+			if ((std::uint64_t)offset + length > text.length())
+				throw std::runtime_error("invalid text in the package interface");
+			return text.data() + offset;
+		}
+
+		void read_children(node* parent)
+		{
+			const auto count = get<std::uint32_t>();
+			for (std::uint32_t i = 0; i < count; ++i)
+				read_node(parent);
+		}
+
+		void read_node(node* parent)
+		{
+			const auto kind = (node_kind)get<std::uint8_t>();
+			const auto file = get<std::uint32_t>();
+			const auto offset = get<std::uint32_t>();
+			const source_code* source = nullptr;
+			if (file != no_source)
+			{
+				if (file >= (std::uint32_t)_sources.size())
+					throw std::runtime_error("invalid source code in the package interface");
+				source = _sources[(int)file];
+			}
+
+			auto guard = memory_guard(create_node(kind, source_code_view(source, (int)offset), source));
+			const auto n = guard.get();
+			_nodes.add(n);
+			if (n->is<node_import>())
+				_imports.add(static_cast<node_import*>(n));
+
+			// methods refer to the type they are part of
+			const auto type = n->as<node_type_complex>();
+			if (type != nullptr)
+				_types.add(type);
+
+			if (is_added_before_children(kind, parent))
+			{
+				parent->add_child(guard.done());
+				read_children(n);
+			}
+			else
+			{
+				read_children(n);
+				parent->add_child(guard.done());
+			}
+
+			if (type != nullptr)
+				_types.remove_at(_types.size() - 1);
+			read_resolved(n);
+		}
+
+		void read_resolved(node* n)
+		{
+			const auto phases = (int)get<std::uint8_t>();
+			n->remove_phases_left(all_phases);
+			n->add_phases_left(phases & all_phases);
+
+			const auto type = n->as<node_type>();
+			if (type != nullptr)
+				type->set_size(get<std::int32_t>());
+
+			switch (n->get_kind())
+			{
+			case node_kind::ref:
+			{
+				const auto count = get<std::uint32_t>();
+				if ((std::size_t)(_end - _pos) < count)
+					throw std::runtime_error("unexpected end of the package interface");
+				vector<node*> results;
+				results.resize((int)count);
+				for (std::uint32_t i = 0; i < count; ++i)
+					results[(int)i] = nullptr;
+				static_cast<node_ref*>(n)->set_results(results);
+				for (std::uint32_t i = 0; i < count; ++i)
+					read_reference(n, (int)i);
+				break;
+			}
+			case node_kind::type_complex_field:
+				static_cast<node_type_complex_field*>(n)->set_size(get<std::int32_t>());
+				read_reference(n, 0);
+				break;
+			case node_kind::type_ref:
+			case node_kind::type_implicit:
+			case node_kind::type_complex_inherit:
+			case node_kind::attribute:
+			case node_kind::op_callfunc:
+				read_reference(n, 0);
+				break;
+			default:
+				break;
+			}
+		}
+
+		void read_reference(node* source, int index)
+		{
+			switch ((reference)get<std::uint8_t>())
+			{
+			case reference::none:
+				return;
+			case reference::local:
+				// the node might not be read yet
+				_local_references.add({ source, index, get<std::uint32_t>() });
+				return;
+			case reference::primitive:
+			{
+				const auto primitive = _state->get_syntax_tree()->get_primitive(get<std::uint8_t>());
+				if (primitive == nullptr || !set_reference(source, index, primitive))
+					throw std::runtime_error("invalid primitive in the package interface");
+				return;
+			}
+			case reference::external:
+			{
+				package_interface_link link{ source, index, get_id(), {}};
+				const auto count = get<std::uint32_t>();
+				if ((std::size_t)(_end - _pos) < count)
+					throw std::runtime_error("unexpected end of the package interface");
+				for (std::uint32_t i = 0; i < count; ++i)
+				{
+					const auto name = get_id();
+					link.path.add({ name, (int)get<std::uint32_t>() });
+				}
+				_package_links->add(std::move(link));
+				return;
+			}
+			default:
+				throw std::runtime_error("invalid reference in the package interface");
+			}
+		}
+
+		node* create_node(node_kind kind, const source_code_view& view, const source_code* source)
+		{
+			switch (kind)
+			{
+			case node_kind::ref:
+			{
+				const auto types = get<std::int32_t>();
+				const auto flags = get<std::int32_t>();
+				return o2_new node_ref(view, types, flags, get_id());
+			}
+			case node_kind::import:
+			{
+				const auto offset = get<std::uint32_t>();
+				const auto length = get<std::uint32_t>();
+				const string_view statement(get_text(source, offset, length), length);
+				return o2_new node_import(view, statement, get_id());
+			}
+			case node_kind::link:
+			{
+				if (get<std::uint8_t>() == 0)
+				{
+					const auto link = o2_new node_link(view);
+					_links.add(link);
+					return link;
+				}
+				const auto index = get<std::uint32_t>();
+				if (index >= (std::uint32_t)_links.size())
+					throw std::runtime_error("invalid link in the package interface");
+				return _links[(int)index]->new_link();
+			}
+			case node_kind::func:
+			{
+				const auto name = get_id();
+				const auto modifiers = (int)get<std::uint8_t>();
+				const auto access_modifiers = get<std::int32_t>();
+				node_func* func;
+				if (bit_isset(modifiers, node_func::modifier_const))
+					func = o2_new node_func(view, name, node_func::const_function{});
+				else if (bit_isset(modifiers, node_func::modifier_extern))
+					func = o2_new node_func(view, name, node_func::extern_function{});
+				else
+					func = o2_new node_func(view, name);
+				func->set_query_access_flags(access_modifiers);
+				return func;
+			}
+			case node_kind::func_method:
+				return o2_new node_func_method(view, get_id());
+			case node_kind::func_body:
+			{
+				const auto body = o2_new node_func_body(view);
+				body->set_deferred_end(get<std::int32_t>());
+				return body;
+			}
+			case node_kind::func_parameters:
+				return o2_new node_func_parameters(view);
+			case node_kind::func_returns:
+				return o2_new node_func_returns(view);
+			case node_kind::var:
+			{
+				const auto name = get_id();
+				return o2_new node_var(view, name, get<std::int32_t>());
+			}
+			case node_kind::var_this:
+			{
+				if (_types.empty())
+					throw std::runtime_error("this outside of a type in the package interface");
+				return o2_new node_var_this(view, get_id(), _types[_types.size() - 1]);
+			}
+			case node_kind::var_const:
+				return o2_new node_var_const(view, get_id());
+			case node_kind::type_ref:
+				return o2_new node_type_ref(view);
+			case node_kind::type_known_ref:
+			{
+				const auto primitive = _state->get_syntax_tree()->get_primitive(get<std::uint8_t>());
+				if (primitive == nullptr)
+					throw std::runtime_error("invalid primitive in the package interface");
+				return o2_new node_type_known_ref(view, primitive);
+			}
+			case node_kind::type_pointer_of:
+				return o2_new node_type_pointer_of(view);
+			case node_kind::type_reference_of:
+				return o2_new node_type_reference_of(view);
+			case node_kind::type_implicit:
+				return o2_new node_type_implicit(view);
+			case node_kind::type_array:
+				return o2_new node_type_array(view, get<std::int32_t>());
+			case node_kind::type_complex:
+			{
+				const auto type = o2_new node_type_complex(view, get_id());
+				type->set_complex_type((complex_type)get<std::uint8_t>());
+				return type;
+			}
+			case node_kind::type_complex_field:
+				return o2_new node_type_complex_field(view, get_id());
+			case node_kind::type_complex_fields:
+				return o2_new node_type_complex_fields(view);
+			case node_kind::type_complex_methods:
+				return o2_new node_type_complex_methods(view);
+			case node_kind::type_complex_inherits:
+				return o2_new node_type_complex_inherits(view);
+			case node_kind::type_complex_inherit:
+				return o2_new node_type_complex_inherit(view);
+			case node_kind::type_static_scope:
+				return o2_new node_type_static_scope(view);
+			case node_kind::type_static_scope_vars:
+				return o2_new node_type_static_scope_vars(view);
+			case node_kind::type_static_scope_funcs:
+				return o2_new node_type_static_scope_funcs(view);
+			case node_kind::attribute:
+				return o2_new node_attribute(view);
+			case node_kind::attributes:
+				return o2_new node_attributes(view);
+			case node_kind::scope:
+				return o2_new node_scope(view);
+			case node_kind::op_constant:
+				return o2_new node_op_constant(view, read_value(source));
+			case node_kind::op_unaryop:
+				return o2_new node_op_unaryop(view, (node_op_unaryop::op)get<std::uint8_t>());
+			case node_kind::op_binop:
+				return o2_new node_op_binop(view, (node_op_binop::op)get<std::uint8_t>());
+			case node_kind::op_assign:
+				return o2_new node_op_assign(view);
+			case node_kind::op_callfunc:
+				return o2_new node_op_callfunc(view);
+			case node_kind::op_return:
+				return o2_new node_op_return(view);
+			default:
+				throw std::runtime_error("unknown node in the package interface");
+			}
+		}
+
+		primitive_value read_value(const source_code* source)
+		{
+			primitive_value value{};
+			value.type = (primitive_type)get<std::uint8_t>();
+			switch (value.type)
+			{
+			case primitive_type::int8:
+				value.i8 = (std::int8_t)get<std::int64_t>();
+				break;
+			case primitive_type::uint8:
+				value.u8 = (std::uint8_t)get<std::uint64_t>();
+				break;
+			case primitive_type::int16:
+				value.i16 = (std::int16_t)get<std::int64_t>();
+				break;
+			case primitive_type::uint16:
+				value.u16 = (std::uint16_t)get<std::uint64_t>();
+				break;
+			case primitive_type::int32:
+				value.i32 = (std::int32_t)get<std::int64_t>();
+				break;
+			case primitive_type::uint32:
+				value.u32 = (std::uint32_t)get<std::uint64_t>();
+				break;
+			case primitive_type::int64:
+				value.i64 = get<std::int64_t>();
+				break;
+			case primitive_type::uint64:
+				value.u64 = get<std::uint64_t>();
+				break;
+			case primitive_type::float32:
+				value.f32 = get<float>();
+				break;
+			case primitive_type::float64:
+				value.f64 = get<double>();
+				break;
+			case primitive_type::bool_:
+				value.bool_ = (std::int32_t)get<std::int64_t>();
+				break;
+			case primitive_type::ptr:
+				value.ptr = const_cast<string_literal*>(get_text(source, get<std::uint32_t>(), 0));
+				break;
+			default:
+				throw std::runtime_error("invalid constant in the package interface");
+			}
+			return value;
+		}
+
+	private:
+		const char* _pos;
+		const char* const _end;
+		const array_view<source_code*> _sources;
+		parser_state* const _state;
+		vector<package_interface_link>* const _package_links;
+		vector<symbol_id> _strings;
+		vector<node_link*> _links;
+		vector<node_type*> _types;
+		vector<node_import*> _imports;
+
+		struct local_reference
+		{
+			node* source;
+			int index;
+			std::uint32_t target;
+		};
+		// all nodes in the order they are read
+		vector<node*> _nodes;
+		vector<local_reference> _local_references;
+	};
+
+	/**
+	 * \return the child, of the supplied node, found at the supplied step in a symbol path
+	 */
+	node* find_child(node* n, const package_interface_link::step& step)
+	{
+		int index = 0;
+		for (auto c: n->get_children())
+		{
+			if (get_name(c) != step.name)
+				continue;
+			if (index == step.index)
+				return c;
+			index++;
+		}
+		return nullptr;
+	}
+}
+
+std::uint64_t o2::hash_package_sources(array_view<source_code*> sources, string_view package_name)
+{
+	// the number of node kinds is part of the hash, which makes sure that package interfaces written before a new
+	// kind of node is added are not used
+	content_hash hash;
+	hash.add(package_interface_version);
+	hash.add((std::uint64_t)node_kind::last);
+	hash.add(package_name);
+	hash.add((std::uint64_t)sources.size());
+	for (auto s: sources)
+		hash.add(s->get_text());
+	return hash.get();
+}
+
+bool o2::write_package_interface(node_package* package, array_view<source_code*> sources, std::string* dest)
+{
+	interface_writer writer(sources);
+	return writer.write(package, dest);
+}
+
+node_package* o2::read_package_interface(std::string_view bytes, array_view<source_code*> sources,
+		string_view package_name, parser_state* state, vector<package_interface_link>* links)
+{
+	assert(state != nullptr && "a state is expected");
+	assert(links != nullptr && "a destination for the links is expected");
+
+	try
+	{
+		vector<package_interface_link> package_links;
+		interface_reader reader(bytes, sources, state, &package_links);
+		if (!reader.read_header())
+			return nullptr;
+
+		auto package = o2_new node_package(source_code_view(), package_name);
+		auto guard = memory_guard(package);
+		{
+			const memory_arena_scope arena_scope(package->get_arena());
+			reader.read(package);
+		}
+
+		// the imports are added when the package is complete, so that the state never refers to deleted imports
+		for (auto import: reader.get_imports())
+			state->add_import(import);
+		for (auto& l: package_links)
+			links->add(std::move(l));
+		return guard.done();
+	}
+	catch (const std::exception&)
+	{
+		// a corrupt package interface is treated as if it doesn't exist
+		return nullptr;
+	}
+}
+
+bool o2::link_package_interface(array_view<package_interface_link> links,
+		const std::function<node_package*(symbol_id)>& find_package)
+{
+	for (const auto& l: links)
+	{
+		node* n = find_package(l.package);
+		for (int i = 0; i < l.path.size() && n != nullptr; ++i)
+			n = find_child(n, l.path[i]);
+		if (n == nullptr || !set_reference(l.source, l.index, n))
+			return false;
+	}
+	return true;
+}
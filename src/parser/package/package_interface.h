@@ -0,0 +1,94 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include "node_package.h"
+#include "../source_code.h"
+#include <cstdint>
+#include <functional>
+
+namespace o2
+{
+	class parser_state;
+
+	/**
+	 * \brief the version of the package interface format. Must be increased when the format, or how a node is
+	 *        written, is changed
+	 */
+	static constexpr std::uint32_t package_interface_version = 2;
+
+	/**
+	 * \brief a reference, from a node read from a package interface, to a node in another package
+	 *
+	 * Nodes in other packages are written as a symbol path: the id of the package and, for each node from the
+	 * package down to the referred node, its name and its index among the children with the same name. The
+	 * reference is linked when the other package is loaded
+	 */
+	struct package_interface_link
+	{
+		struct step
+		{
+			// the name of the node. Invalid if the node has no name
+			symbol_id name;
+			// the index of the node among the children with the same name
+			int index;
+		};
+
+		// the node with the reference
+		node* source;
+		// which of the references in the node. Only node_ref has more than one
+		int index;
+		// the id of the package where the referred node is found
+		symbol_id package;
+		// the path from the package to the referred node
+		vector<step> path;
+	};
+
+	/**
+	 * \brief hash the source code of a package
+	 * \param sources the source code of the package
+	 * \param package_name the name of the package
+	 * \return the hash
+	 */
+	std::uint64_t hash_package_sources(array_view<source_code*> sources, string_view package_name);
+
+	/**
+	 * \brief write a package into a package interface
+	 * \param package the package
+	 * \param sources the source code the package is parsed from
+	 * \param dest where the bytes are put
+	 * \return true if successful; false if one or more nodes in the package can't be written
+	 *
+	 * A package interface is a compact, binary representation of the package. Reading it back creates the
+	 * same nodes, in the same order, as parsing the source code does, which is a lot faster than lexing and
+	 * parsing the source code again. The state figured out when resolving the package, such as the sizes of
+	 * the types and what each reference refers to, is part of the package interface, so a resolved package is
+	 * read back resolved
+	 */
+	bool write_package_interface(node_package* package, array_view<source_code*> sources, std::string* dest);
+
+	/**
+	 * \brief read a package from a package interface
+	 * \param bytes the package interface
+	 * \param sources the source code the package is parsed from. The nodes refer to it
+	 * \param package_name the name of the package
+	 * \param state the parser state. Imports found in the package are added to it
+	 * \param links where the references to nodes in other packages are put. They must be linked before the
+	 *        package is used
+	 * \return the package; nullptr if the package interface is invalid
+	 */
+	node_package* read_package_interface(std::string_view bytes, array_view<source_code*> sources,
+			string_view package_name, parser_state* state, vector<package_interface_link>* links);
+
+	/**
+	 * \brief link the references, read from a package interface, to the nodes in other packages
+	 * \param links the references
+	 * \param find_package get the package with the supplied id; nullptr if the package is not loaded
+	 * \return true if all nodes are found
+	 */
+	bool link_package_interface(array_view<package_interface_link> links,
+			const std::function<node_package*(symbol_id)>& find_package);
+}
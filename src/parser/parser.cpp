@@ -5,7 +5,8 @@
 
 #include "parser.h"
 #include "parser_scope.h"
-#include "token.h"
+#include "token_buffer.h"
+#include "literal.h"
 #include "types/node_type_array.h"
 #include "types/node_type_ref.h"
 #include "functions/node_func_parameters.h"
@@ -18,6 +19,9 @@
 #include "variables/node_var_const.h"
 #include "operations/node_op_callfunc.h"
 #include "types/node_type_known_ref.h"
+#include "node_import.h"
+#include <array>
+#include <exception>
 
 using namespace o2;
 
@@ -51,6 +55,26 @@ namespace
 		return o2_new node_type_known_ref(ps->get_view(), type);
 	}
 
+	/**
+	 * \brief decode the current token using the supplied literal decoder
+	 * \throws error_constant_out_of_range if the value doesn't fit in the type
+	 */
+	template<typename T>
+	T decode_constant(const parser_scope* ps, literal_status (* decode)(string_view, T*))
+	{
+		const auto t = ps->t;
+		T value{};
+		switch (decode(t->value(), &value))
+		{
+		case literal_status::ok:
+			return value;
+		case literal_status::out_of_range:
+			throw error_constant_out_of_range(ps->get_view(), t);
+		default:
+			throw error_expected_constant(ps->get_view(), t);
+		}
+	}
+
 	node_op_constant* parse_op_constant(const parser_scope* ps)
 	{
 		const auto t = ps->t;
@@ -61,7 +85,7 @@ namespace
 		case token_type::number:
 			if (t->is_modifier(token_modifier::hint_unsigned))
 			{
-				const auto value = t->value_uint64();
+				const auto value = decode_constant(ps, literal_decode_uint64);
 				if (value > UINT32_MAX)
 				{
 					pmv.type = primitive_type::uint64;
@@ -75,7 +99,7 @@ namespace
 			}
 			else
 			{
-				const auto value = t->value_int64();
+				const auto value = decode_constant(ps, literal_decode_int64);
 				if (value > INT32_MAX)
 				{
 					pmv.type = primitive_type::int64;
@@ -89,7 +113,7 @@ namespace
 			}
 			break;
 		case token_type::hex:
-			pmv.u64 = t->value_uint64();
+			pmv.u64 = decode_constant(ps, literal_decode_uint64);
 			pmv.type = primitive_type::uint64;
 			if (pmv.u64 <= UINT32_MAX)
 			{
@@ -105,12 +129,12 @@ namespace
 			if (t->is_modifier(token_modifier::hint_float))
 			{
 				pmv.type = primitive_type::float32;
-				pmv.f32 = t->value_float32();
+				pmv.f32 = decode_constant(ps, literal_decode_float32);
 			}
 			else
 			{
 				pmv.type = primitive_type::float64;
-				pmv.f64 = t->value_float64();
+				pmv.f64 = decode_constant(ps, literal_decode_float64);
 			}
 			break;
 		case token_type::string:
@@ -144,22 +168,10 @@ namespace
 		return guard.done();
 	}
 
-	/**
-	 * \brief 
-	 */
-	typedef node_op* (* parse_op_fn)(const parser_scope* ps);
-
-	node_op* parse_op_factor(const parser_scope* ps);
-
-	node_op* parse_op_compare(const parser_scope* ps);
+	node_op* parse_op_expression(const parser_scope* ps);
 
 	node_op* parse_op_assign(const parser_scope* ps);
 
-	node_op* parse_op_unary(const parser_scope* ps, token_type tt, parse_op_fn right_fn);
-
-	node_op* parse_op_binop(const parser_scope* ps, array_view<token_type> tokens,
-		parse_op_fn left_fn, parse_op_fn right_fn);
-
 	node_op* parse_op_atom(const parser_scope* ps)
 	{
 		const auto t = ps->t;
@@ -237,6 +249,24 @@ namespace
 		}
 	}
 
+	node_op* parse_op_factor(const parser_scope* ps);
+
+	node_op* parse_op_unary(const parser_scope* ps)
+	{
+		const auto view = ps->get_view();
+		const auto tt = ps->t->type();
+		ps->t->next();
+
+		const auto right = parse_op_factor(ps);
+		auto guard = memory_guard(right);
+
+		const auto unary = o2_new node_op_unaryop(view, node_op_unaryop::from_token_type(tt));
+		auto guard2 = memory_guard(unary);
+		unary->add_child(right);
+		guard.done();
+		return guard2.done();
+	}
+
 	node_op* parse_op_factor(const parser_scope* ps)
 	{
 		const auto t = ps->t;
@@ -247,91 +277,90 @@ namespace
 		case token_type::bit_not:
 		case token_type::dec:
 		case token_type::inc:
-			return parse_op_unary(ps, t->type(), parse_op_factor);
+		case token_type::not_:
+			return parse_op_unary(ps);
 		default:
 			return parse_op_atom(ps);
 		}
 	}
 
-	node_op* parse_op_term(const parser_scope* ps)
-	{
-		static const vector<token_type> PARSE_TOKENS(
-			token_type::pointer, token_type::div
-		);
-		return parse_op_binop(ps, PARSE_TOKENS, parse_op_factor, parse_op_factor);
-	}
-
-	node_op* parse_op_expression(const parser_scope* ps)
+	/**
+	 * \brief how a binary operator binds to its operands
+	 */
+	struct binop_info
 	{
-		static const vector<token_type> PARSE_TOKENS(
-			token_type::plus, token_type::minus
-		);
-		return parse_op_binop(ps, PARSE_TOKENS, parse_op_term, parse_op_term);
-	}
+		// operators with a higher precedence bind tighter. 0 if the token is not a binary operator
+		int precedence;
+		// true if "a op b op c" is "a op (b op c)"
+		bool right_associative;
+	};
 
-	node_op* parse_op_unary(const parser_scope* ps, token_type tt, parse_op_fn right_fn)
+	/**
+	 * \brief all binary operators, indexed by the token type
+	 */
+	constexpr auto binop_infos = []()
 	{
-		const auto view = ps->get_view();
-		ps->t->next();
-
-		const auto right = right_fn(ps);
-		auto guard = memory_guard(right);
-
-		const auto unary = o2_new node_op_unaryop(view, node_op_unaryop::from_token_type(tt));
-		auto guard2 = memory_guard(unary);
-		unary->add_child(right);
-		guard.done();
-		return guard2.done();
-	}
+		std::array<binop_info, (int)token_type::eof + 1> infos{};
+		const auto left = [&infos](token_type tt, int precedence)
+		{
+			infos[(int)tt] = { precedence, false };
+		};
+		left(token_type::logical_or, 1);
+		left(token_type::logical_and, 2);
+		left(token_type::bit_or, 3);
+		left(token_type::bit_xor, 4);
+		left(token_type::ref, 5);
+		left(token_type::test_equals, 6);
+		left(token_type::test_not_equals, 6);
+		left(token_type::test_lt, 7);
+		left(token_type::test_lte, 7);
+		left(token_type::test_gt, 7);
+		left(token_type::test_gte, 7);
+		left(token_type::shift_left, 8);
+		left(token_type::shift_right, 8);
+		left(token_type::plus, 9);
+		left(token_type::minus, 9);
+		left(token_type::pointer, 10);
+		left(token_type::div, 10);
+		return infos;
+	}();
 
-	node_op* parse_op_binop(const parser_scope* ps, array_view<token_type> tokens,
-		parse_op_fn left_fn, parse_op_fn right_fn)
+	/**
+	 * \brief parse binary operators using precedence climbing
+	 * \param min_precedence operators with a lower precedence than this are left to the caller
+	 */
+	node_op* parse_op_binop(const parser_scope* ps, int min_precedence)
 	{
 		const auto t = ps->t;
-		if (right_fn == nullptr)
-			right_fn = left_fn;
-
-		const auto left = left_fn(ps);
-		auto guard = memory_guard(left);
-
-		const auto size = tokens.size();
-		for (int i = 0; i < size; ++i)
+		auto guard = memory_guard(parse_op_factor(ps));
+		while (true)
 		{
-			const auto view = ps->get_view();
 			const auto tt = t->type();
-			if (tokens[i] != tt)
-				continue;
+			const auto& info = binop_infos[(int)tt];
+			if (info.precedence == 0 || info.precedence < min_precedence)
+				break;
+
+			const auto view = ps->get_view();
 			t->next();
 
-			const auto right = right_fn(ps);
+			// the right-hand side only consumes operators that bind tighter, unless the operator is
+			// right-associative
+			const auto right = parse_op_binop(ps, info.right_associative ? info.precedence : info.precedence + 1);
 			auto guard1 = memory_guard(right);
 			const auto new_left = o2_new node_op_binop(view, node_op_binop::from_token_type(tt));
 			auto guard2 = memory_guard(new_left);
-			new_left->add_child(left);
+			new_left->add_child(guard.get());
 			guard.done();
 			new_left->add_child(right);
 			guard1.done();
 			guard = memory_guard(guard2.done());
-
-			// retry parsing. -1 will become 0 after "++i" is done in the for loop
-			i = -1;
 		}
 		return guard.done();
 	}
 
-	node_op* parse_op_compare(const parser_scope* ps)
+	node_op* parse_op_expression(const parser_scope* ps)
 	{
-		const auto t = ps->t;
-		if (t->type() == token_type::not_)
-			return parse_op_unary(ps, t->type(), parse_op_factor);
-
-		static const vector<token_type> PARSE_COMPARE_TOKENS(
-			token_type::test_equals, token_type::not_,
-			token_type::test_lt, token_type::test_lte,
-			token_type::test_gt, token_type::test_gte
-		);
-
-		return parse_op_binop(ps, PARSE_COMPARE_TOKENS, parse_op_expression, parse_op_expression);
+		return parse_op_binop(ps, 1);
 	}
 
 	node_op* parse_op_assign(const parser_scope* ps)
@@ -346,7 +375,7 @@ namespace
 			assign->add_child(parse_op_assign(&ps0));
 			return guard.done();
 		}
-		return parse_op_compare(ps);
+		return parse_op_expression(ps);
 	}
 
 	node* parse_op(const parser_scope* ps)
@@ -387,7 +416,7 @@ namespace
 				auto guard = memory_guard(ret);
 				t->next();
 				const parser_scope ps0(ps, ret);
-				ret->add_child(parse_op_compare(&ps0));
+				ret->add_child(parse_op_expression(&ps0));
 				if (t->type() != token_type::newline)
 					throw error_syntax_error(ps->get_view(), t, "expected newline");
 				return guard.done();
@@ -434,7 +463,7 @@ namespace
 		if (t->type() != token_type::identity)
 			throw error_expected_identity(ps->get_view(), t);
 
-		const auto ref = o2_new node_ref(ps->get_view(), chain_types, query_flags, t->value());
+		const auto ref = o2_new node_ref(ps->get_view(), chain_types, query_flags, t->value_id());
 		auto guard = memory_guard(ref);
 		auto section = ref;
 
@@ -445,7 +474,7 @@ namespace
 				throw error_expected_identity(ps->get_view(), t);
 
 			const auto new_section = o2_new node_ref(ps->get_view(), chain_types,
-				node_ref::query_flag_children, t->value());
+				node_ref::query_flag_children, t->value_id());
 			auto inner_guard = memory_guard(new_section);
 			section->add_child(new_section);
 			section = inner_guard.done();
@@ -533,7 +562,7 @@ namespace
 			return guard.done();
 		}
 
-		const auto primitive = ps->state->find_primitive_type(t->value());
+		const auto primitive = ps->state->find_primitive_type(t->value_id());
 		if (primitive != nullptr)
 		{
 			auto known_ref = o2_new node_type_known_ref(ps->get_view(), primitive);
@@ -564,7 +593,7 @@ namespace
 		if (t->type() != token_type::identity)
 			throw error_expected_identity(ps->get_view(), t);
 
-		const auto var = o2_new node_var(ps->get_view(), t->value(), 0);
+		const auto var = o2_new node_var(ps->get_view(), t->value_id(), 0);
 		auto guard = memory_guard(var);
 		t->next();
 		var->add_child(parse_arg_type(ps));
@@ -603,13 +632,13 @@ namespace
 
 		node_func* func;
 		if (ps->func != nullptr)
-			func = o2_new node_func(ps->get_view(), t->value(), node_func::inner_function{});
+			func = o2_new node_func(ps->get_view(), t->value_id(), node_func::inner_function{});
 		else if (bit_isset(modifiers, node_func::modifier_const))
-			func = o2_new node_func(ps->get_view(), t->value(), node_func::const_function{});
+			func = o2_new node_func(ps->get_view(), t->value_id(), node_func::const_function{});
 		else if (bit_isset(modifiers, node_func::modifier_extern))
-			func = o2_new node_func(ps->get_view(), t->value(), node_func::extern_function{});
+			func = o2_new node_func(ps->get_view(), t->value_id(), node_func::extern_function{});
 		else
-			func = o2_new node_func(ps->get_view(), t->value());
+			func = o2_new node_func(ps->get_view(), t->value_id());
 		auto guard = memory_guard(func);
 		if (attributes.is_set())
 			func->add_child(attributes.done());
@@ -659,26 +688,66 @@ namespace
 		return guard.done();
 	}
 
-	node_func_body* parse_func_body(const parser_scope* ps)
+	/**
+	 * \brief parse the scope of a function body. The current token is the '{' token
+	 */
+	void parse_func_body_scope(const parser_scope* ps, node_func_body* body)
 	{
 		const auto t = ps->t;
-		if (t->type() != token_type::bracket_left)
-			throw error_syntax_error(ps->get_view(), t, "expected '{'");
-
-		// Create a new body node
-		const auto body = o2_new node_func_body(ps->get_view());
-		auto guard = memory_guard(body);
 
 		// Add the initial scope for the function body
 		const auto scope = o2_new node_scope(ps->get_view());
-		auto guard2 = memory_guard(scope);
+		auto guard = memory_guard(scope);
 		body->add_child(scope);
-		guard2.done();
+		guard.done();
 
 		// Read function body nodes
 		const parser_scope ps0(ps, scope);
 		while (t->next_until_not(token_type::newline, token_type::comment) != token_type::bracket_right)
 			scope->add_child(parse_op(&ps0));
+	}
+
+	/**
+	 * \brief skip the function body by matching the brackets. The current token is the '{' token
+	 */
+	void skip_func_body(const parser_scope* ps, node_func_body* body)
+	{
+		const auto t = ps->t;
+		int depth = 1;
+		while (depth > 0)
+		{
+			switch (t->next())
+			{
+			case token_type::bracket_left:
+				depth++;
+				break;
+			case token_type::bracket_right:
+				depth--;
+				break;
+			case token_type::eof:
+				throw error_syntax_error(ps->get_view(), t, "expected '}'");
+			default:
+				break;
+			}
+		}
+		body->set_deferred_end(t->offset());
+	}
+
+	node_func_body* parse_func_body(const parser_scope* ps)
+	{
+		const auto t = ps->t;
+		if (t->type() != token_type::bracket_left)
+			throw error_syntax_error(ps->get_view(), t, "expected '{'");
+
+		// Create a new body node
+		const auto body = o2_new node_func_body(ps->get_view());
+		auto guard = memory_guard(body);
+
+		// const functions are always parsed, because they might be evaluated during the compilation
+		if (ps->state->is_declarations_only() && !ps->func->is_const())
+			skip_func_body(ps, body);
+		else
+			parse_func_body_scope(ps, body);
 		return guard.done();
 	}
 
@@ -698,12 +767,13 @@ namespace
 
 	node_func_method* parse_func_method0(const parser_scope* ps)
 	{
+		static const auto this_id = symbol_id::intern(STR("this"));
 		const auto t = ps->t;
 		auto tt = t->next();
 		if (tt != token_type::identity)
 			throw error_expected_identity(ps->get_view(), t);
 
-		const auto func = o2_new node_func_method(ps->get_view(), t->value());
+		const auto func = o2_new node_func_method(ps->get_view(), t->value_id());
 		auto guard = memory_guard(func);
 
 		tt = t->next();
@@ -721,7 +791,7 @@ namespace
 		if (tt == token_type::parant_right)
 		{
 			// automatically add the this argument
-			const auto this_var = o2_new node_var_this(ps->get_view(), STR("this"), ps->type);
+			const auto this_var = o2_new node_var_this(ps->get_view(), this_id, ps->type);
 			arguments->add_child(this_var);
 		}
 		else
@@ -729,7 +799,7 @@ namespace
 			// first argument might be a this argument
 			if (t->type() == token_type::this_)
 			{
-				const auto this_var = o2_new node_var_this(ps->get_view(), STR("this"), ps->type);
+				const auto this_var = o2_new node_var_this(ps->get_view(), this_id, ps->type);
 				arguments->add_child(this_var);
 				t->next();
 			}
@@ -737,7 +807,7 @@ namespace
 			{
 				// It might still be a this argument if the "type" is this
 				// TODO: Add support for named this arguments
-				const auto this_var = o2_new node_var_this(ps->get_view(), STR("this"), ps->type);
+				const auto this_var = o2_new node_var_this(ps->get_view(), this_id, ps->type);
 				arguments->add_child(this_var);
 			}
 
@@ -815,7 +885,7 @@ namespace
 		if (t->type() != token_type::identity)
 			throw error_expected_identity(ps->get_view(), t);
 
-		const auto var = o2_new node_var_const(ps->get_view(), t->value());
+		const auto var = o2_new node_var_const(ps->get_view(), t->value_id());
 		auto guard = memory_guard(var);
 		if (attributes.is_set())
 			var->add_child(attributes.done());
@@ -827,7 +897,7 @@ namespace
 			if (t->type() != token_type::assign)
 				throw error_syntax_error(ps1.get_view(), t, "expected '='");
 			t->next_until_not(token_type::comment);
-			var->add_child(parse_op_compare(&ps1));
+			var->add_child(parse_op_expression(&ps1));
 		}
 		else
 		{
@@ -842,7 +912,7 @@ namespace
 			// create a link that can be used between the implicit_type and the expression
 			const auto link = o2_new node_link(ps->get_view());
 			implicit->add_child(link);
-			const auto op = parse_op_compare(&ps1);
+			const auto op = parse_op_expression(&ps1);
 			op->add_child(link->new_link());
 			var->add_child(op);
 		}
@@ -896,7 +966,7 @@ namespace
 		if (t->type() != token_type::identity)
 			throw error_expected_identity(ps->get_view(), t);
 
-		const auto field = o2_new node_type_complex_field(ps->get_view(), t->value());
+		const auto field = o2_new node_type_complex_field(ps->get_view(), t->value_id());
 		auto guard = memory_guard(field);
 		t->next();
 		field->add_child(parse_type_ref(ps));
@@ -1059,8 +1129,7 @@ namespace
 		if (t->next_until_not(token_type::comment) != token_type::identity)
 			throw error_expected_identity(ps->get_view(), t);
 
-		const auto identity = t->value();
-		const auto type = o2_new node_type_complex(ps->get_view(), identity);
+		const auto type = o2_new node_type_complex(ps->get_view(), t->value_id());
 		if (attributes.is_set())
 			type->add_child(attributes.done());
 		auto guard = memory_guard(type);
@@ -1170,12 +1239,12 @@ namespace
 		const auto view = ps->get_view();
 		const auto import_statement = t->value();
 		t->next();
-		string_view alias;
+		symbol_id alias;
 		if (t->type() == token_type::as)
 		{
 			if (t->next() != token_type::identity)
 				throw error_expected_identity(ps->get_view(), t);
-			alias = t->value();
+			alias = t->value_id();
 			t->next();
 		}
 		auto import = o2_new node_import(view, import_statement, alias);
@@ -1258,6 +1327,85 @@ namespace
 		const parser_scope ps1(ps, parent);
 		parse_package_scope(&ps1);
 	}
+
+	/**
+	 * \brief the result of parsing one source code of a package
+	 *
+	 * Each source code is parsed into a package of its own, which allows for the source code of a package to be
+	 * parsed in parallel. The fragments are merged into the actual package afterwards
+	 */
+	struct package_fragment
+	{
+		// a package that's never part of the syntax tree
+		node_package* package;
+		parser_state state;
+		// set if the source code could not be parsed
+		std::exception_ptr error;
+
+		package_fragment(string_view package_name, syntax_tree* st)
+				: package(o2_new node_package(source_code_view(), package_name)), state(st), error()
+		{
+		}
+
+		package_fragment(const package_fragment&) = delete;
+
+		~package_fragment()
+		{
+			delete package;
+		}
+	};
+
+	void parse_package_fragment(source_code* src, package_fragment* fragment)
+	{
+		const memory_arena_scope arena_scope(fragment->package->get_arena());
+		try
+		{
+			const token_buffer tokens(src->get_text());
+			token_cursor t(&tokens);
+			fragment->state.set_source_code(src);
+
+			const parser_scope ps0(&fragment->state, &t);
+			const parser_scope ps1(&ps0, fragment->package);
+			t.next();
+			parse_package_pre_scope(&ps1);
+		}
+		catch (...)
+		{
+			fragment->error = std::current_exception();
+		}
+	}
+
+	/**
+	 * \brief move a node, parsed into a fragment, into the supplied parent
+	 *
+	 * The children of an import are detached and added again after the import itself is added. This makes sure
+	 * that duplicate symbols are detected in the same order as if the source code was parsed directly into the
+	 * package
+	 */
+	void merge_fragment_node(node* parent, node* n)
+	{
+		if (!n->is<node_import>())
+		{
+			parent->add_child(n);
+			return;
+		}
+
+		const auto children = n->remove_children();
+		int next = 0;
+		try
+		{
+			parent->add_child(n);
+			while (next < children.size())
+				merge_fragment_node(n, children[next++]);
+		}
+		catch (...)
+		{
+			// the children that are not merged yet are not owned by anyone
+			for (int i = next; i < children.size(); ++i)
+				delete children[i];
+			throw;
+		}
+	}
 }
 
 node_package* o2::parse_package_sources(array_view<source_code*> sources, string_view package_name, parser_state* state)
@@ -1268,22 +1416,114 @@ node_package* o2::parse_package_sources(array_view<source_code*> sources, string
 	auto package = o2_new node_package(source_code_view(), package_name);
 	auto guard = memory_guard(package);
 
-	// parse each source code found
-	for (auto src: sources)
+	// parse each source code into a fragment of its own. The fragments are destroyed before the package, which
+	// is the owner of their memory once they are merged
+	vector<std::unique_ptr<package_fragment>, 1> fragments;
+	fragments.reserve(sources.size());
+	for (int i = 0; i < sources.size(); ++i)
 	{
-		lexer l(src->get_text());
-		token t(&l);
-		state->set_source_code(src);
-
-		const parser_scope ps0(state, &t);
-		const parser_scope ps1(&ps0, package);
-		t.next();
-		parse_package_pre_scope(&ps1);
+		fragments.add(std::make_unique<package_fragment>(package_name, state->get_syntax_tree()));
+		fragments[i]->state.set_declarations_only(state->is_declarations_only());
+	}
+
+	const auto& parallel_for = state->get_parallel_for();
+	if (parallel_for && sources.size() > 1)
+	{
+		parallel_for(sources.size(), [&](int i)
+		{
+			parse_package_fragment(sources[i], fragments[i].get());
+		});
+	}
+	else
+	{
+		for (int i = 0; i < sources.size(); ++i)
+			parse_package_fragment(sources[i], fragments[i].get());
+	}
+
+	// all nodes parsed for this package are owned by the package's arena
+	for (const auto& fragment: fragments)
+		package->get_arena()->adopt(fragment->package->get_arena());
+
+	// merge the fragments in the same order as the source code is supplied, which makes both the resulting tree
+	// and the errors raised while merging the same as if the source code was parsed one after another
+	const memory_arena_scope arena_scope(package->get_arena());
+	for (int i = 0; i < sources.size(); ++i)
+	{
+		const auto& fragment = fragments[i];
+		if (fragment->error)
+			std::rethrow_exception(fragment->error);
+
+		state->set_source_code(sources[i]);
+		const auto children = fragment->package->remove_children();
+		for (int j = 0; j < children.size(); ++j)
+		{
+			try
+			{
+				merge_fragment_node(package, children[j]);
+			}
+			catch (...)
+			{
+				// the children that are not merged yet are not owned by anyone
+				for (int k = j + 1; k < children.size(); ++k)
+					delete children[k];
+				throw;
+			}
+		}
+		for (auto import: fragment->state.get_imports())
+			state->add_import(import);
 	}
 
 	return guard.done();
 }
 
+void o2::parse_deferred_func_body(node_func_body* body, parser_state* state)
+{
+	assert(body->is_deferred() && "the body is already parsed");
+	const auto func = body->get_def();
+	const auto package = body->get_parent_of_type<node_package>();
+	assert(func != nullptr && package != nullptr && "the body must be part of a package");
+
+	// the body is lexed on its own. Its view is positioned directly after the '{' token
+	const auto& view = body->get_source_code();
+	const auto source = view.get_source_code();
+	const token_buffer tokens(source->get_text(), view.get_offset() - 1, body->get_deferred_end());
+	token_cursor t(&tokens);
+	state->set_source_code(source);
+
+	const memory_arena_scope arena_scope(package->get_arena());
+	const parser_scope ps0(state, &t);
+	const parser_scope ps1(&ps0, package);
+	const parser_scope ps2(&ps1, func->get_parent_of_type<node_type>());
+	const parser_scope ps3(&ps2, func);
+	t.next();
+	parse_func_body_scope(&ps3, body);
+	body->set_deferred_end(0);
+
+	// the body might already be resolved, but without any content
+	body->add_phases_left(node::phase_resolve);
+}
+
+int o2::parse_deferred_func_bodies(node_package* package, parser_state* state)
+{
+	int count = 0;
+	const auto parse = [state, &count](auto& self, node* n) -> void
+	{
+		for (auto c: n->get_children())
+		{
+			const auto body = c->as<node_func_body>();
+			if (body == nullptr)
+				self(self, c);
+			else if (body->is_deferred())
+			{
+				parse_deferred_func_body(body, state);
+				count++;
+			}
+		}
+	};
+	parse(parse, package);
+	return count;
+}
+
 node_package* o2::parse_main_module_package(module* m, string_view package_name, OUT parser_state* state)
 {
 	// search for the information of the package
@@ -1296,23 +1536,43 @@ node_package* o2::parse_main_module_package(module* m, string_view package_name,
 	return package;
 }
 
-void o2::optimize(syntax_tree* st, int level)
+namespace
 {
-	// TODO: Add maximum iterations?
-
-	if (level >= 0)
+	/**
+	 * \brief run the optimization passes for the supplied level
+	 * \param run optimizes the nodes using the supplied passes
+	 */
+	void optimize_using(int level, debug_ostream* stats, const std::function<void(optimization_pass_manager*)>& run)
 	{
-		while (true)
-		{
-			node_optimizer_binop_merge opt0_0;
-			node_optimizer_unaryop_merge opt0_1;
-			st->optimize(&opt0_0);
-			st->optimize(&opt0_1);
+		optimization_pass_manager passes;
 
-			if (opt0_0.count == 0 && opt0_1.count == 0)
-				break;
-			opt0_0.count = 0;
-			opt0_1.count = 0;
+		node_optimizer_binop_merge binop_merge;
+		node_optimizer_unaryop_merge unaryop_merge;
+		if (level >= 0)
+		{
+			passes.add<node_op_binop>("binop_merge", &binop_merge);
+			passes.add<node_op_unaryop>("unaryop_merge", &unaryop_merge);
 		}
+
+		run(&passes);
+		if (stats)
+			passes.debug(*stats);
 	}
 }
+
+void o2::optimize(syntax_tree* st, int level, debug_ostream* stats)
+{
+	optimize_using(level, stats, [st](optimization_pass_manager* passes)
+	{
+		st->optimize(passes);
+	});
+}
+
+void o2::optimize(array_view<node_package*> packages, int level, debug_ostream* stats)
+{
+	optimize_using(level, stats, [packages](optimization_pass_manager* passes)
+	{
+		for (auto p: packages)
+			passes->optimize(p);
+	});
+}
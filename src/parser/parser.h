@@ -53,10 +53,37 @@ namespace o2
 	 */
 	extern node_package* parse_main_module_package(module* main_module, string_view package_name, OUT parser_state* state);
 
+	/**
+	 * \brief parse the body of a function that's skipped because only the declarations were parsed
+	 * \param body the body
+	 * \param state the state used when parsing the body
+	 * \remark the nodes in the body must be resolved by processing the phases of the package again
+	 */
+	extern void parse_deferred_func_body(node_func_body* body, parser_state* state);
+
+	/**
+	 * \brief parse the bodies of all functions in the supplied package that are skipped because only the
+	 *        declarations were parsed
+	 * \param package the package
+	 * \param state the state used when parsing the bodies
+	 * \return the number of bodies parsed
+	 * \remark the nodes in the bodies must be resolved by processing the phases of the package again
+	 */
+	extern int parse_deferred_func_bodies(node_package* package, parser_state* state);
+
 	/**
 	 * \brief optimize the syntax tree 
 	 * \param st 
 	 * \param level 
+	 * \param stats where to put statistics for each optimization pass. Can be nullptr
+	 */
+	extern void optimize(syntax_tree* st, int level, debug_ostream* stats = nullptr);
+
+	/**
+	 * \brief optimize the supplied packages, which are part of a syntax tree
+	 * \param packages the packages
+	 * \param level
+	 * \param stats where to put statistics for each optimization pass. Can be nullptr
 	 */
-	extern void optimize(syntax_tree* st, int level);
+	extern void optimize(array_view<node_package*> packages, int level, debug_ostream* stats = nullptr);
 }
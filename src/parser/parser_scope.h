@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include "token.h"
+#include "token_buffer.h"
 #include "package/node_package.h"
 #include "types/node_type.h"
 #include "source_code.h"
@@ -27,7 +27,7 @@ namespace o2
 		/**
 		 * \brief the token
 		*/
-		token* const t;
+		token_cursor* const t;
 
 		/**
 		 * \brief the closest parent node
@@ -49,7 +49,7 @@ namespace o2
 		*/
 		node_func* const func;
 
-		parser_scope(parser_state* state, token* t)
+		parser_scope(parser_state* state, token_cursor* t)
 				: state(state), t(t), closest(),
 				  package(), type(), func()
 		{
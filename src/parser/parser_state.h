@@ -9,6 +9,7 @@
 #include "types/node_type.h"
 #include "types/node_type_primitive.h"
 #include "primitive_value.h"
+#include <functional>
 
 namespace o2
 {
@@ -25,9 +26,57 @@ namespace o2
 	class parser_state
 	{
 	public:
+		/**
+		 * \brief runs the supplied body once for each index from 0 to count, potentially in parallel. Returns when
+		 *        all indices are processed. The body is not allowed to raise any exceptions
+		 */
+		typedef std::function<void(int count, const std::function<void(int)>& body)> parallel_for;
+
 		explicit parser_state(syntax_tree* st)
-				: _syntax_tree(st), _source_code()
+				: _syntax_tree(st), _source_code(), _parallel_for(), _declarations_only()
+		{
+		}
+
+		/**
+		 * \return the syntax tree we are parsing into
+		 */
+		[[nodiscard]] syntax_tree* get_syntax_tree() const
+		{
+			return _syntax_tree;
+		}
+
+		/**
+		 * \return how the source code of a package is parsed in parallel. Empty if the source code is parsed one
+		 *         after another
+		 */
+		[[nodiscard]] const parallel_for& get_parallel_for() const
+		{
+			return _parallel_for;
+		}
+
+		/**
+		 * \param pf how the source code of a package is parsed in parallel
+		 */
+		void set_parallel_for(parallel_for pf)
+		{
+			_parallel_for = std::move(pf);
+		}
+
+		/**
+		 * \return true if only the declarations are parsed. The bodies of the functions are skipped and
+		 *         parsed later on, if needed
+		 */
+		[[nodiscard]] bool is_declarations_only() const
+		{
+			return _declarations_only;
+		}
+
+		/**
+		 * \param declarations_only true if the bodies of the functions should be skipped when parsing
+		 */
+		void set_declarations_only(bool declarations_only)
 		{
+			_declarations_only = declarations_only;
 		}
 
 		/**
@@ -69,7 +118,7 @@ namespace o2
 		 * \param name the primitive type name
 		 * \return the node that represents the supplied primitive type
 		 */
-		[[nodiscard]] node_type_primitive* find_primitive_type(string_view name) const;
+		[[nodiscard]] node_type_primitive* find_primitive_type(symbol_id name) const;
 
 		/**
 		 * \return the primitive that represents a byte
@@ -80,5 +129,7 @@ namespace o2
 		syntax_tree* const _syntax_tree;
 		const source_code* _source_code;
 		vector<node_import*> _imports;
+		parallel_for _parallel_for;
+		bool _declarations_only;
 	};
 }
\ No newline at end of file
@@ -41,15 +41,7 @@ namespace o2
 		 * \return
 		 */
 		template<class T>
-		const recursion_detector* first_of_type() const
-		{
-			auto impl = dynamic_cast<const T*>(n);
-			if (impl)
-				return this;
-			if (parent)
-				return parent->first_of_type<T>();
-			return nullptr;
-		}
+		const recursion_detector* first_of_type() const;
 
 		/**
 		 * \brief get the next rd instance that contains the supplied type
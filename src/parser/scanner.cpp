@@ -0,0 +1,344 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "scanner.h"
+#include <bit>
+#include <cstdint>
+
+#if !defined(O2_UTF16_SUPPORT) && (defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__))
+#define O2_SCANNER_X86
+#include <immintrin.h>
+// the aligned loads might read outside of the string. That's fine for the hardware, because a load never crosses
+// a page boundary, but not for the address sanitizer
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC allows AVX2 intrinsics without enabling them for the entire translation unit
+#define O2_TARGET_AVX2
+#define O2_NO_SANITIZE_ADDRESS
+#else
+#define O2_TARGET_AVX2 __attribute__((target("avx2")))
+#define O2_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#endif
+#endif
+
+using namespace o2;
+
+namespace
+{
+#pragma region scalar
+
+	const string_literal* scalar_skip_whitespace(const string_literal* p)
+	{
+		while (*p == ' ' || *p == '\t' || *p == '\r')
+			p++;
+		return p;
+	}
+
+	inline bool is_identity(string_literal c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+	}
+
+	const string_literal* scalar_skip_identity(const string_literal* p)
+	{
+		while (is_identity(*p))
+			p++;
+		return p;
+	}
+
+	const string_literal* scalar_find_newline(const string_literal* p)
+	{
+		while (*p != 0 && *p != '\n')
+			p++;
+		return p;
+	}
+
+	const string_literal* scalar_find_star(const string_literal* p)
+	{
+		while (*p != 0 && *p != '*')
+			p++;
+		return p;
+	}
+
+	const string_literal* scalar_find_quote(const string_literal* p, string_literal quote)
+	{
+		while (*p != 0 && *p != quote && *p != '\\')
+			p++;
+		return p;
+	}
+
+	constexpr scanner scalar_scanner = {
+			scalar_skip_whitespace,
+			scalar_skip_identity,
+			scalar_find_newline,
+			scalar_find_star,
+			scalar_find_quote,
+			scanner_isa::scalar
+	};
+
+#pragma endregion
+
+#if defined(O2_SCANNER_X86)
+
+#pragma region sse2
+
+	/**
+	 * \brief find the first character, starting at p, where the supplied test is true
+	 *
+	 * The first block is loaded from the aligned address before p, so that no load crosses a page boundary. The
+	 * characters before p are then masked away
+	 *
+	 * \param p where to start searching
+	 * \param test a function that returns a bitmask with one bit for each character that we stop at
+	 */
+	template<class Test>
+	O2_NO_SANITIZE_ADDRESS inline const string_literal* sse2_find_first(const string_literal* p, Test test)
+	{
+		constexpr auto size = sizeof(__m128i);
+		const auto offset = (std::uintptr_t)p & (size - 1);
+		auto block = p - offset;
+		auto mask = test((const __m128i*)block) & (~std::uint32_t(0) << offset);
+		while (mask == 0)
+		{
+			block += size;
+			mask = test((const __m128i*)block);
+		}
+		return block + std::countr_zero(mask);
+	}
+
+	// mask where each bit is set if the character is within the range [lo, hi]. Only works for ASCII ranges
+	inline __m128i sse2_in_range(__m128i v, char lo, char hi)
+	{
+		return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8((char)(lo - 1))),
+				_mm_cmplt_epi8(v, _mm_set1_epi8((char)(hi + 1))));
+	}
+
+	inline __m128i sse2_eq(__m128i v, char c)
+	{
+		return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+	}
+
+	O2_NO_SANITIZE_ADDRESS const string_literal* sse2_skip_whitespace(const string_literal* p)
+	{
+		return sse2_find_first(p, [](const __m128i* block) O2_NO_SANITIZE_ADDRESS
+		{
+			const auto v = _mm_load_si128(block);
+			const auto ws = _mm_or_si128(_mm_or_si128(sse2_eq(v, ' '), sse2_eq(v, '\t')), sse2_eq(v, '\r'));
+			return (std::uint32_t)(~_mm_movemask_epi8(ws) & 0xFFFF);
+		});
+	}
+
+	O2_NO_SANITIZE_ADDRESS const string_literal* sse2_skip_identity(const string_literal* p)
+	{
+		return sse2_find_first(p, [](const __m128i* block) O2_NO_SANITIZE_ADDRESS
+		{
+			const auto v = _mm_load_si128(block);
+			const auto lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+			const auto id = _mm_or_si128(_mm_or_si128(sse2_in_range(lower, 'a', 'z'), sse2_in_range(v, '0', '9')),
+					sse2_eq(v, '_'));
+			return (std::uint32_t)(~_mm_movemask_epi8(id) & 0xFFFF);
+		});
+	}
+
+	O2_NO_SANITIZE_ADDRESS const string_literal* sse2_find_newline(const string_literal* p)
+	{
+		return sse2_find_first(p, [](const __m128i* block) O2_NO_SANITIZE_ADDRESS
+		{
+			const auto v = _mm_load_si128(block);
+			return (std::uint32_t)_mm_movemask_epi8(_mm_or_si128(sse2_eq(v, 0), sse2_eq(v, '\n')));
+		});
+	}
+
+	O2_NO_SANITIZE_ADDRESS const string_literal* sse2_find_star(const string_literal* p)
+	{
+		return sse2_find_first(p, [](const __m128i* block) O2_NO_SANITIZE_ADDRESS
+		{
+			const auto v = _mm_load_si128(block);
+			return (std::uint32_t)_mm_movemask_epi8(_mm_or_si128(sse2_eq(v, 0), sse2_eq(v, '*')));
+		});
+	}
+
+	O2_NO_SANITIZE_ADDRESS const string_literal* sse2_find_quote(const string_literal* p, string_literal quote)
+	{
+		return sse2_find_first(p, [quote](const __m128i* block) O2_NO_SANITIZE_ADDRESS
+		{
+			const auto v = _mm_load_si128(block);
+			const auto found = _mm_or_si128(_mm_or_si128(sse2_eq(v, 0), sse2_eq(v, quote)), sse2_eq(v, '\\'));
+			return (std::uint32_t)_mm_movemask_epi8(found);
+		});
+	}
+
+	constexpr scanner sse2_scanner = {
+			sse2_skip_whitespace,
+			sse2_skip_identity,
+			sse2_find_newline,
+			sse2_find_star,
+			sse2_find_quote,
+			scanner_isa::sse2
+	};
+
+#pragma endregion
+
+#pragma region avx2
+
+	// see sse2_find_first
+	template<class Test>
+	O2_TARGET_AVX2 O2_NO_SANITIZE_ADDRESS inline const string_literal* avx2_find_first(const string_literal* p, Test test)
+	{
+		constexpr auto size = sizeof(__m256i);
+		const auto offset = (std::uintptr_t)p & (size - 1);
+		auto block = p - offset;
+		auto mask = test((const __m256i*)block) & (~std::uint32_t(0) << offset);
+		while (mask == 0)
+		{
+			block += size;
+			mask = test((const __m256i*)block);
+		}
+		return block + std::countr_zero(mask);
+	}
+
+	O2_TARGET_AVX2 inline __m256i avx2_in_range(__m256i v, char lo, char hi)
+	{
+		return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8((char)(lo - 1))),
+				_mm256_cmpgt_epi8(_mm256_set1_epi8((char)(hi + 1)), v));
+	}
+
+	O2_TARGET_AVX2 inline __m256i avx2_eq(__m256i v, char c)
+	{
+		return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c));
+	}
+
+	O2_TARGET_AVX2 O2_NO_SANITIZE_ADDRESS const string_literal* avx2_skip_whitespace(const string_literal* p)
+	{
+		return avx2_find_first(p, [](const __m256i* block) O2_TARGET_AVX2 O2_NO_SANITIZE_ADDRESS
+		{
+			const auto v = _mm256_load_si256(block);
+			const auto ws = _mm256_or_si256(_mm256_or_si256(avx2_eq(v, ' '), avx2_eq(v, '\t')), avx2_eq(v, '\r'));
+			return ~(std::uint32_t)_mm256_movemask_epi8(ws);
+		});
+	}
+
+	O2_TARGET_AVX2 O2_NO_SANITIZE_ADDRESS const string_literal* avx2_skip_identity(const string_literal* p)
+	{
+		return avx2_find_first(p, [](const __m256i* block) O2_TARGET_AVX2 O2_NO_SANITIZE_ADDRESS
+		{
+			const auto v = _mm256_load_si256(block);
+			const auto lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+			const auto id = _mm256_or_si256(
+					_mm256_or_si256(avx2_in_range(lower, 'a', 'z'), avx2_in_range(v, '0', '9')), avx2_eq(v, '_'));
+			return ~(std::uint32_t)_mm256_movemask_epi8(id);
+		});
+	}
+
+	O2_TARGET_AVX2 O2_NO_SANITIZE_ADDRESS const string_literal* avx2_find_newline(const string_literal* p)
+	{
+		return avx2_find_first(p, [](const __m256i* block) O2_TARGET_AVX2 O2_NO_SANITIZE_ADDRESS
+		{
+			const auto v = _mm256_load_si256(block);
+			return (std::uint32_t)_mm256_movemask_epi8(_mm256_or_si256(avx2_eq(v, 0), avx2_eq(v, '\n')));
+		});
+	}
+
+	O2_TARGET_AVX2 O2_NO_SANITIZE_ADDRESS const string_literal* avx2_find_star(const string_literal* p)
+	{
+		return avx2_find_first(p, [](const __m256i* block) O2_TARGET_AVX2 O2_NO_SANITIZE_ADDRESS
+		{
+			const auto v = _mm256_load_si256(block);
+			return (std::uint32_t)_mm256_movemask_epi8(_mm256_or_si256(avx2_eq(v, 0), avx2_eq(v, '*')));
+		});
+	}
+
+	O2_TARGET_AVX2 O2_NO_SANITIZE_ADDRESS const string_literal* avx2_find_quote(const string_literal* p, string_literal quote)
+	{
+		return avx2_find_first(p, [quote](const __m256i* block) O2_TARGET_AVX2 O2_NO_SANITIZE_ADDRESS
+		{
+			const auto v = _mm256_load_si256(block);
+			const auto found = _mm256_or_si256(_mm256_or_si256(avx2_eq(v, 0), avx2_eq(v, quote)), avx2_eq(v, '\\'));
+			return (std::uint32_t)_mm256_movemask_epi8(found);
+		});
+	}
+
+	constexpr scanner avx2_scanner = {
+			avx2_skip_whitespace,
+			avx2_skip_identity,
+			avx2_find_newline,
+			avx2_find_star,
+			avx2_find_quote,
+			scanner_isa::avx2
+	};
+
+	bool cpu_supports_avx2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		// the OS must save the AVX registers when switching threads
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+#pragma endregion
+
+#endif
+
+	const scanner* get_scanner(scanner_isa isa)
+	{
+		switch (isa)
+		{
+#if defined(O2_SCANNER_X86)
+		case scanner_isa::sse2:
+			return &sse2_scanner;
+		case scanner_isa::avx2:
+		{
+			static const bool avx2 = cpu_supports_avx2();
+			return avx2 ? &avx2_scanner : nullptr;
+		}
+#endif
+		case scanner_isa::scalar:
+			return &scalar_scanner;
+		default:
+			return nullptr;
+		}
+	}
+
+	const scanner* get_best_scanner()
+	{
+		for (const auto isa: { scanner_isa::avx2, scanner_isa::sse2 })
+		{
+			const auto s = get_scanner(isa);
+			if (s != nullptr)
+				return s;
+		}
+		return &scalar_scanner;
+	}
+}
+
+const scanner* scanner::_active = get_best_scanner();
+
+bool scanner::select(scanner_isa isa)
+{
+	const auto s = get_scanner(isa);
+	if (s == nullptr)
+		return false;
+	_active = s;
+	return true;
+}
+
+bool scanner::is_supported(scanner_isa isa)
+{
+	return get_scanner(isa) != nullptr;
+}
@@ -0,0 +1,82 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include "strings.h"
+
+namespace o2
+{
+	/**
+	 * \brief instruction sets that the scanner can use
+	 */
+	enum class scanner_isa
+	{
+		scalar,
+		sse2,
+		avx2
+	};
+
+	/**
+	 * \brief functions used by the lexer to skip over runs of characters
+	 *
+	 * The vectorized implementations test 16 or 32 characters at a time. Each function stops at the null
+	 * terminator, which means that the supplied text must be null-terminated. Blocks are loaded from aligned
+	 * addresses, so characters after the null terminator might be read, but never outside the memory page that
+	 * contains the null terminator
+	 */
+	struct scanner
+	{
+		/**
+		 * \return the first character that's not a ' ', '\t' or '\r'
+		 */
+		const string_literal* (* skip_whitespace)(const string_literal* p);
+
+		/**
+		 * \return the first character that's not a part of an identity, i.e. [a-zA-Z0-9_]
+		 */
+		const string_literal* (* skip_identity)(const string_literal* p);
+
+		/**
+		 * \return the first '\n' or the null terminator
+		 */
+		const string_literal* (* find_newline)(const string_literal* p);
+
+		/**
+		 * \return the first '*' or the null terminator
+		 */
+		const string_literal* (* find_star)(const string_literal* p);
+
+		/**
+		 * \return the first quote, '\\' or the null terminator
+		 */
+		const string_literal* (* find_quote)(const string_literal* p, string_literal quote);
+
+		// the instruction set used by this scanner
+		scanner_isa isa;
+
+		/**
+		 * \return the scanner used by the lexer. The best instruction set supported by the CPU is selected at startup
+		 */
+		static const scanner* get()
+		{
+			return _active;
+		}
+
+		/**
+		 * \brief change the scanner used by the lexer. Used when benchmarking and testing the scanners
+		 * \return false if the instruction set isn't supported by the CPU
+		 */
+		static bool select(scanner_isa isa);
+
+		/**
+		 * \return true if the supplied instruction set is supported by the CPU
+		 */
+		static bool is_supported(scanner_isa isa);
+
+	private:
+		static const scanner* _active;
+	};
+}
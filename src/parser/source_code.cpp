@@ -0,0 +1,106 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "source_code.h"
+#include "scanner.h"
+#include <algorithm>
+#include <fstream>
+#include <atomic>
+
+using namespace o2;
+
+namespace
+{
+	std::atomic_bool memory_mapping(true);
+}
+
+source_code::source_code(mapped_file* mapped, string filename)
+		: _text(), _filename(std::move(filename)), _mapped(mapped), _view(mapped->get_text()),
+		  _index(source_file_table::add(this))
+{
+}
+
+source_code::~source_code()
+{
+	source_file_table::remove(_index);
+	delete _mapped;
+}
+
+source_code* source_code::from_file(const std::filesystem::path& path)
+{
+	// TODO: check what type of file this is. It might be ASCII, UTF-8, UTF-16 and various little and big endian
+#if !defined(O2_UTF16_SUPPORT)
+	if (memory_mapping)
+	{
+		const auto mapped = mapped_file::open(path);
+		if (mapped != nullptr)
+			return new source_code(mapped, path.generic_string());
+	}
+#endif
+
+	// fallback to read the entire file into memory
+	std::ifstream f(path, std::ios::binary);
+	string text;
+	f.seekg(0, std::ios::end);
+	const auto size = f.tellg();
+	if (size > 0)
+	{
+		text.resize((size_t)size);
+		f.seekg(0, std::ios::beg);
+		f.read(reinterpret_cast<char*>(text.data()), size);
+	}
+	return new source_code(std::move(text), path.generic_string());
+}
+
+void source_code::set_memory_mapping(bool enabled)
+{
+	memory_mapping = enabled;
+}
+
+int source_code::get_line(int offset) const
+{
+	const auto& lines = get_lines();
+	return (int)(std::upper_bound(lines.begin(), lines.end(), (std::uint32_t)offset) - lines.begin()) - 1;
+}
+
+int source_code::get_line_start(int line) const
+{
+	const auto& lines = get_lines();
+	if (line < 0)
+		return 0;
+	if (line >= lines.size())
+		return (int)_view.length();
+	return (int)lines[line];
+}
+
+string_view source_code::get_line_text(int line) const
+{
+	const auto start = get_line_start(line);
+	auto end = get_line_start(line + 1);
+	// remove the newline
+	if (end > start && _view[end - 1] == '\n')
+		end--;
+	if (end > start && _view[end - 1] == '\r')
+		end--;
+	return _view.substr(start, end - start);
+}
+
+const vector<std::uint32_t, 1>& source_code::get_lines() const
+{
+	std::call_once(_lines_flag, [this]()
+	{
+		const auto first = _view.data();
+		const auto last = first + _view.length();
+		const auto s = scanner::get();
+		_lines.add(0);
+		for (auto p = s->find_newline(first); p < last; p = s->find_newline(p + 1))
+		{
+			// the scanner also stops at null characters that are part of the text
+			if (*p == '\n')
+				_lines.add((std::uint32_t)(p + 1 - first));
+		}
+	});
+	return _lines;
+}
@@ -6,31 +6,71 @@
 #pragma once
 
 #include "strings.h"
+#include "mapped_file.h"
+#include "source_file_table.h"
+#include "collections/vector.h"
+#include <cstdint>
+#include <mutex>
 
 namespace o2
 {
 	/**
 	 * \brief a read-only view of the supplied source code
+	 *
+	 * The source code is either owned by this object or memory mapped from a file. In both cases the text is
+	 * followed by a terminating null character.
+	 *
+	 * Nodes only know the offset, in the text, where they are found. The line is figured out from an index of where
+	 * each line starts, which is built the first time a line is requested
 	 */
 	class source_code
 	{
 	public:
 		explicit source_code(string text)
-				: _text(std::move(text)), _filename()
+				: _text(std::move(text)), _filename(), _mapped(), _view(_text), _index(source_file_table::add(this))
 		{
 		}
 
 		source_code(string text, string filename)
-				: _text(std::move(text)), _filename(std::move(filename))
+				: _text(std::move(text)), _filename(std::move(filename)), _mapped(), _view(_text),
+				  _index(source_file_table::add(this))
 		{
 		}
 
+		/**
+		 * \param mapped the memory mapped file. The ownership is moved to this object
+		 * \param filename the filename
+		 */
+		source_code(mapped_file* mapped, string filename);
+
+		source_code(const source_code&) = delete;
+
+		source_code& operator=(const source_code&) = delete;
+
+		~source_code();
+
+		/**
+		 * \brief load the source code from the supplied file. The file is memory mapped if possible
+		 * \param path the path to the file
+		 * \return the source code
+		 */
+		static source_code* from_file(const std::filesystem::path& path);
+
+		/**
+		 * \brief enable or disable memory mapping of the files loaded by from_file
+		 * \param enabled true if the files are memory mapped; false if they are read into memory
+		 *
+		 * A memory mapped file must not be truncated while it's in use. Processes that keep the source code loaded
+		 * while the files are edited, such as when watching for changes, must read the files into memory instead
+		 */
+		static void set_memory_mapping(bool enabled);
+
 		/**
 		 * \return the actual source code
 		 */
 		inline string_view get_text() const
 		{
-			return _text;
+			return _view;
 		}
 
 		/**
@@ -41,8 +81,46 @@ namespace o2
 			return _filename;
 		}
 
+		/**
+		 * \return the index of this source code in the source file table
+		 */
+		inline std::uint32_t get_index() const
+		{
+			return _index;
+		}
+
+		/**
+		 * \param offset an offset in the text
+		 * \return the zero-based line that the supplied offset is on
+		 */
+		int get_line(int offset) const;
+
+		/**
+		 * \param line a zero-based line
+		 * \return the offset, in the text, where the supplied line starts
+		 */
+		int get_line_start(int line) const;
+
+		/**
+		 * \param line a zero-based line
+		 * \return the text on the supplied line, without the newline
+		 */
+		string_view get_line_text(int line) const;
+
+	private:
+		/**
+		 * \return an index of where each line starts
+		 */
+		const vector<std::uint32_t, 1>& get_lines() const;
+
 	private:
 		const string _text;
 		const string _filename;
+		mapped_file* const _mapped;
+		const string_view _view;
+		const std::uint32_t _index;
+
+		mutable std::once_flag _lines_flag;
+		mutable vector<std::uint32_t, 1> _lines;
 	};
-}
\ No newline at end of file
+}
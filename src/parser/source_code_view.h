@@ -5,59 +5,67 @@
 
 #pragma once
 
-#include "token.h"
+#include "token_buffer.h"
 #include "source_code.h"
 
 namespace o2
 {
 	/**
 	 * \brief a read-only view of the supplied source code
+	 *
+	 * Only the index of the source code, in the source file table, and the offset are stored, which makes the view
+	 * 8 bytes large. The line is looked up in the source code when it's needed, which is normally only when an
+	 * error is printed
 	 */
 	class source_code_view
 	{
 	public:
 		source_code_view()
-				: _source_code(), _line(), _line_offset(), _line_start(),
-				  _offset()
+				: _file(), _offset()
 		{
 		}
 
-		source_code_view(const source_code* src, const token* t)
-				: _source_code(src), _line(t->line()), _line_offset(t->line_offset()), _line_start(t->line_start()),
-				  _offset(t->offset())
+		source_code_view(const source_code* src, int offset)
+				: _file(src != nullptr ? src->get_index() : 0), _offset((std::uint32_t)offset)
 		{
 		}
 
-		inline const source_code* get_source_code() const
+		source_code_view(const source_code* src, const token_cursor* t)
+				: source_code_view(src, t->offset())
 		{
-			return _source_code;
 		}
 
-		inline int get_line() const
+		inline const source_code* get_source_code() const
 		{
-			return _line;
+			return source_file_table::get(_file);
 		}
 
-		inline int get_line_offset() const
+		/**
+		 * \return the zero-based line
+		 */
+		inline int get_line() const
 		{
-			return _line_offset;
+			return get_source_code()->get_line(get_offset());
 		}
 
-		inline const string_literal* get_line_start() const
+		/**
+		 * \return the offset, in bytes, on the line
+		 */
+		inline int get_line_offset() const
 		{
-			return _line_start;
+			const auto src = get_source_code();
+			return get_offset() - src->get_line_start(src->get_line(get_offset()));
 		}
 
 		inline int get_offset() const
 		{
-			return _offset;
+			return (int)_offset;
 		}
 
 	private:
-		const source_code* _source_code;
-		const int _line;
-		const int _line_offset;
-		const string_literal* _line_start;
-		const int _offset;
+		const std::uint32_t _file;
+		const std::uint32_t _offset;
 	};
-}
\ No newline at end of file
+
+	static_assert(sizeof(source_code_view) == 8, "the view is expected to be two 32bit integers");
+}
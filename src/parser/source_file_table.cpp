@@ -0,0 +1,104 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "source_file_table.h"
+#include "collections/vector.h"
+#include <atomic>
+#include <mutex>
+#include <cassert>
+
+using namespace o2;
+
+namespace
+{
+	// the table is split into chunks that are never moved once they are allocated. This allows for the source
+	// code to be looked up without taking a lock
+	constexpr std::uint32_t chunk_bits = 10;
+	constexpr std::uint32_t chunk_size = 1u << chunk_bits;
+	constexpr std::uint32_t max_chunks = 1u << 12;
+
+	typedef std::atomic<const source_code*> slot;
+
+	struct table
+	{
+		std::mutex mutex;
+		// the next index that's never been used
+		std::uint32_t next = 1;
+		// indices that are removed and can be reused
+		vector<std::uint32_t> released;
+		std::atomic<slot*> chunks[max_chunks] = {};
+
+		~table()
+		{
+			for (auto& c: chunks)
+				delete[] c.load();
+		}
+	};
+
+	table& get_table()
+	{
+		static table instance;
+		return instance;
+	}
+
+	slot* get_slot(table& t, std::uint32_t index)
+	{
+		const auto chunk = t.chunks[index >> chunk_bits].load(std::memory_order_acquire);
+		if (chunk == nullptr)
+			return nullptr;
+		return &chunk[index & (chunk_size - 1)];
+	}
+}
+
+std::uint32_t source_file_table::add(const source_code* src)
+{
+	auto& t = get_table();
+	const std::lock_guard<std::mutex> lock(t.mutex);
+
+	std::uint32_t index;
+	if (!t.released.empty())
+	{
+		index = t.released.remove_at(t.released.size() - 1);
+	}
+	else
+	{
+		if (t.next >= chunk_size * max_chunks)
+		{
+			assert(false && "too many source codes are loaded");
+			return 0;
+		}
+		index = t.next++;
+
+		// allocate the chunk the first time an index in it is used
+		auto& chunk = t.chunks[index >> chunk_bits];
+		if (chunk.load(std::memory_order_relaxed) == nullptr)
+			chunk.store(new slot[chunk_size](), std::memory_order_release);
+	}
+
+	get_slot(t, index)->store(src, std::memory_order_release);
+	return index;
+}
+
+void source_file_table::remove(std::uint32_t index)
+{
+	if (index == 0)
+		return;
+
+	auto& t = get_table();
+	const std::lock_guard<std::mutex> lock(t.mutex);
+	get_slot(t, index)->store(nullptr, std::memory_order_release);
+	t.released.add(index);
+}
+
+const source_code* source_file_table::get(std::uint32_t index)
+{
+	if (index == 0)
+		return nullptr;
+
+	const auto s = get_slot(get_table(), index);
+	if (s == nullptr)
+		return nullptr;
+	return s->load(std::memory_order_acquire);
+}
@@ -0,0 +1,44 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace o2
+{
+	class source_code;
+
+	/**
+	 * \brief a process-wide table of all source code that's loaded
+	 *
+	 * Each source code is given a small index when it's created. This allows for a location in the source code
+	 * to be stored as an index and an offset, instead of a pointer. Index 0 is never used, which means that it
+	 * represents "no source code". Indices of destroyed source code are reused
+	 */
+	class source_file_table
+	{
+	public:
+		/**
+		 * \brief add the supplied source code to the table. This method is thread-safe
+		 * \param src the source code
+		 * \return the index of the source code; 0 if the table is full
+		 */
+		static std::uint32_t add(const source_code* src);
+
+		/**
+		 * \brief remove the source code with the supplied index. This method is thread-safe
+		 * \param index the index returned by add
+		 */
+		static void remove(std::uint32_t index);
+
+		/**
+		 * \brief get the source code with the supplied index. This method is thread-safe and lock-free
+		 * \param index the index returned by add
+		 * \return the source code; nullptr if the index is 0 or if the source code is removed
+		 */
+		static const source_code* get(std::uint32_t index);
+	};
+}
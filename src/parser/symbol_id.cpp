@@ -0,0 +1,63 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "symbol_id.h"
+#include <unordered_set>
+#include <unordered_map>
+#include <mutex>
+
+using namespace o2;
+
+namespace
+{
+	// the number of shards the interned ids are spread across. Each shard has its own lock, so threads that
+	// intern different ids rarely have to wait for each other
+	constexpr std::size_t shard_count = 64;
+
+	struct interned_ids
+	{
+		std::mutex mutex;
+		// the elements in an unordered_set never move, which allows us to point directly to them
+		std::unordered_set<string> ids;
+	};
+
+	interned_ids& get_interned_ids(std::size_t hash)
+	{
+		static interned_ids instance[shard_count];
+		return instance[hash % shard_count];
+	}
+
+	/**
+	 * \brief the ids the current thread has interned so far
+	 *
+	 * The keys point to the interned strings, which are never released, so a thread can find the ids it has seen
+	 * before without taking a lock
+	 */
+	std::unordered_map<string_view, const string*>& get_local_ids()
+	{
+		thread_local std::unordered_map<string_view, const string*> instance;
+		return instance;
+	}
+}
+
+symbol_id symbol_id::intern(string_view id)
+{
+	if (id.empty())
+		return {};
+
+	auto& local = get_local_ids();
+	const auto it = local.find(id);
+	if (it != local.end())
+		return symbol_id(it->second);
+
+	auto& interned = get_interned_ids(std::hash<string_view>()(id));
+	const string* value;
+	{
+		const std::lock_guard<std::mutex> lock(interned.mutex);
+		value = &*interned.ids.emplace(id).first;
+	}
+	local.emplace(*value, value);
+	return symbol_id(value);
+}
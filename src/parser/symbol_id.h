@@ -0,0 +1,94 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include "strings.h"
+
+namespace o2
+{
+	/**
+	 * \brief an interned, unique id for a symbol or a name
+	 *
+	 * Two symbol ids with the same textual value always point to the same interned string, which means that
+	 * they can be compared using a pointer comparison. Interned strings are kept alive for the lifetime
+	 * of the process. Identifiers are interned when the source code is lexed, so names found in the syntax tree
+	 * are compared and hashed as symbol ids as well.
+	 */
+	class symbol_id
+	{
+	public:
+		symbol_id()
+				: _value()
+		{
+		}
+
+		/**
+		 * \brief get an id for the supplied string. This method is thread-safe
+		 * \param id the textual id
+		 * \return the interned symbol id. An empty string results in an invalid id
+		 */
+		static symbol_id intern(string_view id);
+
+		/**
+		 * \return true if this id points to an interned string
+		 */
+		[[nodiscard]] bool valid() const
+		{
+			return _value != nullptr;
+		}
+
+		/**
+		 * \return the textual representation of this id
+		 */
+		[[nodiscard]] string_view str() const
+		{
+			if (_value)
+				return *_value;
+			return {};
+		}
+
+		/**
+		 * \return a hash of this id
+		 */
+		[[nodiscard]] std::size_t hash() const
+		{
+			return std::hash<const string*>()(_value);
+		}
+
+		bool operator==(const symbol_id& rhs) const
+		{
+			return _value == rhs._value;
+		}
+
+		bool operator!=(const symbol_id& rhs) const
+		{
+			return _value != rhs._value;
+		}
+
+	private:
+		explicit symbol_id(const string* value)
+				: _value(value)
+		{
+		}
+
+	private:
+		const string* _value;
+	};
+
+	inline basic_ostream& operator<<(basic_ostream& stream, const symbol_id& id)
+	{
+		return stream << id.str();
+	}
+}
+
+template<>
+struct std::hash<o2::symbol_id>
+{
+	std::size_t operator()(const o2::symbol_id& id) const noexcept
+	{
+		return id.hash();
+	}
+};
@@ -0,0 +1,118 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "symbol_table.h"
+#include "node.h"
+#include <algorithm>
+
+using namespace o2;
+
+symbol_table::symbol_table()
+		: _next_order(0)
+{
+}
+
+void symbol_table::add(node* n, array_view<node*> children)
+{
+	const entry e{ n, _next_order++ };
+
+	// nodes that allow for passthrough are always queried, because they expose their children
+	if (bit_isset(n->get_query_access_modifiers(), node::query_access_modifier_passthrough))
+		_passthrough.add(e);
+	else
+	{
+		vector<symbol_id> names;
+		n->get_symbol_names(&names);
+		for (auto name: names)
+		{
+			if (name.valid())
+				_named[name].add(e);
+		}
+	}
+
+	// children are usually added last. Nodes that replace, or are inserted amongst, the existing children
+	// must be queried at their position and not at the end
+	if (children[children.size() - 1] != n)
+		reorder(children);
+}
+
+void symbol_table::reorder(array_view<node*> children)
+{
+	std::unordered_map<const node*, int> positions;
+	for (int i = 0; i < children.size(); ++i)
+		positions[children[i]] = i;
+
+	const auto update = [&positions](entries* list)
+	{
+		for (auto& e: *list)
+			e.order = positions[e.n];
+		std::sort(list->begin(), list->end(), [](const entry& lhs, const entry& rhs)
+		{
+			return lhs.order < rhs.order;
+		});
+	};
+	update(&_passthrough);
+	for (auto& named: _named)
+		update(&named.second);
+	_next_order = children.size();
+}
+
+void symbol_table::remove(node* n)
+{
+	if (bit_isset(n->get_query_access_modifiers(), node::query_access_modifier_passthrough))
+	{
+		remove(&_passthrough, n);
+		return;
+	}
+
+	vector<symbol_id> names;
+	n->get_symbol_names(&names);
+	for (auto name: names)
+	{
+		if (!name.valid())
+			continue;
+		const auto it = _named.find(name);
+		if (it == _named.end())
+			continue;
+		remove(&it->second, n);
+		if (it->second.empty())
+			_named.erase(it);
+	}
+}
+
+void symbol_table::remove(entries* e, node* n)
+{
+	for (int i = 0; i < e->size(); ++i)
+	{
+		if ((*e)[i].n == n)
+		{
+			e->remove_at(i);
+			return;
+		}
+	}
+}
+
+void symbol_table::query(query_node_visitor* visitor, symbol_id name, int flags) const
+{
+	const auto it = _named.find(name);
+	if (it == _named.end())
+	{
+		for (auto e: _passthrough)
+			e.n->query(visitor, flags);
+		return;
+	}
+
+	// merge the named nodes with the passthrough nodes, so that they are queried in the same order
+	// as they are found amongst the children
+	const auto& named = it->second;
+	int i = 0, j = 0;
+	while (i < named.size() || j < _passthrough.size())
+	{
+		if (j == _passthrough.size() || (i < named.size() && named[i].order < _passthrough[j].order))
+			named[i++].n->query(visitor, flags);
+		else
+			_passthrough[j++].n->query(visitor, flags);
+	}
+}
@@ -0,0 +1,75 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include "symbol_id.h"
+#include "collections/vector.h"
+#include <unordered_map>
+
+namespace o2
+{
+	class node;
+
+	class query_node_visitor;
+
+	/**
+	 * \brief an index of the children of a node that owns a scope
+	 *
+	 * Children are indexed on the names they can be referred to by. Children that allow for passthrough
+	 * querying are always part of a lookup, since they expose their own children as well, which is why they
+	 * are never indexed on a name. Nodes are always returned in the same order as they are found amongst the
+	 * children.
+	 */
+	class symbol_table
+	{
+	public:
+		symbol_table();
+
+		/**
+		 * \brief add the supplied node to this table
+		 * \param n the node
+		 * \param children the children of the node that owns this table, which the node is already part of
+		 */
+		void add(node* n, array_view<node*> children);
+
+		/**
+		 * \brief remove the supplied node from this table
+		 * \param n the node
+		 */
+		void remove(node* n);
+
+		/**
+		 * \brief query all nodes that might be of interest for a visitor searching for the supplied name
+		 * \param visitor the visitor
+		 * \param name the name we are searching for
+		 * \param flags the flags used when querying each node
+		 */
+		void query(query_node_visitor* visitor, symbol_id name, int flags) const;
+
+	private:
+		struct entry
+		{
+			node* n;
+			// where the node is found amongst the children, relative to the other nodes in this table
+			int order;
+		};
+
+		// most names are only declared once in a scope
+		typedef vector<entry, 1> entries;
+
+		static void remove(entries* e, node* n);
+
+		/**
+		 * \brief recalculate the order of all nodes, after a node is inserted before the last child
+		 */
+		void reorder(array_view<node*> children);
+
+	private:
+		std::unordered_map<symbol_id, entries> _named;
+		entries _passthrough;
+		int _next_order;
+	};
+}
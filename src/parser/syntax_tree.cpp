@@ -12,87 +12,112 @@
 using namespace o2;
 
 syntax_tree::syntax_tree(llvm::LLVMContext& lc)
-		: _root(), _context(lc), _builder(_context)
+		: _arena(4 * 1024), _root(), _context(lc), _builder(_context)
 {
+	const memory_arena_scope arena_scope(&_arena);
+
 	// added predefined primitive types
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("void")),
 					0,
 					primitive_type::unknown,
-					_builder.getVoidTy()));
+					_builder.getVoidTy(),
+					0));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("byte")),
 					1,
 					primitive_type::uint8,
-					_builder.getInt1Ty()));
+					_builder.getInt1Ty(),
+					1));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("bool")),
 					4,
 					primitive_type::bool_,
-					_builder.getInt32Ty()));
+					_builder.getInt32Ty(),
+					2));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("int8")),
 					sizeof(int8_t),
 					primitive_type::int8,
-					_builder.getInt8Ty()));
+					_builder.getInt8Ty(),
+					3));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("uint8")),
 					sizeof(uint8_t),
 					primitive_type::uint8,
-					_builder.getInt8Ty()));
+					_builder.getInt8Ty(),
+					4));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("int16")),
 					sizeof(int16_t),
 					primitive_type::int16,
-					_builder.getInt16Ty()));
+					_builder.getInt16Ty(),
+					5));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("uint16")),
 					sizeof(uint16_t),
 					primitive_type::uint16,
-					_builder.getInt16Ty()));
+					_builder.getInt16Ty(),
+					6));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("int"), STR("int32")),
 					sizeof(int32_t),
 					primitive_type::int32,
-					_builder.getInt32Ty()));
+					_builder.getInt32Ty(),
+					7));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("uint"), STR("uint32")),
 					sizeof(uint32_t),
 					primitive_type::uint32,
-					_builder.getInt32Ty()));
+					_builder.getInt32Ty(),
+					8));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("int64")),
 					sizeof(int64_t),
 					primitive_type::int64,
-					_builder.getInt64Ty()));
+					_builder.getInt64Ty(),
+					9));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("uint64")),
 					sizeof(uint64_t),
 					primitive_type::uint64,
-					_builder.getInt64Ty()));
+					_builder.getInt64Ty(),
+					10));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("float"), STR("float32")),
 					sizeof(float),
 					primitive_type::float32,
-					_builder.getFloatTy()));
+					_builder.getFloatTy(),
+					11));
 	_root.add_child(
 			o2_new node_type_primitive(
 					vector<string_view>(STR("float64")),
 					sizeof(double),
 					primitive_type::float64,
-					_builder.getDoubleTy()));
+					_builder.getDoubleTy(),
+					12));
+
+	// the primitives are the first children of the root package. They are also kept separately, because the
+	// children of the root package change when modules are added to it while packages are parsed
+	for (int i = 0; i < PRIMITIVES_COUNT; ++i)
+	{
+		_primitives[i] = _root.get_child(i)->as<node_type_primitive>();
+		// the primitives don't refer to anything, so there's nothing to resolve. This also makes sure that the
+		// packages, which are resolved in parallel, never change them
+		_primitives[i]->remove_phases_left(node::phase_resolve);
+	}
 }
 
 void syntax_tree::debug() const
@@ -110,7 +135,7 @@ void syntax_tree::debug(debug_ostream& stream) const
 	_root.debug(stream, 1);
 }
 
-void syntax_tree::optimize(node_optimizer* optimizer)
+void syntax_tree::optimize(optimization_pass_manager* passes)
 {
-	_root.optimize(optimizer);
+	passes->optimize(&_root);
 }
@@ -6,10 +6,14 @@
 #pragma once
 
 #include "package/node_root.h"
+#include "memory_arena.h"
+#include "optimizations/optimization_pass_manager.h"
 #include <llvm/IR/IRBuilder.h>
 
 namespace o2
 {
+	class node_type_primitive;
+
 	/**
 	 * \brief start of the entire syntax tree
 	 *
@@ -18,6 +22,9 @@ namespace o2
 	class syntax_tree
 	{
 	public:
+		// the number of predefined primitive types
+		static constexpr int PRIMITIVES_COUNT = 13;
+
 		explicit syntax_tree(llvm::LLVMContext& lc);
 
 		/**
@@ -36,6 +43,19 @@ namespace o2
 			return &_root;
 		}
 
+		/**
+		 * \brief get a predefined primitive type
+		 * \param idx the index of the primitive
+		 * \return the primitive; nullptr if the index is out of range
+		 * \remark this is safe to call from more than one thread while modules are added to the root package
+		 */
+		[[nodiscard]] node_type_primitive* get_primitive(int idx) const
+		{
+			if (idx < 0 || idx >= PRIMITIVES_COUNT)
+				return nullptr;
+			return _primitives[idx];
+		}
+
 		/**
 		 * \brief print out debug information to stdout
 		 */
@@ -48,13 +68,16 @@ namespace o2
 		void debug(debug_ostream& stream) const;
 
 		/**
-		 * \brief try to optimize the syntax tree using the supplied optimizer
-		 * \param optimizer 
+		 * \brief try to optimize the syntax tree using the supplied optimization passes
+		 * \param passes
 		 */
-		void optimize(node_optimizer* optimizer);
+		void optimize(optimization_pass_manager* passes);
 
 	private:
+		// arena for the built-in nodes. Must be declared before the root so that it outlives all nodes
+		memory_arena _arena;
 		node_root _root;
+		node_type_primitive* _primitives[PRIMITIVES_COUNT];
 
 		llvm::LLVMContext& _context;
 		llvm::IRBuilder<> _builder;
@@ -5,9 +5,11 @@
 
 #include "token.h"
 #include "strings.h"
+#include "scanner.h"
+#include "literal.h"
 #include <cmath>
-#include <cfloat>
 #include <algorithm>
+#include <array>
 
 using namespace o2;
 
@@ -151,11 +153,178 @@ namespace
 	{
 		return c == '\n';
 	}
-}
 
-int token::line_offset() const
-{
-	return (int)(_pos - _line_offset);
+	// number of characters that are tested one at a time before the vectorized scanner is used. Most identities
+	// and whitespace runs are shorter than this, and for those the call costs more than it saves
+	constexpr int scalar_prefix_length = 16;
+
+	inline const string_literal* skip_whitespace(const string_literal* p)
+	{
+		for (int i = 0; i < scalar_prefix_length; ++i, ++p)
+		{
+			if (!is_whitespace(*p))
+				return p;
+		}
+		return scanner::get()->skip_whitespace(p);
+	}
+
+	inline const string_literal* skip_keyword(const string_literal* p)
+	{
+		for (int i = 0; i < scalar_prefix_length; ++i, ++p)
+		{
+			if (!is_keyword_mid(*p))
+				return p;
+		}
+		return scanner::get()->skip_identity(p);
+	}
+
+	struct keyword
+	{
+		string_view name;
+		token_type type;
+	};
+
+	// all words that are not identities
+	constexpr keyword keywords[] = {
+			{ STR("public"), token_type::public_ },
+			{ STR("private"), token_type::private_ },
+			{ STR("internal"), token_type::internal_ },
+			{ STR("type"), token_type::type },
+			{ STR("macro"), token_type::macro },
+			{ STR("func"), token_type::func },
+			{ STR("cast"), token_type::cast },
+			{ STR("interface"), token_type::interface },
+			{ STR("trait"), token_type::trait },
+			{ STR("if"), token_type::if_ },
+			{ STR("else"), token_type::else_ },
+			{ STR("var"), token_type::var },
+			{ STR("for"), token_type::for_ },
+			{ STR("import"), token_type::import },
+			{ STR("return"), token_type::return_ },
+			{ STR("struct"), token_type::struct_ },
+			{ STR("as"), token_type::as },
+			{ STR("this"), token_type::this_ },
+			{ STR("base"), token_type::base },
+			{ STR("void"), token_type::void_ },
+			{ STR("static"), token_type::static_ },
+			{ STR("inline"), token_type::inline_ },
+			{ STR("virtual"), token_type::virtual_ },
+			{ STR("override"), token_type::override_ },
+			{ STR("final"), token_type::final_ },
+			{ STR("extern"), token_type::extern_ },
+			{ STR("const"), token_type::const_ },
+			{ STR("true"), token_type::boolean },
+			{ STR("false"), token_type::boolean },
+	};
+	constexpr int keywords_count = sizeof(keywords) / sizeof(keyword);
+
+	constexpr size_t keyword_min_length = []()
+	{
+		size_t result = keywords[0].name.length();
+		for (const auto& k: keywords)
+			result = std::min(result, k.name.length());
+		return result;
+	}();
+
+	constexpr size_t keyword_max_length = []()
+	{
+		size_t result = 0;
+		for (const auto& k: keywords)
+			result = std::max(result, k.name.length());
+		return result;
+	}();
+
+	static_assert(keyword_min_length >= 2, "the keyword hash reads the first two characters");
+
+	// number of bits in the hash, which makes the hash table four times larger than the number of keywords
+	constexpr int keyword_hash_bits = 7;
+	static_assert((1 << keyword_hash_bits) >= keywords_count * 4);
+
+	/**
+	 * \brief hash a word that's between keyword_min_length and keyword_max_length characters long
+	 */
+	constexpr std::uint32_t keyword_hash(string_view str, std::uint32_t seed)
+	{
+		std::uint32_t h = seed ^ (std::uint32_t)str.length();
+		h = (h ^ (std::uint32_t)str[0]) * 0x01000193u;
+		h = (h ^ (std::uint32_t)str[1]) * 0x01000193u;
+		h = (h ^ (std::uint32_t)str[str.length() - 1]) * 0x01000193u;
+		return h >> (32 - keyword_hash_bits);
+	}
+
+	struct keyword_hash_table
+	{
+		std::uint32_t seed;
+		// index+1 into the keywords array. 0 means that the slot is empty
+		std::array<std::uint8_t, 1 << keyword_hash_bits> slots;
+	};
+
+	// search for a seed that gives each keyword its own slot
+	constexpr keyword_hash_table keyword_table = []()
+	{
+		for (std::uint32_t seed = 0; seed < 1u << 16; ++seed)
+		{
+			keyword_hash_table table{ seed, {} };
+			bool collision = false;
+			for (int i = 0; i < keywords_count && !collision; ++i)
+			{
+				auto& slot = table.slots[keyword_hash(keywords[i].name, seed)];
+				collision = slot != 0;
+				slot = (std::uint8_t)(i + 1);
+			}
+			if (!collision)
+				return table;
+		}
+		return keyword_hash_table{ 0, {} };
+	}();
+
+	constexpr token_type find_keyword(string_view str)
+	{
+		const auto len = str.length();
+		if (len < keyword_min_length || len > keyword_max_length)
+			return token_type::identity;
+		const auto slot = keyword_table.slots[keyword_hash(str, keyword_table.seed)];
+		if (slot == 0 || keywords[slot - 1].name != str)
+			return token_type::identity;
+		return keywords[slot - 1].type;
+	}
+
+	// number of times the supplied token type is found in the keywords array
+	constexpr int count_keywords(token_type tt)
+	{
+		int result = 0;
+		for (const auto& k: keywords)
+			if (k.type == tt)
+				result++;
+		return result;
+	}
+
+	constexpr bool is_word_token(token_type tt)
+	{
+		return token::is_scope(tt) || token::is_keyword(tt) || token::is_storage_class(tt) ||
+			   tt == token_type::const_ || tt == token_type::boolean;
+	}
+
+	// verify that the keywords array matches the token_type enum and that the keywords are found using the hash table
+	constexpr bool validate_keywords()
+	{
+		for (const auto& k: keywords)
+		{
+			if (!is_word_token(k.type) || find_keyword(k.name) != k.type)
+				return false;
+		}
+		for (int i = 0; i <= (int)token_type::eof; ++i)
+		{
+			const auto tt = (token_type)i;
+			if (tt == token_type::boolean)
+				continue;
+			if (count_keywords(tt) != (is_word_token(tt) ? 1 : 0))
+				return false;
+		}
+		return count_keywords(token_type::boolean) == 2;
+	}
+
+	static_assert(validate_keywords(), "keywords does not match the token_type enum");
 }
 
 int token::offset() const
@@ -170,8 +339,8 @@ token_type token::next()
 	if (c == 0)
 		return eof();
 
-	while (is_whitespace(c))
-		c = *++_pos;
+	if (is_whitespace(c))
+		_pos = skip_whitespace(_pos + 1);
 	next0();
 	return _type;
 }
@@ -218,57 +387,66 @@ token_type token::next_until_not(token_type t1, token_type t2, token_type t3)
 
 std::int64_t token::value_int64() const
 {
-	if (_type == token_type::hex)
-		return w_hextoi64(_string_start, static_cast<int>(_string_end - _string_start));
-	return w_strtoi64(_string_start, static_cast<int>(_string_end - _string_start));
+	return to_int64(_type, value());
 }
 
 std::uint64_t token::value_uint64() const
 {
-	if (_type == token_type::hex)
-		return w_hextou64(_string_start, static_cast<int>(_string_end - _string_start));
-	return w_strtou64(_string_start, static_cast<int>(_string_end - _string_start));
+	return to_uint64(value());
 }
 
 bool token::value_bool() const
 {
-	return w_streqn(_string_start, static_cast<int>(_string_end - _string_start), STR("true"), 4);
+	return to_bool(value());
 }
 
 float token::value_float32() const
 {
-	// copy each string literal into a char byte array
-	char buf[std::numeric_limits<float>::max_digits10 + 1];
-	char* dest = buf;
-	auto ptr = _string_start;
-	const auto end = _string_end;
-	for (; ptr != end;)
-		*dest++ = char(*ptr++);
-	*dest = 0;
-
-	const float v = strtof(buf, NULL);
-	if (v < (FLT_MAX - FLT_EPSILON) && v > (FLT_MIN + FLT_EPSILON))
-		return v;
-	else
-		return 0;
+	return to_float32(value());
 }
 
 double token::value_float64() const
 {
-	// copy each string literal into a char byte array
-	char buf[std::numeric_limits<double>::max_digits10 + 1];
-	char* dest = buf;
-	auto ptr = _string_start;
-	const auto end = _string_end;
-	for (; ptr != end;)
-		*dest++ = char(*ptr++);
-	*dest = 0;
-
-	const double v = strtod(buf, NULL);
-	if (v < (DBL_MAX - DBL_EPSILON) && v > (DBL_MIN + DBL_EPSILON))
-		return v;
-	else
+	return to_float64(value());
+}
+
+std::int64_t token::to_int64(token_type tt, string_view value)
+{
+	if (tt == token_type::hex)
+		return (std::int64_t)to_uint64(value);
+	std::int64_t result = 0;
+	if (literal_decode_int64(value, &result) != literal_status::ok)
+		return 0;
+	return result;
+}
+
+std::uint64_t token::to_uint64(string_view value)
+{
+	std::uint64_t result = 0;
+	if (literal_decode_uint64(value, &result) != literal_status::ok)
+		return 0;
+	return result;
+}
+
+bool token::to_bool(string_view value)
+{
+	return w_streqn(value.data(), static_cast<int>(value.length()), STR("true"), 4);
+}
+
+float token::to_float32(string_view value)
+{
+	float result = 0;
+	if (literal_decode_float32(value, &result) != literal_status::ok)
+		return 0;
+	return result;
+}
+
+double token::to_float64(string_view value)
+{
+	double result = 0;
+	if (literal_decode_float64(value, &result) != literal_status::ok)
 		return 0;
+	return result;
 }
 
 void token::next0()
@@ -307,6 +485,12 @@ void token::next0()
 		atom(token_type::bracket_left);
 		break;
 	case '&':
+		if (peek(1) == '&')
+		{
+			_pos++;
+			atom(token_type::logical_and);
+			break;
+		}
 		atom(token_type::ref);
 		break;
 	case '*':
@@ -373,6 +557,12 @@ void token::next0()
 		next_plus_or_inc();
 		break;
 	case '|':
+		if (peek(1) == '|')
+		{
+			_pos++;
+			atom(token_type::logical_or);
+			break;
+		}
 		atom(token_type::bit_or);
 		break;
 	case '^':
@@ -383,8 +573,6 @@ void token::next0()
 		break;
 	case '\n':
 		atom(token_type::newline);
-		_line++;
-		_line_offset = _pos;
 		break;
 	case 0:
 		eof();
@@ -430,27 +618,15 @@ void token::next_string(char c)
 		return;
 	}
 
-	bool escaped = false;
-	while (*_pos != 0)
+	const auto s = scanner::get();
+	while (*(_pos = s->find_quote(_pos, c)) != 0)
 	{
-		if (*_pos == '\\' && !escaped)
-		{
-			escaped = true;
-			_pos++;
-			continue;
-		}
-
-		if (escaped)
-		{
-			escaped = false;
-			_pos++;
-			continue;
-		}
+		if (*_pos == c)
+			break;
 
-		if (*_pos == c && !escaped)
-		{
+		// skip the escaped character
+		if (*++_pos == 0)
 			break;
-		}
 		_pos++;
 	}
 	_string_start = start;
@@ -487,13 +663,14 @@ void token::next_number()
 		// Ignore all digits
 		while (is_digit(*_pos)) _pos++;
 
-		// This might be a value with format -3.402823466e+38f
-		if (*_pos == 'e')
+		// This might be a value with format -3.402823466e+38f or 1.5e10
+		if (*_pos == 'e' || *_pos == 'E')
 		{
-			string_view::value_type peek = *(_pos + 1);
-			if (peek == '+' || peek == '-')
+			const string_view::value_type peek = *(_pos + 1);
+			const int sign = (peek == '+' || peek == '-') ? 1 : 0;
+			if (is_digit(*(_pos + 1 + sign)))
 			{
-				_pos += 2;
+				_pos += 1 + sign;
 
 				// Ignore all numbers
 				while (is_digit(*_pos)) _pos++;
@@ -534,10 +711,10 @@ void token::next_number()
 
 void token::next_keyword()
 {
-	const auto start = _pos++;
+	const auto start = _pos;
 
 	// Ignore all characters
-	while (is_keyword_mid(*_pos)) _pos++;
+	_pos = skip_keyword(_pos + 1);
 
 	_string_start = start;
 	_string_end = _pos;
@@ -551,10 +728,13 @@ void token::next_comment_or_div()
 	auto n = peek(1);
 	if (n == '/')
 	{
-		const string_view::value_type* start = ++_pos;
-		while (*_pos != 0 && *_pos != '\n') _pos++;
-		_string_start = start + 1;
-		_string_end = _pos - 1;
+		// skip "//"
+		const auto start = _pos + 2;
+		_pos = scanner::get()->find_newline(start);
+		_string_start = start;
+		_string_end = _pos;
+		if (_string_end != _string_start && *(_string_end - 1) == '\r')
+			_string_end--;
 		_type = token_type::comment;
 		return;
 	}
@@ -565,28 +745,22 @@ void token::next_comment_or_div()
 		return;
 	}
 
-	const string_view::value_type* start = ++_pos;
-	if (_pos != 0)
-		start++;
-	while (*_pos != 0)
+	// skip "/*"
+	const auto start = _pos + 2;
+	const auto s = scanner::get();
+	_pos = start;
+	while (*(_pos = s->find_star(_pos)) != 0)
 	{
-		if (*_pos != '*')
-		{
-			_pos++;
-			continue;
-		}
-
 		if (peek(1) == '/')
-		{
-			_pos++;
 			break;
-		}
 		_pos++;
 	}
 
 	_string_start = start;
-	_string_end = _pos - 1;
-	_pos++;
+	_string_end = _pos;
+	// skip "*/", unless the comment isn't terminated
+	if (*_pos != 0)
+		_pos += 2;
 	_type = token_type::comment;
 }
 
@@ -623,6 +797,13 @@ void token::next_lt_or_lte()
 		return;
 	}
 
+	if (peek(1) == '<')
+	{
+		_pos++;
+		atom(token_type::shift_left);
+		return;
+	}
+
 	atom(token_type::test_lt);
 }
 
@@ -635,6 +816,13 @@ void token::next_gt_or_gte()
 		return;
 	}
 
+	if (peek(1) == '>')
+	{
+		_pos++;
+		atom(token_type::shift_right);
+		return;
+	}
+
 	atom(token_type::test_gt);
 }
 
@@ -652,93 +840,5 @@ void token::next_not_or_not_equals()
 
 token_type token::hint_keyword_type() const
 {
-	const auto str = value();
-	const auto len = str.length();
-
-	if (len == 2)
-	{
-		static const string_view IF(STR("if"));
-		static const string_view AS(STR("as"));
-
-		if (str == IF) return token_type::if_;
-		if (str == AS) return token_type::as;
-	}
-	else if (len == 3)
-	{
-		static const string_view FOR(STR("for"));
-		static const string_view VAR(STR("var"));
-
-		if (str == FOR) return token_type::for_;
-		if (str == VAR) return token_type::var;
-	}
-	else if (len == 4)
-	{
-		static const string_view THIS(STR("this"));
-		static const string_view FUNC(STR("func"));
-		static const string_view TYPE(STR("type"));
-		static const string_view ELSE(STR("else"));
-		static const string_view CAST(STR("cast"));
-		static const string_view TRUE_(STR("true"));
-		static const string_view BASE(STR("base"));
-		static const string_view VOID(STR("void"));
-
-		if (str == THIS) return token_type::this_;
-		if (str == FUNC) return token_type::func;
-		if (str == TYPE) return token_type::type;
-		if (str == ELSE) return token_type::else_;
-		if (str == CAST) return token_type::cast;
-		if (str == TRUE_) return token_type::boolean;
-		if (str == BASE) return token_type::base;
-		if (str == VOID) return token_type::void_;
-	}
-	else if (len == 5)
-	{
-		static const string_view CONST(STR("const"));
-		static const string_view FINAL(STR("final"));
-		static const string_view FALSE_(STR("false"));
-		static const string_view TRAIT(STR("trait"));
-
-		if (str == CONST) return token_type::const_;
-		if (str == FINAL) return token_type::final_;
-		if (str == FALSE_) return token_type::boolean;
-		if (str == TRAIT) return token_type::trait;
-	}
-	else if (len == 6)
-	{
-		static const string_view PUBLIC(STR("public"));
-		static const string_view STATIC(STR("static"));
-		static const string_view INLINE(STR("inline"));
-		static const string_view IMPORT(STR("import"));
-		static const string_view RETURN(STR("return"));
-		static const string_view STRUCT(STR("struct"));
-		static const string_view EXTERN(STR("extern"));
-
-		if (str == PUBLIC) return token_type::public_;
-		if (str == STATIC) return token_type::static_;
-		if (str == INLINE) return token_type::inline_;
-		if (str == IMPORT) return token_type::import;
-		if (str == RETURN) return token_type::return_;
-		if (str == STRUCT) return token_type::struct_;
-		if (str == EXTERN) return token_type::extern_;
-	}
-	else if (len == 7)
-	{
-		static const string_view PRIVATE(STR("private"));
-
-		if (str == PRIVATE) return token_type::private_;
-	}
-	else if (len == 8)
-	{
-		static const string_view OVERRIDE(STR("override"));
-
-		if (str == OVERRIDE) return token_type::override_;
-	}
-	else if (len == 9)
-	{
-		static const string_view INTERFACE(STR("interface"));
-
-		if (str == INTERFACE) return token_type::interface;
-	}
-
-	return token_type::identity;
+	return find_keyword(value());
 }
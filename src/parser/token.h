@@ -97,6 +97,10 @@ namespace o2
 		bit_not /* ~ */,
 		bit_or /* | */,
 		bit_xor /* ^ */,
+		shift_left /* << */,
+		shift_right /* >> */,
+		logical_and /* && */,
+		logical_or /* || */,
 
 		dot /* . */,
 		comma /* , */,
@@ -154,8 +158,19 @@ namespace o2
 		token(const lexer* l)
 				: _lexer(l), _pos(l->first()), _type(token_type::unknown),
 				  _modifiers((int)token_modifier::none),
-				  _string_start(_pos), _string_end(_pos),
-				  _line(0), _line_offset(_pos)
+				  _string_start(_pos), _string_end(_pos)
+		{
+		}
+
+		/**
+		 * \brief start reading tokens at the supplied offset in the lexed text
+		 * \param l the lexer
+		 * \param offset the offset, in bytes, where the first token starts
+		 */
+		token(const lexer* l, int offset)
+				: _lexer(l), _pos(l->first() + offset), _type(token_type::unknown),
+				  _modifiers((int)token_modifier::none),
+				  _string_start(_pos), _string_end(_pos)
 		{
 		}
 
@@ -208,24 +223,12 @@ namespace o2
 			return (int)(_string_end - _string_start);
 		}
 
-		/// <returns>Get which line we are parsing at the moment</returns>
-		inline int line() const
-		{
-			return _line;
-		}
-
-		/// <returns>Get the offset, in bytes, on the line we are parsing at the moment</returns>
-		const string_view::value_type* line_start() const
-		{
-			return _line_offset;
-		}
-
 		/// <summary>
 		/// Check to see if the supplied token is a scope keyword
 		/// </summary>
 		/// <param name="tt"></param>
 		/// <returns></returns>
-		static bool is_scope(token_type tt)
+		static constexpr bool is_scope(token_type tt)
 		{
 			return tt > token_type::scope_start && tt < token_type::scope_end;
 		}
@@ -235,7 +238,7 @@ namespace o2
 		/// </summary>
 		/// <param name="tt"></param>
 		/// <returns></returns>
-		static bool is_value(token_type tt)
+		static constexpr bool is_value(token_type tt)
 		{
 			return tt > token_type::values_start && tt < token_type::values_end;
 		}
@@ -245,7 +248,7 @@ namespace o2
 		/// </summary>
 		/// <param name="tt"></param>
 		/// <returns></returns>
-		static bool is_keyword(token_type tt)
+		static constexpr bool is_keyword(token_type tt)
 		{
 			return tt > token_type::keyword_start && tt < token_type::keyword_end;
 		}
@@ -255,7 +258,7 @@ namespace o2
 		/// </summary>
 		/// <param name="tt"></param>
 		/// <returns></returns>
-		static bool is_storage_class(token_type tt)
+		static constexpr bool is_storage_class(token_type tt)
 		{
 			return tt > token_type::storage_class_start && tt < token_type::storage_class_end;
 		}
@@ -265,14 +268,11 @@ namespace o2
 		/// </summary>
 		/// <param name="tt"></param>
 		/// <returns></returns>
-		static bool is_type_modifier(token_type tt)
+		static constexpr bool is_type_modifier(token_type tt)
 		{
 			return tt > token_type::type_modifier_start && tt < token_type::type_modifier_end;
 		}
 
-		/// <returns>Get the offset, in bytes, on the line we are parsing at the moment</returns>
-		int line_offset() const;
-
 		/// <returns>Get the offset, in bytes, in the source code we are parsing at the moment</returns>
 		int offset() const;
 
@@ -334,6 +334,34 @@ namespace o2
 		 */
 		double value_float64() const;
 
+		/**
+		 * \param tt the token type
+		 * \param value the token value
+		 * \return the supplied value as a 64bit integer
+		 */
+		static std::int64_t to_int64(token_type tt, string_view value);
+
+		/**
+		 * \param value the token value. Hexadecimal values are detected by their prefix
+		 * \return the supplied value as a unsigned 64bit integer
+		 */
+		static std::uint64_t to_uint64(string_view value);
+
+		/**
+		 * \return the supplied value as a boolean
+		 */
+		static bool to_bool(string_view value);
+
+		/**
+		 * \return the supplied value as a float value
+		 */
+		static float to_float32(string_view value);
+
+		/**
+		 * \return the supplied value as a double
+		 */
+		static double to_float64(string_view value);
+
 	private:
 		/// <summary>
 		/// Get the next token
@@ -411,8 +439,5 @@ namespace o2
 
 		const string_literal* _string_start;
 		const string_literal* _string_end;
-
-		int _line;
-		const string_literal* _line_offset;
 	};
 }
\ No newline at end of file
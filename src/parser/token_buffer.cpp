@@ -0,0 +1,97 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#include "token_buffer.h"
+
+using namespace o2;
+
+static_assert((int)token_type::eof <= UINT8_MAX, "token types are stored as bytes");
+
+token_buffer::token_buffer(string_view text)
+		: token_buffer(text, 0, (int)text.length())
+{
+}
+
+token_buffer::token_buffer(string_view text, int begin, int end)
+		: _text(text)
+{
+	assert(begin >= 0 && begin <= end && end <= (int)text.length() && "invalid range");
+
+	// most tokens are a few characters long, so this is usually enough to never grow the arrays
+	const int expected_tokens = (end - begin) / 4 + 2;
+	_types.reserve(expected_tokens);
+	_modifiers.reserve(expected_tokens);
+	_offsets.reserve(expected_tokens);
+	_lengths.reserve(expected_tokens);
+	_ends.reserve(expected_tokens);
+	_ids.reserve(expected_tokens);
+
+	// the position before the first token
+	add(token_type::unknown, (int)token_modifier::none, begin, 0, begin, symbol_id());
+
+	const lexer l(text);
+	token t(&l, begin);
+	while (true)
+	{
+		const auto tt = t.next();
+		const auto value = t.value();
+		const auto offset = (int)(value.data() - text.data());
+		if (tt == token_type::eof || offset >= end)
+			break;
+		add(tt, t.get_modifiers(), offset, (int)value.length(), t.offset(),
+				tt == token_type::identity ? symbol_id::intern(value) : symbol_id());
+	}
+	add(token_type::eof, (int)token_modifier::none, end, 0, end, symbol_id());
+}
+
+void token_buffer::add(token_type type, int modifiers, int offset, int length, int end, symbol_id id)
+{
+	_types.add((std::uint8_t)type);
+	_modifiers.add((std::uint8_t)modifiers);
+	_offsets.add((std::uint32_t)offset);
+	_lengths.add((std::uint32_t)length);
+	_ends.add((std::uint32_t)end);
+	_ids.add(id);
+}
+
+token_type token_cursor::next_until(token_type t1)
+{
+	token_type res = next();
+	while (res != t1 && res != token_type::eof)
+		res = next();
+	return res;
+}
+
+token_type token_cursor::next_until(token_type t1, token_type t2)
+{
+	token_type res = next();
+	while (res != t1 && res != t2 && res != token_type::eof)
+		res = next();
+	return res;
+}
+
+token_type token_cursor::next_until_not(token_type t1)
+{
+	token_type res = next();
+	while (res == t1)
+		res = next();
+	return res;
+}
+
+token_type token_cursor::next_until_not(token_type t1, token_type t2)
+{
+	token_type res = next();
+	while (res == t1 || res == t2)
+		res = next();
+	return res;
+}
+
+token_type token_cursor::next_until_not(token_type t1, token_type t2, token_type t3)
+{
+	token_type res = next();
+	while (res == t1 || res == t2 || res == t3)
+		res = next();
+	return res;
+}
@@ -0,0 +1,300 @@
+//
+// Part of the o2 Project, under the Apache License v2.0 with o2 Project Exceptions.
+// See the LICENSE file in the project root for license terms
+//
+
+#pragma once
+
+#include "token.h"
+#include "symbol_id.h"
+#include "collections/vector.h"
+#include <cstdint>
+
+namespace o2
+{
+	/**
+	 * \brief all tokens in a source code
+	 *
+	 * The source code is lexed once, up front, and the tokens are stored as a structure of arrays. The first
+	 * token is always an unknown token, which represents the position before the source code is read, and the last
+	 * token is always the eof token. Identities are interned while lexing, which means that names can be compared
+	 * using their symbol ids from here on
+	 */
+	class token_buffer
+	{
+	public:
+		/**
+		 * \brief lex all tokens in the supplied text
+		 * \param text a null-terminated text
+		 */
+		explicit token_buffer(string_view text);
+
+		/**
+		 * \brief lex the tokens that start in the supplied range of the text. The offsets of the tokens are still
+		 *        relative to the beginning of the text
+		 * \param text a null-terminated text
+		 * \param begin the offset of the first character to lex
+		 * \param end the offset after the last character to lex. The eof token is put at this position
+		 */
+		token_buffer(string_view text, int begin, int end);
+
+		token_buffer(const token_buffer&) = delete;
+
+		token_buffer& operator=(const token_buffer&) = delete;
+
+		/**
+		 * \return the number of tokens, including the leading unknown token and the eof token
+		 */
+		[[nodiscard]] int size() const
+		{
+			return _types.size();
+		}
+
+		/**
+		 * \return the text the tokens are lexed from
+		 */
+		[[nodiscard]] string_view get_text() const
+		{
+			return _text;
+		}
+
+		/**
+		 * \return the type of the token at the supplied index
+		 */
+		[[nodiscard]] token_type get_type(int idx) const
+		{
+			return (token_type)_types[idx];
+		}
+
+		/**
+		 * \return the modifiers of the token at the supplied index
+		 */
+		[[nodiscard]] int get_modifiers(int idx) const
+		{
+			return _modifiers[idx];
+		}
+
+		/**
+		 * \return the value of the token at the supplied index
+		 */
+		[[nodiscard]] string_view get_value(int idx) const
+		{
+			return string_view(_text.data() + _offsets[idx], _lengths[idx]);
+		}
+
+		/**
+		 * \return the interned value of the token at the supplied index. Only identities have a valid id
+		 */
+		[[nodiscard]] symbol_id get_id(int idx) const
+		{
+			return _ids[idx];
+		}
+
+		/**
+		 * \return the offset, in the text, of the first character after the token at the supplied index
+		 */
+		[[nodiscard]] int get_end(int idx) const
+		{
+			return (int)_ends[idx];
+		}
+
+	private:
+		void add(token_type type, int modifiers, int offset, int length, int end, symbol_id id);
+
+	private:
+		const string_view _text;
+
+		vector<std::uint8_t, 1> _types;
+		vector<std::uint8_t, 1> _modifiers;
+		vector<std::uint32_t, 1> _offsets;
+		vector<std::uint32_t, 1> _lengths;
+		vector<std::uint32_t, 1> _ends;
+		vector<symbol_id, 1> _ids;
+	};
+
+	/**
+	 * \brief a position in a token buffer
+	 *
+	 * The cursor has the same interface as the token, but it can look at the tokens ahead of it without
+	 * consuming them, and it can go back to a previous position
+	 */
+	class token_cursor
+	{
+	public:
+		explicit token_cursor(const token_buffer* buffer)
+				: _buffer(buffer), _idx(0), _last(buffer->size() - 1)
+		{
+		}
+
+		/**
+		 * \brief check if the supplied token type is the current token
+		 */
+		[[nodiscard]] bool is(token_type t) const
+		{
+			return type() == t;
+		}
+
+		/**
+		 * \return the current token type
+		 */
+		[[nodiscard]] token_type type() const
+		{
+			return _buffer->get_type(_idx);
+		}
+
+		/**
+		 * \return the type of the token n steps ahead of the current token. eof if it's past the last token
+		 */
+		[[nodiscard]] token_type peek(int n) const
+		{
+			const auto idx = _idx + n;
+			return _buffer->get_type(idx < _last ? idx : _last);
+		}
+
+		/**
+		 * \return the current position. Use it with seek to go back to this position
+		 */
+		[[nodiscard]] int position() const
+		{
+			return _idx;
+		}
+
+		/**
+		 * \brief move the cursor to a position returned by position
+		 */
+		void seek(int position)
+		{
+			assert(position >= 0 && position <= _last && "invalid token position");
+			_idx = position;
+		}
+
+		/**
+		 * \return a modifier associated with the current token
+		 */
+		[[nodiscard]] int get_modifiers() const
+		{
+			return _buffer->get_modifiers(_idx);
+		}
+
+		/**
+		 * \return true if the supplied modifier is set
+		 */
+		[[nodiscard]] bool is_modifier(token_modifier mod) const
+		{
+			return (get_modifiers() & (int)mod) == (int)mod;
+		}
+
+		/**
+		 * \return the current token value
+		 */
+		[[nodiscard]] string_view value() const
+		{
+			return _buffer->get_value(_idx);
+		}
+
+		/**
+		 * \return the current token value as an interned id. Only identities have a valid id
+		 */
+		[[nodiscard]] symbol_id value_id() const
+		{
+			return _buffer->get_id(_idx);
+		}
+
+		/**
+		 * \return the length of the value
+		 */
+		[[nodiscard]] int value_length() const
+		{
+			return (int)value().length();
+		}
+
+		/**
+		 * \return the offset, in bytes, in the source code we are parsing at the moment
+		 */
+		[[nodiscard]] int offset() const
+		{
+			return _buffer->get_end(_idx);
+		}
+
+		/**
+		 * \brief move to the next token
+		 * \return the new token type
+		 */
+		token_type next()
+		{
+			if (_idx < _last)
+				_idx++;
+			return type();
+		}
+
+		/**
+		 * \brief next token until we reach the supplied token
+		 */
+		token_type next_until(token_type t1);
+
+		/**
+		 * \brief next token until we reach one of the supplied tokens
+		 */
+		token_type next_until(token_type t1, token_type t2);
+
+		/**
+		 * \brief next token until we reach a token that's not the supplied token
+		 */
+		token_type next_until_not(token_type t1);
+
+		/**
+		 * \brief next token until we reach a token that's not one of the supplied tokens
+		 */
+		token_type next_until_not(token_type t1, token_type t2);
+
+		/**
+		 * \brief next token until we reach a token that's not one of the supplied tokens
+		 */
+		token_type next_until_not(token_type t1, token_type t2, token_type t3);
+
+		/**
+		 * \return the value as a 64bit integer
+		 */
+		[[nodiscard]] std::int64_t value_int64() const
+		{
+			return token::to_int64(type(), value());
+		}
+
+		/**
+		 * \return the value as a unsigned 64bit integer
+		 */
+		[[nodiscard]] std::uint64_t value_uint64() const
+		{
+			return token::to_uint64(value());
+		}
+
+		/**
+		 * \return the value as a boolean
+		 */
+		[[nodiscard]] bool value_bool() const
+		{
+			return token::to_bool(value());
+		}
+
+		/**
+		 * \return the value as a float value
+		 */
+		[[nodiscard]] float value_float32() const
+		{
+			return token::to_float32(value());
+		}
+
+		/**
+		 * \return the value as a double
+		 */
+		[[nodiscard]] double value_float64() const
+		{
+			return token::to_float64(value());
+		}
+
+	private:
+		const token_buffer* const _buffer;
+		int _idx;
+		const int _last;
+	};
+}
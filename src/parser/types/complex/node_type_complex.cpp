@@ -8,9 +8,10 @@
 
 using namespace o2;
 
-node_type_complex::node_type_complex(const source_code_view& view, string_view name)
+node_type_complex::node_type_complex(const source_code_view& view, symbol_id name)
 	: node_type(view), _name(name), _type(complex_type::unknown_), _inherits(), _fields(), _methods(), _static()
 {
+	set_kind(node_kind::type_complex);
 	add_phases_left(phase_resolve_size);
 }
 
@@ -42,34 +43,36 @@ void node_type_complex::debug(debug_ostream& stream, int indent) const
 
 node* node_type_complex::on_child_added(node* n)
 {
-	const auto fields = dynamic_cast<node_type_complex_fields*>(n);
+	const auto fields = n->as<node_type_complex_fields>();
 	if (fields != nullptr)
 		_fields = fields;
 	else
 	{
-		const auto methods = dynamic_cast<node_type_complex_methods*>(n);
+		const auto methods = n->as<node_type_complex_methods>();
 		if (methods != nullptr)
 			_methods = methods;
 		else
 		{
-			const auto i = dynamic_cast<node_type_complex_inherits*>(n);
+			const auto i = n->as<node_type_complex_inherits>();
 			if (i != nullptr)
 				_inherits = i;
 			else
 			{
-				const auto s = dynamic_cast<node_type_static_scope*>(n);
+				const auto s = n->as<node_type_static_scope>();
 				if (s != nullptr)
 					_static = s;
 			}
 		}
 	}
 
+	_symbols.add(n, get_children());
 	return node_type::on_child_added(n);
 }
 
 void node_type_complex::on_child_removed(node* n)
 {
 	node_type::on_child_removed(n);
+	_symbols.remove(n);
 	if (_fields == n)
 		_fields = nullptr;
 	else if (_methods == n)
@@ -100,13 +103,13 @@ void node_type_complex::get_all_fields(vector<node_type_complex_field*>* dest) c
 	{
 		for (const auto node: _inherits->get_children())
 		{
-			const auto inherited_from = dynamic_cast<const node_type_complex_inherit*>(node);
+			const auto inherited_from = node->as<node_type_complex_inherit>();
 			if (inherited_from == nullptr)
 				continue;
-			const auto complex = dynamic_cast<const node_type_complex*>(inherited_from->get_inherits_from());
-			if (complex == nullptr)
+			const auto inherits_from = inherited_from->get_inherits_from();
+			if (inherits_from == nullptr || !inherits_from->is<node_type_complex>())
 				continue;
-			complex->get_all_fields(dest);
+			static_cast<const node_type_complex*>(inherits_from)->get_all_fields(dest);
 		}
 	}
 
@@ -114,7 +117,7 @@ void node_type_complex::get_all_fields(vector<node_type_complex_field*>* dest) c
 	{
 		for (const auto child: _fields->get_children())
 		{
-			const auto field = dynamic_cast<node_type_complex_field*>(child);
+			const auto field = child->as<node_type_complex_field>();
 			// for now, no other children than field is allowed in the fields structure
 			assert(field != nullptr);
 			dest->add(field);
@@ -123,13 +126,13 @@ void node_type_complex::get_all_fields(vector<node_type_complex_field*>* dest) c
 }
 
 
-string node_type_complex::get_id() const
+string node_type_complex::build_id() const
 {
 	stringstream ss;
 	const auto symbol = get_parent_of_type<node_symbol>();
-	string id;
+	string_view id;
 	if (symbol)
-		id = symbol->get_id();
+		id = symbol->get_id().str();
 	ss << id;
 	if (!id.ends_with('/'))
 		ss << '/';
@@ -150,7 +153,7 @@ void node_type_complex::write_json_properties(json& j)
 
 bool node_type_complex::superficial_test_symbol_collision(const node_type_complex* rhs) const
 {
-	if (get_name() == rhs->get_name())
+	if (get_name_id() == rhs->get_name_id())
 		throw error_named_symbol_already_declared(get_source_code(), get_name(), rhs->get_source_code());
 	return false;
 }
@@ -172,7 +175,7 @@ void node_type_complex::on_process_phase(const recursion_detector* rd, resolve_s
 		const auto children = _inherits->get_children();
 		for (auto n: children)
 		{
-			const auto inherit = dynamic_cast<node_type_complex_inherit*>(n);
+			const auto inherit = n->as<node_type_complex_inherit>();
 			if (inherit == nullptr)
 				continue;
 			inherit->process_phase(&rd0, state, phase);
@@ -190,7 +193,7 @@ void node_type_complex::on_process_phase(const recursion_detector* rd, resolve_s
 	const auto fields = _fields->get_children();
 	for (auto n: fields)
 	{
-		const auto field = dynamic_cast<node_type_complex_field*>(n);
+		const auto field = n->as<node_type_complex_field>();
 		if (field == nullptr)
 			continue;
 		field->process_phase(&rd0, state, phase);
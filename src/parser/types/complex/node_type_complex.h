@@ -10,6 +10,7 @@
 #include "node_type_complex_methods.h"
 #include "node_type_complex_inherits.h"
 #include "../static/node_type_static_scope.h"
+#include "../../symbol_table.h"
 
 namespace o2
 {
@@ -54,12 +55,20 @@ namespace o2
 			: public node_type
 	{
 	public:
-		node_type_complex(const source_code_view& view, string_view name);
+		node_type_complex(const source_code_view& view, symbol_id name);
 
 		/**
 		 * \return the name of the struct
 		 */
 		[[nodiscard]] string_view get_name() const
+		{
+			return _name.str();
+		}
+
+		/**
+		 * \return the interned name of the struct
+		 */
+		[[nodiscard]] symbol_id get_name_id() const
 		{
 			return _name;
 		}
@@ -146,7 +155,7 @@ namespace o2
 		 * \param id the unique symbol id
 		 * \return
 		 */
-		[[nodiscard]] node_type* find_inherited_type(string_view id) const
+		[[nodiscard]] node_type* find_inherited_type(symbol_id id) const
 		{
 			if (_inherits == nullptr)
 				return nullptr;
@@ -183,7 +192,7 @@ namespace o2
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const final;
+		[[nodiscard]] string build_id() const final;
 
 		bool superficial_test_symbol_collision(const node_type_complex* rhs) const;
 
@@ -191,6 +200,16 @@ namespace o2
 
 #pragma region node
 
+		void get_symbol_names(vector<symbol_id>* dest) const final
+		{
+			dest->add(_name);
+		}
+
+		[[nodiscard]] const symbol_table* get_symbol_table() const final
+		{
+			return &_symbols;
+		}
+
 		void debug(debug_ostream& stream, int indent) const final;
 
 		node* on_child_added(node* n) final;
@@ -222,12 +241,13 @@ namespace o2
 		void get_all_fields(vector<node_type_complex_field*>* dest) const;
 
 	private:
-		const string_view _name;
+		const symbol_id _name;
 		complex_type _type;
 		node_type_complex_inherits* _inherits;
 		node_type_complex_fields* _fields;
 		node_type_complex_methods* _methods;
 		node_type_static_scope* _static;
+		symbol_table _symbols;
 	};
 }
 
@@ -10,6 +10,7 @@ using namespace o2;
 node_type_complex_fields::node_type_complex_fields(const source_code_view& view)
 		: node(view)
 {
+	set_kind(node_kind::type_complex_fields);
 	set_query_access_flags(query_access_modifier_passthrough);
 }
 
@@ -20,9 +21,10 @@ void node_type_complex_fields::debug(debug_ostream& stream, int indent) const
 	node::debug(stream, indent);
 }
 
-node_type_complex_field::node_type_complex_field(const source_code_view& view, string_view name)
+node_type_complex_field::node_type_complex_field(const source_code_view& view, symbol_id name)
 		: node_symbol(view), _name(name), _padding(), _size(-1), _field_type()
 {
+	set_kind(node_kind::type_complex_field);
 	add_phases_left(phase_resolve_size);
 }
 
@@ -46,7 +48,7 @@ void node_type_complex_field::resolve0(const recursion_detector* rd, resolve_sta
 
 node* node_type_complex_field::on_child_added(node* n)
 {
-	const auto type = dynamic_cast<node_type*>(n);
+	const auto type = n->as<node_type>();
 	if (type != nullptr)
 		_field_type = type;
 	return n;
@@ -58,7 +60,7 @@ void node_type_complex_field::on_child_removed(node* n)
 		_field_type = nullptr;
 }
 
-string node_type_complex_field::get_id() const
+string node_type_complex_field::build_id() const
 {
 	stringstream ss;
 	const auto symbol = get_parent_of_type<node_symbol>();
@@ -71,7 +73,7 @@ string node_type_complex_field::get_id() const
 
 bool node_type_complex_field::superficial_test_symbol_collision(const node_type_complex_field* rhs) const
 {
-	if (get_name() == rhs->get_name())
+	if (get_name_id() == rhs->get_name_id())
 		throw error_named_symbol_already_declared(get_source_code(), get_name(), rhs->get_source_code());
 	return false;
 }
@@ -31,12 +31,20 @@ namespace o2
 			: public node_symbol
 	{
 	public:
-		node_type_complex_field(const source_code_view& view, string_view name);
+		node_type_complex_field(const source_code_view& view, symbol_id name);
 
 		/**
 		 * \return the name of the field
 		 */
 		string_view get_name() const
+		{
+			return _name.str();
+		}
+
+		/**
+		 * \return the interned name of the field
+		 */
+		[[nodiscard]] symbol_id get_name_id() const
 		{
 			return _name;
 		}
@@ -57,6 +65,15 @@ namespace o2
 			return _field_type;
 		}
 
+		/**
+		 * \brief set the type this field is of. The type is replaced by the actual type when the field is resolved
+		 * \param type the type
+		 */
+		void set_field_type(node_type* type)
+		{
+			_field_type = type;
+		}
+
 		/**
 		 * \return the size, in bytes, that this field takes in memory
 		 */
@@ -65,9 +82,17 @@ namespace o2
 			return _size;
 		}
 
+		/**
+		 * \param size the size, in bytes, that this field takes in memory
+		 */
+		void set_size(int size)
+		{
+			_size = size;
+		}
+
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const final;
+		[[nodiscard]] string build_id() const final;
 
 		bool superficial_test_symbol_collision(const node_type_complex_field* rhs) const;
 
@@ -90,7 +115,7 @@ namespace o2
 #pragma endregion
 
 	private:
-		const string_view _name;
+		const symbol_id _name;
 		int _padding;
 		int _size;
 		node_type* _field_type;
@@ -23,32 +23,28 @@ void node_type_complex_inherits::resolve0(const recursion_detector* rd, resolve_
 	int num_bodies = 0;
 	for (auto n: get_children())
 	{
-		const auto inherit = dynamic_cast<node_type_complex_inherit*>(n);
+		const auto inherit = n->as<node_type_complex_inherit>();
 		if (inherit == nullptr)
 			throw unexpected_child_node(get_source_code(), "node_type_struct_inherit");
 
-		const auto inherit_struct = dynamic_cast<node_type_complex*>(inherit->get_inherits_from());
-		if (inherit_struct)
+		const auto inherits_from = inherit->get_inherits_from();
+		if (inherits_from == nullptr)
+			continue;
+		if (inherits_from->is<node_type_complex>() || inherits_from->is<node_type_primitive>())
 			num_bodies++;
-		else
-		{
-			const auto inherit_primitive = dynamic_cast<node_type_primitive*>(inherit->get_inherits_from());
-			if (inherit_primitive)
-				num_bodies++;
-		}
 		if (num_bodies > 1)
 			throw resolve_error_multiple_inherited_bodies(get_source_code());
 	}
 }
 
-node_type* node_type_complex_inherits::find_inherited_type(string_view id) const
+node_type* node_type_complex_inherits::find_inherited_type(symbol_id id) const
 {
 	assert (!has_phase_left(phase_resolve) &&
 			"you are not allowed to call this function until after the resolve phase is done for this object");
 
 	for (const auto n: get_children())
 	{
-		const auto inherit = dynamic_cast<node_type_complex_inherit*>(n);
+		const auto inherit = n->as<node_type_complex_inherit>();
 		if (inherit == nullptr)
 			throw unexpected_child_node(get_source_code(), "node_type_struct_inherit");
 
@@ -66,7 +62,7 @@ bool node_type_complex_inherits::inherits_from_type(node_type* type) const
 
 	for (const auto n: get_children())
 	{
-		const auto inherit = dynamic_cast<node_type_complex_inherit*>(n);
+		const auto inherit = n->as<node_type_complex_inherit>();
 		if (inherit == nullptr)
 			throw unexpected_child_node(get_source_code(), "node_type_struct_inherit");
 
@@ -113,7 +109,7 @@ void node_type_complex_inherit::on_process_phase(const recursion_detector* rd, r
 
 node* node_type_complex_inherit::on_child_added(node* n)
 {
-	const auto type = dynamic_cast<node_type*>(n);
+	const auto type = n->as<node_type>();
 	if (type != nullptr)
 		_inherits_from = type;
 	return n;
@@ -125,13 +121,13 @@ void node_type_complex_inherit::on_child_removed(node* n)
 		_inherits_from = nullptr;
 }
 
-node_type* node_type_complex_inherit::find_inherited_type(string_view id) const
+node_type* node_type_complex_inherit::find_inherited_type(symbol_id id) const
 {
 	assert(_inherits_from != nullptr && "this node's resolve0 method should've been called before this");
 	if (_inherits_from->get_id() == id)
 		return _inherits_from;
 
-	auto s = dynamic_cast<node_type_complex*>(_inherits_from);
+	auto s = _inherits_from->as<node_type_complex>();
 	if (s != nullptr)
 	{
 		const auto inherits = s->get_inherits();
@@ -151,7 +147,7 @@ bool node_type_complex_inherit::inherits_from_type(node_type* type) const
 	if (_inherits_from == type)
 		return true;
 
-	auto s = dynamic_cast<node_type_complex*>(_inherits_from);
+	auto s = _inherits_from->as<node_type_complex>();
 	if (s != nullptr)
 	{
 		const auto inherits = s->get_inherits();
@@ -22,6 +22,7 @@ namespace o2
 		explicit node_type_complex_inherits(const source_code_view& view)
 				: node(view)
 		{
+			set_kind(node_kind::type_complex_inherits);
 			set_query_access_flags(query_access_modifier_passthrough);
 		}
 
@@ -32,7 +33,7 @@ namespace o2
 		 * \param s
 		 * \return
 		 */
-		[[nodiscard]] node_type* find_inherited_type(string_view id) const;
+		[[nodiscard]] node_type* find_inherited_type(symbol_id id) const;
 
 		/**
 		 * \brief check to see if we are inheriting from the supplied type
@@ -65,6 +66,7 @@ namespace o2
 		explicit node_type_complex_inherit(const source_code_view& view)
 				: node(view), _inherits_from()
 		{
+			set_kind(node_kind::type_complex_inherit);
 			set_query_access_flags(query_access_modifier_passthrough);
 			add_phases_left(phase_resolve_size);
 		}
@@ -85,6 +87,15 @@ namespace o2
 			return _inherits_from;
 		}
 
+		/**
+		 * \brief set the type this struct inherits from
+		 * \param type the type
+		 */
+		void set_inherits_from(node_type* type)
+		{
+			_inherits_from = type;
+		}
+
 		/**
 		 * \brief search for a type that matches the supplied symbols
 		 * \tparam str
@@ -92,7 +103,7 @@ namespace o2
 		 * \param s
 		 * \return
 		 */
-		[[nodiscard]] node_type* find_inherited_type(string_view id) const;
+		[[nodiscard]] node_type* find_inherited_type(symbol_id id) const;
 
 		/**
 		 * \brief check to see if we are inheriting from the supplied type
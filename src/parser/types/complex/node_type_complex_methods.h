@@ -16,6 +16,7 @@ namespace o2
 		explicit node_type_complex_methods(const source_code_view& view)
 				: node(view)
 		{
+			set_kind(node_kind::type_complex_methods);
 			set_query_access_flags(query_access_modifier_passthrough);
 		}
 
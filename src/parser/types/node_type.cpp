@@ -15,4 +15,5 @@ node_type::node_type(const source_code_view& view)
 node_type::node_type(const source_code_view& view, int size)
 		: node_symbol(view), _size(size)
 {
+	set_kind(node_kind::type);
 }
@@ -69,6 +69,15 @@ namespace o2
 			return _size >= 0;
 		}
 
+		/**
+		 * \brief set the size of this type, which is used when a type that's resolved already is read back
+		 * \param size the size
+		 */
+		void set_size(int size)
+		{
+			_size = size;
+		}
+
 		/**
 		 * \param rhs
 		 * \return information on if the supplied type is compatible with this type. I
@@ -17,6 +17,7 @@ node_type_array::node_type_array(const source_code_view& view)
 node_type_array::node_type_array(const source_code_view& view, int count)
 		: node_type(view), _count(count), _array_type(this), _operation()
 {
+	set_kind(node_kind::type_array);
 	add_phases_left(phase_resolve_size);
 }
 
@@ -46,7 +47,7 @@ void node_type_array::resolve0(const recursion_detector* rd, resolve_state* stat
 	// The operation can be a lot of things
 	// TODO: Maybe force the use of a "node_op_expression" which evaluates into a value.
 	//       Force the use of node_op_constant for now
-	const auto opc = dynamic_cast<node_op_constant*>(_operation);
+	const auto opc = _operation->as<node_op_constant>();
 	if (opc == nullptr)
 		throw expected_child_node(get_source_code(), "node_op_constant");
 
@@ -58,7 +59,7 @@ void node_type_array::resolve0(const recursion_detector* rd, resolve_state* stat
 		throw resolve_error_positive_int_constant_expected(get_source_code());
 }
 
-string node_type_array::get_id() const
+string node_type_array::build_id() const
 {
 	assert(_count != -1);
 
@@ -70,12 +71,12 @@ string node_type_array::get_id() const
 
 node* node_type_array::on_child_added(node* n)
 {
-	auto type = dynamic_cast<node_type*>(n);
+	auto type = n->as<node_type>();
 	if (type != nullptr)
 		_array_type = type;
 	else
 	{
-		const auto op = dynamic_cast<node_op*>(n);
+		const auto op = n->as<node_op>();
 		if (op)
 			_operation = op;
 	}
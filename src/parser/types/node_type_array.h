@@ -41,7 +41,7 @@ namespace o2
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const final;
+		[[nodiscard]] string build_id() const final;
 
 #pragma endregion
 
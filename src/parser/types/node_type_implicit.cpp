@@ -12,6 +12,7 @@ using namespace o2;
 node_type_implicit::node_type_implicit(const source_code_view& view)
 		: node_type(view), _type()
 {
+	set_kind(node_kind::type_implicit);
 	add_phases_left(phase_resolve_size);
 }
 
@@ -34,7 +35,7 @@ void node_type_implicit::resolve0(const recursion_detector* rd, resolve_state* s
 		throw expected_child_node(get_source_code(), "node_link");
 	if (link->is_broken())
 		throw expected_child_node(get_source_code(), "node_link->node_op");
-	const auto op = dynamic_cast<node_op*>(link->get_node());
+	const auto op = link->get_node()->as<node_op>();
 	if (op == nullptr)
 		throw unexpected_child_node(get_source_code(), "node_link->node_op");
 
@@ -51,7 +52,7 @@ void node_type_implicit::resolve0(const recursion_detector* rd, resolve_state* s
 	node::resolve0(rd, state);
 }
 
-string node_type_implicit::get_id() const
+string node_type_implicit::build_id() const
 {
 	if (_type == this)
 		return {};
@@ -32,9 +32,18 @@ namespace o2
 	public:
 		explicit node_type_implicit(const source_code_view& view);
 
+		/**
+		 * \brief set the type the expression is resolved into
+		 * \param type the type
+		 */
+		void set_type(node_type* type)
+		{
+			_type = type;
+		}
+
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const final;
+		[[nodiscard]] string build_id() const final;
 
 #pragma endregion
 
@@ -10,6 +10,7 @@ using namespace o2;
 node_type_known_ref::node_type_known_ref(const source_code_view& view, node_type_primitive* const primitive)
 		: node_type(view, primitive->get_size()), _type(primitive)
 {
+	set_kind(node_kind::type_known_ref);
 }
 
 void node_type_known_ref::debug(debug_ostream& stream, int indent) const
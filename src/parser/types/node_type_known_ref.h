@@ -37,9 +37,9 @@ namespace o2
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const final
+		[[nodiscard]] string build_id() const final
 		{
-			return _type->get_id();
+			return string(_type->get_id().str());
 		}
 
 #pragma endregion
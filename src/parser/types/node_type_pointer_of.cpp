@@ -8,7 +8,7 @@
 
 using namespace o2;
 
-string node_type_pointer_of::get_id() const
+string node_type_pointer_of::build_id() const
 {
 	stringstream ss;
 	ss << "(*" << _pointer_of->get_id() << ")";
@@ -29,7 +29,7 @@ compatibility node_type_pointer_of::is_compatible_with(node_type* rhs) const
 
 	const auto pointer_of = _pointer_of->get_type();
 
-	const auto array = dynamic_cast<node_type_array*>(rhs);
+	const auto array = rhs->as<node_type_array>();
 	if (array)
 	{
 		// if the supplied type is an array type then the compiler can automatically cast the
@@ -44,7 +44,7 @@ compatibility node_type_pointer_of::is_compatible_with(node_type* rhs) const
 
 	}
 
-	const auto rhs_pointer_of = dynamic_cast<node_type_pointer_of*>(rhs);
+	const auto rhs_pointer_of = rhs->as<node_type_pointer_of>();
 	if (rhs_pointer_of)
 	{
 		const auto rhs_ptr = rhs_pointer_of->get_pointer_of_type()->get_type();
@@ -61,7 +61,7 @@ compatibility node_type_pointer_of::is_compatible_with(node_type* rhs) const
 
 node* node_type_pointer_of::on_child_added(node* n)
 {
-	const auto pointer_of = dynamic_cast<node_type*>(n);
+	const auto pointer_of = n->as<node_type>();
 	if (pointer_of)
 		_pointer_of = pointer_of;
 	return n;
@@ -78,9 +78,13 @@ namespace
 
 node_type_primitive::node_type_primitive(const vector<string_view>& names, int size,
 		primitive_type pttype,
-		llvm::Type* type)
-		: node_type(source_code_view(), size), _names(names), _primitive_type(pttype), _llvm_type(type)
+		llvm::Type* type, int index)
+		: node_type(source_code_view(), size), _primitive_type(pttype), _llvm_type(type), _index(index)
 {
+	set_kind(node_kind::type_primitive);
+	_names.reserve(names.size());
+	for (auto name: names)
+		_names.add(symbol_id::intern(name));
 }
 
 void node_type_primitive::debug(debug_ostream& stream, int indent) const
@@ -104,7 +108,7 @@ void node_type_primitive::write_json_properties(json& j)
 	j.write(json::pair<int>{ "size", _size });
 }
 
-string node_type_primitive::get_id() const
+string node_type_primitive::build_id() const
 {
 	return string(get_name());
 }
@@ -116,7 +120,7 @@ compatibility node_type_primitive::is_compatible_with(node_type* rhs) const
 
 	// check compatibility between primitives. the first part in the array are the type we want to
 	// set from and the second is the destination type
-	const auto rhs_primitive = dynamic_cast<node_type_primitive*>(rhs);
+	const auto rhs_primitive = rhs->as<node_type_primitive>();
 	if (rhs_primitive)
 		return upcast[(int)rhs_primitive->_primitive_type][(int)_primitive_type];
 	return compatibility::incompatible;
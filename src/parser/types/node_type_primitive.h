@@ -17,24 +17,45 @@ namespace o2
 	public:
 		node_type_primitive(const vector<string_view>& names, int size,
 				primitive_type pttype,
-				llvm::Type* type);
+				llvm::Type* type, int index);
+
+		/**
+		 * \return the index of this primitive amongst the predefined primitives in the syntax tree
+		 */
+		[[nodiscard]] int get_index() const
+		{
+			return _index;
+		}
 
 		/**
 		 * \return the name of the primitive
 		 */
 		[[nodiscard]] string_view get_name() const
 		{
-			return _names[0];
+			return _names[0].str();
 		}
 
 		/**
 		 * \return all names that matches this primitive
 		 */
-		[[nodiscard]] array_view<string_view> get_names() const
+		[[nodiscard]] array_view<symbol_id> get_names() const
 		{
 			return _names;
 		}
 
+		/**
+		 * \return true if the supplied name is one of the names of this primitive
+		 */
+		[[nodiscard]] bool has_name(symbol_id name) const
+		{
+			for (auto n: _names)
+			{
+				if (n == name)
+					return true;
+			}
+			return false;
+		}
+
 #pragma region node_type
 
 		compatibility is_compatible_with(node_type* rhs) const final;
@@ -43,12 +64,17 @@ namespace o2
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const final;
+		[[nodiscard]] string build_id() const final;
 
 #pragma endregion
 
 #pragma region node
 
+		void get_symbol_names(vector<symbol_id>* dest) const final
+		{
+			dest->add(_names);
+		}
+
 		void debug(debug_ostream& stream, int indent) const final;
 
 		void write_json_properties(json& j) final;
@@ -65,9 +91,10 @@ namespace o2
 #pragma endregion
 
 	private:
-		vector<string_view> _names;
+		vector<symbol_id> _names;
 		const primitive_type _primitive_type;
 		llvm::Type* const _llvm_type;
+		const int _index;
 	};
 
 }
\ No newline at end of file
@@ -11,6 +11,7 @@ using namespace o2;
 node_type_ref::node_type_ref(const source_code_view& view)
 		: node_type(view), _type()
 {
+	set_kind(node_kind::type_ref);
 	add_phases_left(phase_resolve_size);
 }
 
@@ -31,24 +32,25 @@ void node_type_ref::resolve0(const recursion_detector* rd, resolve_state* state)
 	node::resolve0(rd, state);
 
 	// assume that the first child is a reference
-	const auto ref = dynamic_cast<node_ref*>(get_child(0));
-	if (ref == nullptr)
+	const auto first = get_child(0);
+	if (first == nullptr || !first->is<node_ref>())
 		throw expected_child_node(get_source_code(), "node_ref");
+	const auto ref = static_cast<node_ref*>(first);
 
 	// collect the results and fetch the best matched one!
 	// TODO: add support for fetching the best match instead of just the first
 	const auto results = ref->get_result();
 	if (results.size() > 1)
 		throw resolve_error_multiple_refs(get_source_code());
-	_type = dynamic_cast<node_type*>(results[0]);
+	_type = results[0]->as<node_type>();
 	if (_type == nullptr)
 		throw resolve_error_unresolved_reference(get_source_code());
 }
 
-string node_type_ref::get_id() const
+string node_type_ref::build_id() const
 {
 	if (_type)
-		return _type->get_id();
+		return string(_type->get_id().str());
 	return {};
 }
 
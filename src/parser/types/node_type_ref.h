@@ -20,6 +20,15 @@ namespace o2
 	public:
 		explicit node_type_ref(const source_code_view& view);
 
+		/**
+		 * \brief set the type this reference is resolved into
+		 * \param type the type
+		 */
+		void set_type(node_type* type)
+		{
+			_type = type;
+		}
+
 #pragma region node_type
 
 		node_type* get_type() final
@@ -33,7 +42,7 @@ namespace o2
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const final;
+		[[nodiscard]] string build_id() const final;
 
 #pragma endregion
 
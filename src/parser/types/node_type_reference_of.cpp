@@ -8,7 +8,7 @@
 
 using namespace o2;
 
-string node_type_reference_of::get_id() const
+string node_type_reference_of::build_id() const
 {
 	stringstream ss;
 	ss << "(*" << _reference_of->get_id() << ")";
@@ -31,7 +31,7 @@ compatibility node_type_reference_of::is_compatible_with(node_type* rhs) const
 
 node* node_type_reference_of::on_child_added(node* n)
 {
-	const auto pointer_of = dynamic_cast<node_type*>(n);
+	const auto pointer_of = n->as<node_type>();
 	if (pointer_of)
 		_reference_of = pointer_of;
 	return n;
@@ -19,6 +19,7 @@ namespace o2
 		explicit node_type_reference_of(const source_code_view& view)
 				: node_type(view, sizeof(void*)), _reference_of()
 		{
+			set_kind(node_kind::type_reference_of);
 		}
 
 		/**
@@ -37,7 +38,7 @@ namespace o2
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const override;
+		[[nodiscard]] string build_id() const override;
 
 #pragma endregion
 
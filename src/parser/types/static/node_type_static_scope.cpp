@@ -17,12 +17,12 @@ void node_type_static_scope::debug(debug_ostream& stream, int indent) const
 
 node* node_type_static_scope::on_child_added(node* n)
 {
-	const auto vars = dynamic_cast<node_type_static_scope_vars*>(n);
+	const auto vars = n->as<node_type_static_scope_vars>();
 	if (vars != nullptr)
 		_vars = vars;
 	else
 	{
-		const auto funcs = dynamic_cast<node_type_static_scope_funcs*>(n);
+		const auto funcs = n->as<node_type_static_scope_funcs>();
 		if (funcs != nullptr)
 			_funcs = funcs;
 	}
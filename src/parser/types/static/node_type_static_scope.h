@@ -22,6 +22,7 @@ namespace o2
 		explicit node_type_static_scope(const source_code_view& view)
 				: node(view), _vars(), _funcs()
 		{
+			set_kind(node_kind::type_static_scope);
 			set_query_access_flags(query_access_modifier_passthrough);
 		}
 
@@ -19,6 +19,7 @@ namespace o2
 		explicit node_type_static_scope_vars(const source_code_view& view)
 				: node(view)
 		{
+			set_kind(node_kind::type_static_scope_vars);
 			set_query_access_flags(query_access_modifier_passthrough);
 		}
 
@@ -8,10 +8,10 @@
 
 using namespace o2;
 
-node_var::node_var(const source_code_view& view, string_view name, int modifiers)
+node_var::node_var(const source_code_view& view, symbol_id name, int modifiers)
 		: node_symbol(view), _name(name), _modifiers(modifiers), _type()
 {
-
+	set_kind(node_kind::var);
 }
 
 void node_var::debug(debug_ostream& stream, int indent) const
@@ -28,7 +28,7 @@ void node_var::debug(debug_ostream& stream, int indent) const
 
 node* node_var::on_child_added(node* n)
 {
-	const auto nt = dynamic_cast<node_type*>(n);
+	const auto nt = n->as<node_type>();
 	if (nt)
 		_type = nt;
 	return node_symbol::on_child_added(n);
@@ -50,16 +50,16 @@ void node_var::on_parent_node(node* p)
 void node_var::write_json_properties(json& j)
 {
 	node_symbol::write_json_properties(j);
-	j.write(json::pair<string_view>{ "name", _name });
+	j.write(json::pair<string_view>{ "name", _name.str() });
 }
 
-string node_var::get_id() const
+string node_var::build_id() const
 {
 	stringstream ss;
 	const auto symbol = get_parent_of_type<node_symbol>();
-	string id;
+	string_view id;
 	if (symbol)
-		id = symbol->get_id();
+		id = symbol->get_id().str();
 	ss << id;
 	if (!id.ends_with('/'))
 		ss << '/';
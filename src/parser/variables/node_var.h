@@ -23,12 +23,20 @@ namespace o2
 			modifier_readonly = 1 << 1
 		};
 
-		node_var(const source_code_view& view, string_view name, int modifiers);
+		node_var(const source_code_view& view, symbol_id name, int modifiers);
 
 		/**
 		 * \return the name of the variable
 		 */
 		string_view get_name() const
+		{
+			return _name.str();
+		}
+
+		/**
+		 * \return the interned name of the variable
+		 */
+		[[nodiscard]] symbol_id get_name_id() const
 		{
 			return _name;
 		}
@@ -59,12 +67,17 @@ namespace o2
 
 #pragma region node_symbol
 
-		[[nodiscard]] string get_id() const final;
+		[[nodiscard]] string build_id() const final;
 
 #pragma endregion
 
 #pragma region node
 
+		void get_symbol_names(vector<symbol_id>* dest) const final
+		{
+			dest->add(_name);
+		}
+
 		void debug(debug_ostream& stream, int indent) const override;
 
 		void write_json_properties(json& j) override;
@@ -87,7 +100,7 @@ namespace o2
 #pragma endregion
 
 	protected:
-		const string_view _name;
+		const symbol_id _name;
 		const int _modifiers;
 		node_type* _type;
 	};
@@ -18,9 +18,10 @@ namespace o2
 			: public node_var
 	{
 	public:
-		node_var_const(const source_code_view& view, string_view name)
+		node_var_const(const source_code_view& view, symbol_id name)
 				: node_var(view, name, node_var::modifier_const)
 		{
+			set_kind(node_kind::var_const);
 		}
 
 #pragma region node
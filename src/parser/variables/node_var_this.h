@@ -16,9 +16,10 @@ namespace o2
 			: public node_var
 	{
 	public:
-		node_var_this(const source_code_view& view, string_view name, node_type* type)
+		node_var_this(const source_code_view& view, symbol_id name, node_type* type)
 				: node_var(view, name, modifier_readonly)
 		{
+			set_kind(node_kind::var_this);
 			_type = type;
 		}
 
@@ -48,6 +48,11 @@ void errors_parse()
 			const auto e2 = assert_type<error_syntax_error>(&e);
 			assert_equals(string_view(STR("expected '}' but was <EOF>")), e2->get_error());
 		});
+		test_error("constant_out_of_range", ROOT_PATH, [](const std::exception& e)
+		{
+			const auto e2 = assert_type<error_constant_out_of_range>(&e);
+			assert_equals(string_view(STR("constant '99999999999999999999' is out of range")), e2->get_error());
+		});
 	});
 
 }
\ No newline at end of file
@@ -280,6 +280,78 @@ void funcs()
 			assert_equals(func_f_ret_const->get_value().type, primitive_type::int32);
 			assert_equals(func_f_ret_const->get_value().i32, 10 + 20 * 30);
 		});
+		test("return_folded_expression", ROOT_PATH, [](syntax_tree& st)
+		{
+			const auto root = st.get_root_package();
+			assert_equals(root->get_children().size(), 14);
+
+			const auto project_module = assert_type<node_module>(root->get_child(13));
+			assert_equals(project_module->get_name(), "westcoastcode.se/tests");
+			const auto package_main = assert_type<node_package>(project_module->get_child(0));
+
+			const auto func_f = assert_type<node_func>(package_main->get_child(0));
+			assert_equals(func_f->get_name(), "f");
+			const auto body_f = assert_type<node_func_body>(func_f->get_child(2));
+			const auto scope_f = assert_type<node_scope>(body_f->get_child(0));
+			const auto func_f_ret = assert_type<node_op_return>(scope_f->get_child(0));
+			const auto func_f_ret_const = assert_type<node_op_constant>(func_f_ret->get_child(0));
+			assert_equals(func_f_ret_const->get_value().type, primitive_type::int32);
+			assert_equals(func_f_ret_const->get_value().i32, -(10 + 20) * ~3 + 5);
+		});
+		test("return_folded_compare", ROOT_PATH, [](syntax_tree& st)
+		{
+			const auto root = st.get_root_package();
+			assert_equals(root->get_children().size(), 14);
+
+			const auto project_module = assert_type<node_module>(root->get_child(13));
+			assert_equals(project_module->get_name(), "westcoastcode.se/tests");
+			const auto package_main = assert_type<node_package>(project_module->get_child(0));
+
+			const auto func_f = assert_type<node_func>(package_main->get_child(0));
+			assert_equals(func_f->get_name(), "f");
+			const auto body_f = assert_type<node_func_body>(func_f->get_child(2));
+			const auto scope_f = assert_type<node_scope>(body_f->get_child(0));
+			const auto func_f_ret = assert_type<node_op_return>(scope_f->get_child(0));
+			const auto func_f_ret_const = assert_type<node_op_constant>(func_f_ret->get_child(0));
+			assert_equals(func_f_ret_const->get_value().type, primitive_type::bool_);
+			assert_equals(func_f_ret_const->get_value().bool_, 0);
+		});
+		test("return_folded_bitwise", ROOT_PATH, [](syntax_tree& st)
+		{
+			const auto root = st.get_root_package();
+			assert_equals(root->get_children().size(), 14);
+
+			const auto project_module = assert_type<node_module>(root->get_child(13));
+			assert_equals(project_module->get_name(), "westcoastcode.se/tests");
+			const auto package_main = assert_type<node_package>(project_module->get_child(0));
+
+			const auto func_f = assert_type<node_func>(package_main->get_child(0));
+			assert_equals(func_f->get_name(), "f");
+			const auto body_f = assert_type<node_func_body>(func_f->get_child(2));
+			const auto scope_f = assert_type<node_scope>(body_f->get_child(0));
+			const auto func_f_ret = assert_type<node_op_return>(scope_f->get_child(0));
+			const auto func_f_ret_const = assert_type<node_op_constant>(func_f_ret->get_child(0));
+			assert_equals(func_f_ret_const->get_value().type, primitive_type::int32);
+			assert_equals(func_f_ret_const->get_value().i32, (1 << 4) | ((3 & 6) ^ (1 >> 1)));
+		});
+		test("return_folded_logical", ROOT_PATH, [](syntax_tree& st)
+		{
+			const auto root = st.get_root_package();
+			assert_equals(root->get_children().size(), 14);
+
+			const auto project_module = assert_type<node_module>(root->get_child(13));
+			assert_equals(project_module->get_name(), "westcoastcode.se/tests");
+			const auto package_main = assert_type<node_package>(project_module->get_child(0));
+
+			const auto func_f = assert_type<node_func>(package_main->get_child(0));
+			assert_equals(func_f->get_name(), "f");
+			const auto body_f = assert_type<node_func_body>(func_f->get_child(2));
+			const auto scope_f = assert_type<node_scope>(body_f->get_child(0));
+			const auto func_f_ret = assert_type<node_op_return>(scope_f->get_child(0));
+			const auto func_f_ret_const = assert_type<node_op_constant>(func_f_ret->get_child(0));
+			assert_equals(func_f_ret_const->get_value().type, primitive_type::bool_);
+			assert_equals(func_f_ret_const->get_value().bool_, 1);
+		});
 		test("extern_args_0_return_void", ROOT_PATH, [](syntax_tree& st)
 		{
 			const auto root = st.get_root_package();
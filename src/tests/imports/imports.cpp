@@ -32,6 +32,24 @@ void imports()
 			const auto package_models = assert_type<node_package>(project_module->get_children()[1]);
 			assert_equals(package_models->get_name(), "/models");
 		});
+		test("deferred_func_body", ROOT_PATH, [](syntax_tree& st)
+		{
+			const auto root = st.get_root_package();
+			const auto project_module = assert_type<node_module>(root->get_children()[13]);
+
+			// the body of an imported function is skipped when parsing the package and parsed afterwards
+			const auto package_models = assert_type<node_package>(project_module->get_children()[1]);
+			assert_equals(package_models->get_name(), "/models");
+			const auto get = assert_type<node_func>(package_models->get_child(0));
+			assert_equals(get->get_name(), "Get");
+			const auto body = assert_not_null(get->get_body());
+			assert_false(body->is_deferred());
+			assert_equals(body->get_children().size(), 1);
+			const auto scope = assert_type<node_scope>(body->get_child(0));
+			assert_equals(scope->get_children().size(), 2);
+			assert_type<node_func>(scope->get_child(0));
+			assert_type<node_op_return>(scope->get_child(1));
+		});
 		test("two_local", ROOT_PATH, "apps", [](syntax_tree& st)
 		{
 			const auto root = st.get_root_package();
@@ -51,5 +69,50 @@ void imports()
 			const auto package_services = assert_type<node_package>(project_module->get_children()[2]);
 			assert_equals(package_services->get_name(), "/services");
 		});
+		test("cycle", ROOT_PATH, [](syntax_tree& st)
+		{
+			const auto root = st.get_root_package();
+			const auto project_module = assert_type<node_module>(root->get_children()[13]);
+			assert_equals(project_module->get_children().size(), 5);
+
+			o2::vector<node_package*> packages;
+			for (auto c: project_module->get_children())
+				packages.add(assert_type<node_package>(c));
+
+			// "/a" and "/b" import each other, so they are put in the same unit
+			const package_graph graph(packages);
+			const auto& units = graph.get_units();
+			assert_equals((int)units.size(), 4);
+			const auto unit_of = [&units](string_view name)
+			{
+				for (int i = 0; i < (int)units.size(); ++i)
+				{
+					for (auto p: units[i].packages)
+					{
+						if (p->get_name() == name)
+							return i;
+					}
+				}
+				return -1;
+			};
+			const auto unit_main = unit_of("");
+			const auto unit_a = unit_of("/a");
+			const auto unit_c = unit_of("/c");
+			const auto unit_d = unit_of("/d");
+			assert_true(unit_main != -1 && unit_a != -1 && unit_c != -1 && unit_d != -1);
+			assert_equals(unit_of("/b"), unit_a);
+			assert_equals(units[unit_a].packages.size(), 2);
+			assert_equals(units[unit_a].dependencies, 1);
+			assert_equals(units[unit_c].dependencies, 0);
+			assert_equals(units[unit_d].dependencies, 0);
+			assert_equals(units[unit_main].dependencies, 3);
+
+			// a unit always comes after the units it depends on
+			for (int i = 0; i < (int)units.size(); ++i)
+			{
+				for (auto d: units[i].dependents)
+					assert_true(d > i);
+			}
+		});
 	});
 }
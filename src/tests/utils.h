@@ -7,7 +7,11 @@
 
 #include "../parser/parser.h"
 #include "../parser/module/module_package_lookup.h"
+#include "../parser/package/package_graph.h"
+#include "../parser/package/package_interface.h"
 #include "test.h"
+#include <thread>
+#include <unordered_map>
 
 using namespace o2;
 using namespace o2::testing;
@@ -21,7 +25,79 @@ namespace o2
 		std::cout << std::endl;
 	}
 
-	static void import_package_sources_this(module* const mod, syntax_tree* const st, vector<node_import*> imports)
+	/**
+	 * \brief parse an imported package and read it back from its package interface. This makes sure that all
+	 *        tests also verify that packages loaded from the cache are the same as the parsed packages
+	 */
+	static node_package* parse_imported_package_this(syntax_tree* const st, package_source_info* sources,
+			parser_state* state)
+	{
+		parser_state ps0(st);
+		ps0.set_declarations_only(true);
+		const auto parsed = parse_package_sources(sources->sources, sources->name, &ps0);
+		if (parsed == nullptr)
+			return nullptr;
+
+		std::string bytes;
+		const auto written = write_package_interface(parsed, sources->sources, &bytes);
+		delete parsed;
+		if (!written)
+			fail("could not write the package interface");
+
+		vector<package_interface_link> links;
+		const auto package = read_package_interface(bytes, sources->sources, sources->name, state, &links);
+		if (package == nullptr)
+			fail("could not read the package interface");
+		if (!links.empty())
+			fail("expected a parsed package to have no references to other packages");
+		return package;
+	}
+
+	/**
+	 * \brief write the resolved and optimized packages into package interfaces, read them back and link them to
+	 *        the other packages. This makes sure that all tests also verify that packages loaded from the cache
+	 *        are resolved in the same way as the built packages
+	 */
+	static void verify_package_interfaces_this(syntax_tree* const st,
+			const std::unordered_map<node_package*, package_source_info*>& infos)
+	{
+		std::unordered_map<symbol_id, node_package*> ids;
+		for (const auto& it: infos)
+			ids[it.first->get_id()] = it.first;
+		const auto find_package = [&ids](symbol_id id) -> node_package*
+		{
+			const auto it = ids.find(id);
+			return it != ids.end() ? it->second : nullptr;
+		};
+
+		for (const auto& it: infos)
+		{
+			std::string bytes;
+			if (!write_package_interface(it.first, it.second->sources, &bytes))
+				fail("could not write the resolved package interface");
+
+			parser_state state(st);
+			vector<package_interface_link> links;
+			const auto package = read_package_interface(bytes, it.second->sources, it.second->name, &state, &links);
+			if (package == nullptr)
+				fail("could not read the resolved package interface");
+			const auto linked = link_package_interface(links, find_package);
+
+			// the package read back must be written into the same bytes
+			std::string read_bytes;
+			const auto written = linked && write_package_interface(package, it.second->sources, &read_bytes);
+			delete package;
+			if (!linked)
+				fail("could not link the resolved package interface");
+			if (!written)
+				fail("could not write the read package interface");
+			if (bytes != read_bytes)
+				fail("expected the read package interface to be the same as the written package interface");
+		}
+	}
+
+	static void import_package_sources_this(module* const mod, syntax_tree* const st, vector<node_import*> imports,
+			vector<node_package*>* packages, std::unordered_map<node_package*, package_source_info*>* infos)
 	{
 		int imports_count = imports.size();
 		for (auto i: imports)
@@ -35,13 +111,16 @@ namespace o2
 					imported_module->load_package_sources(sources);
 					sources->load_status = package_source_info::loading;
 					parser_state ps0(st);
-					const auto imported_package = parse_package_sources(sources->sources, sources->name, &ps0);
+					const auto imported_package = parse_imported_package_this(st, sources, &ps0);
 					if (imported_package)
+					{
 						imported_module->add_package(imported_package);
+						packages->add(imported_package);
+						(*infos)[imported_package] = sources;
+					}
 					sources->load_status = package_source_info::successful;
 					imported_module->notify_package_imported(imported_package);
-					import_package_sources_this(imported_module, st, std::move(ps0.get_imports()));
-					imported_package->process_phases();
+					import_package_sources_this(imported_module, st, std::move(ps0.get_imports()), packages, infos);
 				}
 				else if (sources->load_status == package_source_info::successful)
 				{
@@ -52,13 +131,86 @@ namespace o2
 		}
 	}
 
-	static void parse_package_sources_this(module* main_module, syntax_tree* const st, string_view package_name)
+	static void resolve_packages_this(syntax_tree* const st, vector<node_package*> packages)
 	{
+		// resolve the packages in the same way as the build command does. Units that don't depend on each other
+		// are resolved in parallel, which verifies that the state shared between the packages is thread-safe
+		const package_graph graph(packages);
+		const auto& units = graph.get_units();
+		std::vector<int> dependencies(units.size());
+		std::vector<std::exception_ptr> errors(units.size());
+		std::vector<int> ready;
+		for (int i = 0; i < (int)units.size(); ++i)
+		{
+			dependencies[i] = units[i].dependencies;
+			if (dependencies[i] == 0)
+				ready.push_back(i);
+		}
+
+		while (!ready.empty())
+		{
+			{
+				std::vector<std::jthread> threads;
+				for (auto idx: ready)
+				{
+					threads.emplace_back([unit = &units[idx], error = &errors[idx]]()
+					{
+						try
+						{
+							for (auto p: unit->packages)
+								p->process_package_phases();
+						}
+						catch (...)
+						{
+							*error = std::current_exception();
+						}
+					});
+				}
+			}
+
+			// the units that depend on a unit that failed are never resolved
+			std::vector<int> next;
+			for (auto idx: ready)
+			{
+				if (errors[idx])
+					continue;
+				for (auto d: units[idx].dependents)
+				{
+					if (--dependencies[d] == 0)
+						next.push_back(d);
+				}
+			}
+			ready = std::move(next);
+		}
+
+		// the units are sorted, so the first error is the same error as if the units were resolved one after another
+		for (const auto& e: errors)
+		{
+			if (e)
+				std::rethrow_exception(e);
+		}
+
+		// the function bodies are skipped when parsing imported packages
+		parser_state state(st);
+		for (auto p: packages)
+		{
+			if (parse_deferred_func_bodies(p, &state) > 0)
+				p->process_package_phases();
+		}
+	}
+
+	static std::unordered_map<node_package*, package_source_info*> parse_package_sources_this(module* main_module,
+			syntax_tree* const st, string_view package_name)
+	{
+		std::unordered_map<node_package*, package_source_info*> infos;
 		parser_state ps(st);
 		auto package = parse_main_module_package(main_module, package_name, &ps);
 		if (package == nullptr)
-			return;
+			return infos;
 
+		vector<node_package*> packages;
+		packages.add(package);
+		infos[package] = main_module->get_package_info(package_name);
 		auto imports = ps.get_imports();
 		if (imports.empty())
 		{
@@ -66,10 +218,11 @@ namespace o2
 			main_module->notify_package_imported(package);
 		}
 		else
-			import_package_sources_this(main_module, st, std::move(imports));
+			import_package_sources_this(main_module, st, std::move(imports), &packages, &infos);
 
-		// all imports are imported, so let's resolve this package's dependencies!
-		package->process_phases();
+		// all imports are imported, so let's resolve all packages
+		resolve_packages_this(st, std::move(packages));
+		return infos;
 	}
 
 	static void test(string_view name, string_view root_path, string_view app_path, std::function<void(syntax_tree&)> t)
@@ -104,8 +257,9 @@ namespace o2
 				m = o2_new module(sm, module_name, path);
 				m->insert_into(st);
 
-				parse_package_sources_this(m, st, app);
+				const auto infos = parse_package_sources_this(m, st, app);
 				optimize(st, 0);
+				verify_package_interfaces_this(st, infos);
 				t(*st);
 				delete m;
 				delete sm;